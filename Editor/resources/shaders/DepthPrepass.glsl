@@ -0,0 +1,43 @@
+#version 330 core
+
+layout(std140) uniform CameraData
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec3 viewPos;
+};
+
+// ----------------------------------------------------------------------------
+// VERTEX SHADER
+// ----------------------------------------------------------------------------
+#ifdef VERTEX_STAGE
+layout (location = 0) in vec3 aPos;
+
+#ifdef INSTANCED
+layout (location = 7) in mat4 aInstanceModel;
+#else
+uniform mat4 model;
+#endif
+
+// Must match IgnisPBR bit for bit, the shading pass tests depth with GL_EQUAL
+invariant gl_Position;
+
+void main()
+{
+#ifdef INSTANCED
+    mat4 model = aInstanceModel;
+#endif
+    vec3 worldPos = vec3(model * vec4(aPos, 1.0));
+    gl_Position = viewProjection * vec4(worldPos, 1.0);
+}
+#endif
+
+// ----------------------------------------------------------------------------
+// FRAGMENT SHADER
+// ----------------------------------------------------------------------------
+#ifdef FRAGMENT_STAGE
+void main()
+{
+}
+#endif
@@ -1,20 +1,44 @@
 #version 330 core
 
 #define MAX_DIR_LIGHTS   4
-#define MAX_POINT_LIGHTS 16
-#define MAX_SPOT_LIGHTS  16
+
+// ============================================================================
+// PER-FRAME UNIFORM BLOCKS (std140, must match UniformBuffer.h)
+// ============================================================================
+struct DirectionalLight { vec3 direction; vec3 radiance; };
+
+layout(std140) uniform CameraData
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec3 viewPos;
+};
+
+layout(std140) uniform LightData
+{
+    DirectionalLight directionalLights[MAX_DIR_LIGHTS];
+    int numDirectionalLights;
+};
+
+// Point and spot lights are binned into view-space clusters, see LightGrid.h
+layout(std140) uniform ClusterData
+{
+    ivec4 clusterGrid;        // tiles x, tiles y, depth slices, light count
+    vec4  clusterDepthParams; // near, far, slice scale, slice bias
+};
 
 // ============================================================================
 // VERTEX SHADER
 // ============================================================================
 #ifdef VERTEX_STAGE
+// Packed by Mesh::UploadGeometry, UV sets missing from the mesh read as zero
 layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
+layout (location = 1) in vec2 aNormal;      // octahedral
 layout (location = 2) in vec2 aTexCoords;   // UV0
 layout (location = 3) in vec2 aTexCoords1;  // UV1
 layout (location = 4) in vec2 aTexCoords2;  // UV2
-layout (location = 5) in vec3 aTangent;
-layout (location = 6) in vec3 aBitangent;
+layout (location = 5) in vec4 aTangent;     // octahedral xy, bitangent sign z
 
 out VS_OUT {
     vec3 FragPos;
@@ -24,12 +48,29 @@ out VS_OUT {
     mat3 TBN;
 } vs_out;
 
+#ifdef INSTANCED
+// Per-instance model matrix, occupies locations 7-10
+layout (location = 7) in mat4 aInstanceModel;
+#else
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+#endif
+
+// Shared with DepthPrepass.glsl so pre-pass depth matches exactly
+invariant gl_Position;
+
+vec3 OctDecode(vec2 e)
+{
+    vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (v.z < 0.0)
+        v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(v);
+}
 
 void main()
 {
+#ifdef INSTANCED
+    mat4 model = aInstanceModel;
+#endif
     vec3 worldPos = vec3(model * vec4(aPos, 1.0));
     vs_out.FragPos    = worldPos;
     vs_out.TexCoords  = aTexCoords;
@@ -37,18 +78,20 @@ void main()
     vs_out.TexCoords2 = aTexCoords2;
 
     mat3 M = mat3(model);
-    vec3 T = normalize(M * aTangent);
-    vec3 B = normalize(M * aBitangent);
-    vec3 N = normalize(mat3(transpose(inverse(model))) * aNormal);
+    vec3 T = normalize(M * OctDecode(aTangent.xy));
+    vec3 N = normalize(mat3(transpose(inverse(model))) * OctDecode(aNormal));
 
     // Gram-Schmidt  + 
     T = normalize(T - dot(T, N) * N);
-    float handedness = (dot(cross(N, T), B) < 0.0) ? -1.0 : 1.0;
-    B = cross(N, T) * handedness;
+    // Stored per vertex, flips again under a mirroring model matrix
+    float handedness = (aTangent.z < 0.0) ? -1.0 : 1.0;
+    if (determinant(M) < 0.0)
+        handedness = -handedness;
+    vec3 B = cross(N, T) * handedness;
 
     vs_out.TBN = mat3(T, B, N);
 
-    gl_Position = projection * view * vec4(worldPos, 1.0);
+    gl_Position = viewProjection * vec4(worldPos, 1.0);
 }
 #endif
 
@@ -87,12 +130,6 @@ struct Material {
     float clearcoatRoughnessFactor;
 };
 
-struct DirectionalLight { vec3 direction; vec3 radiance; };
-struct PointLight       { vec3 position;  vec3 radiance; float constant; float linear; float quadratic; };
-struct SpotLight        { vec3 position;  vec3 direction; vec3 radiance;
-                          float constant; float linear;   float quadratic;
-                          float cutOff;   float outerCutOff; };
-
 struct EnvironmentSettings {
     float intensity;
     float rotation;
@@ -100,14 +137,6 @@ struct EnvironmentSettings {
 };
 
 uniform Material material;
-uniform vec3     viewPos;
-
-uniform DirectionalLight directionalLights[MAX_DIR_LIGHTS];
-uniform PointLight       pointLights[MAX_POINT_LIGHTS];
-uniform SpotLight        spotLights[MAX_SPOT_LIGHTS];
-uniform int numDirectionalLights;
-uniform int numPointLights;
-uniform int numSpotLights;
 
 uniform samplerCube      irradianceMap;
 uniform samplerCube      prefilterMap;
@@ -115,6 +144,12 @@ uniform sampler2D        brdfLUT;
 uniform float            prefilterMaxLod;
 uniform EnvironmentSettings envSettings;
 
+// Clustered lights, 4 texels per light:
+// position, range | radiance, type | direction, cutOff | constant, linear, quadratic, outerCutOff
+uniform samplerBuffer  lightBuffer;
+uniform usamplerBuffer clusterBuffer;    // (offset, count) into lightIndexBuffer
+uniform usamplerBuffer lightIndexBuffer;
+
 // ---- ÿʹ UVĬ 0   FBX/OBJ----
 uniform int uv_albedoMap;
 uniform int uv_normalMap;
@@ -336,33 +371,50 @@ void main()
         Lo += baseLo * (1.0 - cc.y * clearcoat) + cc.x * clearcoat * radiance;
     }
 
-    for (int i = 0; i < numPointLights; i++)
-    {
-        vec3  L    = normalize(pointLights[i].position - fs_in.FragPos);
-        float dist = length(pointLights[i].position - fs_in.FragPos);
-        float att  = 1.0 / (pointLights[i].constant
-                          + pointLights[i].linear    * dist
-                          + pointLights[i].quadratic * dist * dist);
-        vec3 radiance = pointLights[i].radiance * att;
-        vec3 baseLo = CalcPBRContribution(L, V, N, F0, albedo, roughness, metallic, radiance);
-        vec2 cc     = CalcClearcoatDirect(L, V, Nc, clearcoatRoughness);
-        Lo += baseLo * (1.0 - cc.y * clearcoat) + cc.x * clearcoat * radiance;
-    }
-
-    for (int i = 0; i < numSpotLights; i++)
+    if (clusterGrid.w > 0)
     {
-        vec3  L         = normalize(spotLights[i].position - fs_in.FragPos);
-        float dist      = length(spotLights[i].position - fs_in.FragPos);
-        float att       = 1.0 / (spotLights[i].constant
-                                + spotLights[i].linear    * dist
-                                + spotLights[i].quadratic * dist * dist);
-        float theta     = dot(L, normalize(-spotLights[i].direction));
-        float epsilon   = max(spotLights[i].cutOff - spotLights[i].outerCutOff, 1e-4);
-        float intensity = clamp((theta - spotLights[i].outerCutOff) / epsilon, 0.0, 1.0);
-        vec3 radiance   = spotLights[i].radiance * att * intensity;
-        vec3 baseLo = CalcPBRContribution(L, V, N, F0, albedo, roughness, metallic, radiance);
-        vec2 cc     = CalcClearcoatDirect(L, V, Nc, clearcoatRoughness);
-        Lo += baseLo * (1.0 - cc.y * clearcoat) + cc.x * clearcoat * radiance;
+        vec4  clip      = viewProjection * vec4(fs_in.FragPos, 1.0);
+        vec2  tileUV    = clip.xy / clip.w * 0.5 + 0.5;
+        float viewDepth = -(view * vec4(fs_in.FragPos, 1.0)).z;
+
+        ivec2 tile  = clamp(ivec2(tileUV * vec2(clusterGrid.xy)), ivec2(0), clusterGrid.xy - 1);
+        int   slice = clamp(int(floor(log(max(viewDepth, 1e-4)) * clusterDepthParams.z + clusterDepthParams.w)),
+                            0, clusterGrid.z - 1);
+        uvec2 cluster = texelFetch(clusterBuffer, (slice * clusterGrid.y + tile.y) * clusterGrid.x + tile.x).xy;
+
+        for (uint i = 0u; i < cluster.y; i++)
+        {
+            int  base = int(texelFetch(lightIndexBuffer, int(cluster.x + i)).r) * 4;
+            vec4 positionRange = texelFetch(lightBuffer, base);
+            vec4 radianceType  = texelFetch(lightBuffer, base + 1);
+            vec4 directionCut  = texelFetch(lightBuffer, base + 2);
+            vec4 attenuation   = texelFetch(lightBuffer, base + 3);
+
+            vec3  toLight = positionRange.xyz - fs_in.FragPos;
+            float dist    = length(toLight);
+            vec3  L       = toLight / max(dist, 1e-4);
+            float att     = 1.0 / (attenuation.x + attenuation.y * dist + attenuation.z * dist * dist);
+
+            // Fade to zero at the range the light was binned with
+            if (positionRange.w > 0.0)
+            {
+                float x = dist / positionRange.w;
+                float window = clamp(1.0 - x * x * x * x, 0.0, 1.0);
+                att *= window * window;
+            }
+
+            if (radianceType.w > 0.5)
+            {
+                float theta     = dot(L, normalize(-directionCut.xyz));
+                float epsilon   = max(directionCut.w - attenuation.w, 1e-4);
+                att *= clamp((theta - attenuation.w) / epsilon, 0.0, 1.0);
+            }
+
+            vec3 radiance = radianceType.rgb * att;
+            vec3 baseLo = CalcPBRContribution(L, V, N, F0, albedo, roughness, metallic, radiance);
+            vec2 cc     = CalcClearcoatDirect(L, V, Nc, clearcoatRoughness);
+            Lo += baseLo * (1.0 - cc.y * clearcoat) + cc.x * clearcoat * radiance;
+        }
     }
 
     // ==== 5. IBL ====
@@ -1,5 +1,13 @@
 #version 330 core
 
+layout(std140) uniform CameraData
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec3 viewPos;
+};
+
 // ----------------------------------------------------------------------------
 // VERTEX SHADER
 // ----------------------------------------------------------------------------
@@ -8,8 +16,6 @@ layout (location = 0) in vec3 aPos;
 
 out vec3 TexCoords;
 
-uniform mat4 projection;
-uniform mat4 view;
 uniform float envRotation;
 
 mat3 RotationY(float angle)
@@ -3,6 +3,11 @@
 #ifdef VERTEX_STAGE
 layout(location = 0) in vec2 a_Position;  // êƫ
 layout(location = 1) in vec2 a_TexCoord;
+#ifdef BATCHED
+// Per string anchor and color, one draw holds every string using the atlas
+layout(location = 2) in vec3 a_Anchor;
+layout(location = 3) in vec4 a_Color;
+#endif
 
 uniform mat4 u_Model;       // ê
 uniform mat4 u_View;
@@ -10,13 +15,21 @@ uniform mat4 u_Projection;
 uniform vec2 u_ScreenSize;
 
 out vec2 v_TexCoord;
+#ifdef BATCHED
+out vec4 v_Color;
+#endif
 
 void main()
 {
     v_TexCoord = a_TexCoord;
 
     // 1. êͶӰüռ
+#ifdef BATCHED
+    v_Color = a_Color;
+    vec4 clip = u_Projection * u_View * vec4(a_Anchor, 1.0);
+#else
     vec4 clip = u_Projection * u_View * u_Model * vec4(0.0, 0.0, 0.0, 1.0);
+#endif
 
     // 2. ƫ  NDC ƫ
     //     clip.w Ϊ˵͸ӳ֤ĻС㶨
@@ -31,15 +44,29 @@ in  vec2 v_TexCoord;
 out vec4 FragColor;
 
 uniform sampler2D u_Atlas;
+uniform int       u_DistanceField; // 1 = atlas holds signed distances, edge at 0.5
+#ifdef BATCHED
+in  vec4 v_Color;
+#define TEXT_COLOR v_Color
+#else
 uniform vec4      u_Color;
+#define TEXT_COLOR u_Color
+#endif
 
 void main()
 {
     float alpha = texture(u_Atlas, v_TexCoord).r;
 
+    if (u_DistanceField != 0)
+    {
+        // Screen space derivative keeps the edge about a pixel wide at any text size
+        float width = max(fwidth(alpha) * 0.75, 1e-4);
+        alpha = smoothstep(0.5 - width, 0.5 + width, alpha);
+    }
+
     if (alpha < 0.01)
         discard;
 
-    FragColor = vec4(u_Color.rgb, u_Color.a * alpha);
+    FragColor = vec4(TEXT_COLOR.rgb, TEXT_COLOR.a * alpha);
 }
 #endif
\ No newline at end of file
@@ -1,8 +1,18 @@
 #version 330 core
 
+// BATCHED: color and texture slot come per vertex, so rects with different
+// colors and up to 8 textures share one draw
+
 #ifdef VERTEX_STAGE
 layout(location = 0) in vec2 a_Position;
 layout(location = 1) in vec2 a_TexCoord;
+#ifdef BATCHED
+layout(location = 2) in vec4  a_Color;
+layout(location = 3) in float a_TextureIndex;
+
+out vec4 v_Color;
+flat out int v_TextureIndex;
+#endif
 
 uniform mat4 u_Projection;
 
@@ -12,6 +22,10 @@ void main()
 {
     gl_Position = u_Projection * vec4(a_Position, 0.0, 1.0);
     v_TexCoord  = a_TexCoord;
+#ifdef BATCHED
+    v_Color        = a_Color;
+    v_TextureIndex = int(a_TextureIndex + 0.5);
+#endif
 }
 #endif
 
@@ -19,6 +33,38 @@ void main()
 in  vec2 v_TexCoord;
 out vec4 FragColor;
 
+#ifdef BATCHED
+in vec4 v_Color;
+flat in int v_TextureIndex;
+
+uniform sampler2D u_Texture0;
+uniform sampler2D u_Texture1;
+uniform sampler2D u_Texture2;
+uniform sampler2D u_Texture3;
+uniform sampler2D u_Texture4;
+uniform sampler2D u_Texture5;
+uniform sampler2D u_Texture6;
+uniform sampler2D u_Texture7;
+
+// GLSL 330 only allows constant indices into sampler arrays, so branch on the slot
+vec4 SampleSlot(int slot, vec2 uv)
+{
+    if (slot == 0) return texture(u_Texture0, uv);
+    if (slot == 1) return texture(u_Texture1, uv);
+    if (slot == 2) return texture(u_Texture2, uv);
+    if (slot == 3) return texture(u_Texture3, uv);
+    if (slot == 4) return texture(u_Texture4, uv);
+    if (slot == 5) return texture(u_Texture5, uv);
+    if (slot == 6) return texture(u_Texture6, uv);
+    return texture(u_Texture7, uv);
+}
+
+void main()
+{
+    FragColor = SampleSlot(v_TextureIndex, v_TexCoord) * v_Color;
+}
+#else
+
 uniform sampler2D u_Texture;
 uniform vec4      u_Color;
 uniform int       u_UseTexture; // 1 = sample texture, 0 = solid color
@@ -28,4 +74,5 @@ void main()
     vec4 tex  = (u_UseTexture != 0) ? texture(u_Texture, v_TexCoord) : vec4(1.0);
     FragColor = tex * u_Color;
 }
+#endif
 #endif
\ No newline at end of file
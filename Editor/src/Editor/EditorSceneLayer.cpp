@@ -242,7 +242,10 @@ void EditorSceneLayer::OnUpdate(float dt)
 
 	m_renderer.BeginFrame();
 
-	scene_renderer.BeginScene({ m_current_scene, render_camera, m_pipeline});
+	SceneRenderContext render_context{ m_current_scene, render_camera, m_pipeline };
+	render_context.DepthPrepass = m_depth_prepass;
+
+	scene_renderer.BeginScene(render_context);
 	m_current_scene->OnRender(scene_renderer);
 	scene_renderer.EndScene();
 
@@ -578,6 +581,7 @@ void EditorSceneLayer::RenderEditorOverlay()
 	void EditorSceneLayer::OnScenePlay()
 	{
 		Log::CoreInfo("OnScenePlay() - Transitioning to Play mode");
+		const auto play_start = std::chrono::steady_clock::now();
 	
 		// Store original editor scene path to restore on Stop
 		m_original_editor_scene_path = m_current_scene_path;
@@ -607,12 +611,14 @@ void EditorSceneLayer::RenderEditorOverlay()
 			hierarchy_panel->SetScene(m_runtime_scene);
 		}
 	
-		Log::CoreInfo("OnScenePlay() - Play mode started");
+		const double play_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - play_start).count();
+		Log::CoreInfo("OnScenePlay() - Play mode started in {:.2f} ms", play_ms);
 	}
 
 	void EditorSceneLayer::OnSceneStop()
 	{
 		Log::CoreInfo("OnSceneStop() - Transitioning to Edit mode");
+		const auto stop_start = std::chrono::steady_clock::now();
 	
 		// Clear selected entity in PropertiesPanel before destroying runtime scene
 		// This prevents accessing components on entities from destroyed registry
@@ -666,7 +672,8 @@ void EditorSceneLayer::RenderEditorOverlay()
 			hierarchy_panel->SetScene(m_editor_scene);
 		}
 	
-		Log::CoreInfo("OnSceneStop() - Edit mode restored");
+		const double stop_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stop_start).count();
+		Log::CoreInfo("OnSceneStop() - Edit mode restored in {:.2f} ms", stop_ms);
 	}
 
 	Entity EditorSceneLayer::GetSelectedEntity() const
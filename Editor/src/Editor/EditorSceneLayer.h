@@ -62,6 +62,9 @@ public:
 	void      SetGizmoMode(GizmoMode mode) { m_gizmo_mode = mode; }
 
 	std::shared_ptr<EditorCamera> GetEditorCamera() const { return m_editor_camera; }
+
+	bool IsDepthPrepassEnabled() const { return m_depth_prepass; }
+	void SetDepthPrepassEnabled(bool enabled) { m_depth_prepass = enabled; }
 	Entity GetSelectedEntity() const;
 
 	void OnScriptsReload();
@@ -95,6 +98,7 @@ private:
 	Entity m_light_entity;
 
 	std::shared_ptr<Pipeline> m_pipeline;
+	bool m_depth_prepass = false;
 
 	TransformComponent m_mesh_transform_component;
 
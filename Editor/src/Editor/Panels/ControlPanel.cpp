@@ -39,6 +39,8 @@ namespace ignis {
 			RenderPlayStopButtons();
 			ImGui::Spacing();
 			RenderCameraSpeedControls();
+			ImGui::Spacing();
+			RenderRenderingOptions();
 		}
 		ImGui::End();
 	}
@@ -128,6 +130,22 @@ namespace ignis {
 		}
 	}
 
+	void ControlPanel::RenderRenderingOptions()
+	{
+		if (!m_editor_scene_layer || !Project::GetActive())
+			return;
+
+		const float left_padding = 20.0f;
+
+		ImGui::SetCursorPosX(left_padding);
+		bool depth_prepass = m_editor_scene_layer->IsDepthPrepassEnabled();
+		if (ImGui::Checkbox("Depth Pre-pass", &depth_prepass))
+			m_editor_scene_layer->SetDepthPrepassEnabled(depth_prepass);
+
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Render opaque depth first so each pixel is shaded once");
+	}
+
 	void ControlPanel::OnEvent(EventBase& event)
 	{
 		// Future: Handle panel-specific events
@@ -21,6 +21,7 @@ namespace ignis {
 	private:
 		void RenderPlayStopButtons();
 		void RenderCameraSpeedControls();
+		void RenderRenderingOptions();
 
 		EditorSceneLayer* m_editor_scene_layer = nullptr;
 		float m_camera_speed = 5.0f;
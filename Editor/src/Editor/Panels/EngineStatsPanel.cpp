@@ -32,6 +32,53 @@ namespace ignis {
 				auto& app = Application::Get();
 				ImGui::Text("Window: %dx%d", app.GetWindow().GetWidth(), app.GetWindow().GetHeight());
 				ImGui::Text("VSync: %s", app.GetWindow().IsVSync() ? "Enabled" : "Disabled");
+				ImGui::Separator();
+
+				const auto& stats = Renderer::GetStats();
+				ImGui::Text("Uniforms Uploaded: %u", stats.UniformsUploaded);
+				ImGui::Text("Material Uploads Skipped: %u", stats.MaterialUploadsSkipped);
+				ImGui::Text("State Changes Issued: %u", stats.StateChangesIssued);
+				ImGui::Text("Redundant State Changes Avoided: %u", stats.StateChangesSkipped);
+				ImGui::Text("Redundant Binds Avoided: %u program, %u vertex array, %u texture",
+					stats.ProgramBindsSkipped, stats.VertexArrayBindsSkipped, stats.TextureBindsSkipped);
+				ImGui::Text("Draw Calls: %u (%u instanced, %u instances)",
+					stats.DrawCalls, stats.InstancedDrawCalls, stats.InstancesDrawn);
+				ImGui::Text("Multi-Draws: %u covering %u submeshes", stats.MultiDrawCalls, stats.MultiDrawSubmeshes);
+				ImGui::Text("Meshes Visible: %u, Culled: %u", stats.MeshesVisible, stats.MeshesCulled);
+				ImGui::Text("Submeshes Culled: %u", stats.SubmeshesCulled);
+				const float occluded_ratio = stats.OcclusionTests > 0
+					? 100.0f * static_cast<float>(stats.MeshesOccluded) / static_cast<float>(stats.OcclusionTests) : 0.0f;
+				ImGui::Text("Occlusion Culled: %u of %u tested (%.1f%%), %u occluder triangles",
+					stats.MeshesOccluded, stats.OcclusionTests, occluded_ratio, stats.OccluderTriangles);
+				ImGui::Text("Reduced LOD Meshes: %u of %u visible", stats.ReducedLODMeshes, stats.MeshesVisible);
+				ImGui::Text("Clustered Lights: %u, Light Indices: %u", stats.ClusteredLights, stats.LightIndices);
+				ImGui::Text("Text: %u draws, %u strings, %u glyphs", stats.TextDrawCalls, stats.TextStrings, stats.TextGlyphs);
+				ImGui::Text("UI: %u draws, %u rects", stats.UIDrawCalls, stats.UIRects);
+				ImGui::Text("Streamed Vertex Data: %.1f KB, %u ring stalls", stats.StreamedBytes / 1024.0f, stats.StreamStalls);
+				ImGui::Separator();
+
+				// Previous frame, busy time is summed over every thread that ran jobs
+				const auto& jobs = JobSystem::GetFrameStats();
+				double busy_ms = 0.0;
+				for (double thread_ms : jobs.ThreadBusyMilliseconds)
+					busy_ms += thread_ms;
+				ImGui::Text("Jobs: %u on %u threads, %.3f ms busy, %u stolen",
+					jobs.JobCount, JobSystem::GetThreadCount(), busy_ms, jobs.Steals);
+				for (const auto& job : jobs.Jobs)
+					ImGui::Text("  %s: %u, %.3f ms", job.Name, job.Count, job.Milliseconds);
+				ImGui::Separator();
+
+				// The arena creates its buffers on the first allocation, so Get() alone costs nothing
+				if (auto arena = GeometryArena::Get(); arena && arena->GetAllocationCount() > 0)
+				{
+					const auto& vertices = arena->GetVertexAllocator();
+					const auto& indices = arena->GetIndexAllocator();
+					ImGui::Text("Geometry Arena: %u meshes", arena->GetAllocationCount());
+					ImGui::Text("Vertices: %u / %u, %u free ranges", vertices.GetUsed(), vertices.GetCapacity(), vertices.GetFreeRangeCount());
+					ImGui::Text("Index Bytes: %u / %u, %u free ranges", indices.GetUsed(), indices.GetCapacity(), indices.GetFreeRangeCount());
+					if (ImGui::Button("Defragment"))
+						arena->Defragment();
+				}
 				
 				ImGui::EndTabItem();
 			}
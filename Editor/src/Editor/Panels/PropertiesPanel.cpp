@@ -844,7 +844,7 @@ namespace ignis {
 		}
 		
 		// Validate mesh has vertices
-		if (new_mesh->GetVertices().empty())
+		if (new_mesh->GetVertexCount() == 0)
 		{
 			Log::Error("Loaded mesh has no vertices: {}", filepath);
 			return;
@@ -859,20 +859,11 @@ namespace ignis {
 		// Auto-scale model to reasonable size based on bounding box
 		if (m_mesh_transform)
 		{
-			// Calculate bounding box from vertices
-			const auto& vertices = new_mesh->GetVertices();
-			if (!vertices.empty())
+			// Import-time bounds, the vertices may already be released
+			const AABB& bounds = new_mesh->GetBounds();
+			if (bounds.IsValid())
 			{
-				glm::vec3 min_bounds = vertices[0].Position;
-				glm::vec3 max_bounds = vertices[0].Position;
-				
-				for (const auto& vertex : vertices)
-				{
-					min_bounds = glm::min(min_bounds, vertex.Position);
-					max_bounds = glm::max(max_bounds, vertex.Position);
-				}
-				
-				glm::vec3 size = max_bounds - min_bounds;
+				glm::vec3 size = bounds.Max - bounds.Min;
 				float max_dimension = glm::max(glm::max(size.x, size.y), size.z);
 				
 				// Target size: models should fit within a 2-unit cube
@@ -994,6 +985,10 @@ namespace ignis {
 					LoadMeshFromFile(filepath, mesh_component);
 				}
 			}
+
+			ImGui::Checkbox("Occluder", &mesh_component.Occluder);
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("Hides meshes behind this one on the CPU before they are drawn");
 			
 			ImGui::Separator();
 			ImGui::Spacing();
@@ -1897,7 +1892,7 @@ namespace ignis {
 		AssetManager::SaveAssetRegistry(Project::GetActiveAssetRegistry());
 
 		auto new_mesh = AssetManager::GetAsset<Mesh>(mesh_handle);
-		if (!new_mesh || new_mesh->GetVertices().empty())
+		if (!new_mesh || new_mesh->GetVertexCount() == 0)
 		{
 			Log::Error("Mesh is empty or invalid: {}", filepath);
 			return;
@@ -2020,8 +2015,8 @@ namespace ignis {
 						meta->FilePath, opts.FlipVertical, opts.GenMipmaps, (int)opts.InternalFormat);
 				},
 				[&](FontImportOptions& opts) {
-					Log::CoreInfo("ReimportAsset: Font '{}' - Size={}, Atlas={}x{}", 
-						meta->FilePath, opts.FontSize, opts.AtlasWidth, opts.AtlasHeight);
+					Log::CoreInfo("ReimportAsset: Font '{}' - Size={}, Atlas={}x{}, DistanceField={}", 
+						meta->FilePath, opts.FontSize, opts.AtlasWidth, opts.AtlasHeight, opts.DistanceField);
 				},
 				[&](AudioImportOptions& opts) {
 					Log::CoreInfo("ReimportAsset: Audio '{}' - Stream={}", 
@@ -2032,6 +2027,10 @@ namespace ignis {
 						meta->FilePath, opts.BakeSettings.EnvironmentResolution, 
 						opts.BakeSettings.IrradianceResolution, opts.BakeSettings.PrefilterResolution);
 				},
+				[&](MeshImportOptions& opts) {
+					Log::CoreInfo("ReimportAsset: Mesh '{}' - GenerateLODs={}, LODCount={}, ReleaseCPUData={}, UseGeometryArena={}", 
+						meta->FilePath, opts.GenerateLODs, opts.LODCount, opts.ReleaseCPUData, opts.UseGeometryArena);
+				},
 				}, meta->ImportOptions);
 			
 			// Unload the asset to force reload with new settings
@@ -2122,6 +2121,10 @@ namespace ignis {
 			{
 				RenderEquirectImportSettings(opts, AssetHandle::Invalid);
 			},
+			[&](MeshImportOptions& opts)
+			{
+				RenderMeshImportSettings(opts, AssetHandle::Invalid);
+			},
 			}, m_pending_import_options);
 
 		ImGui::Spacing();
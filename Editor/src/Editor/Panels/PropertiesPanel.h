@@ -77,6 +77,7 @@ namespace ignis {
 		void RenderFontImportSettings(FontImportOptions& opts, AssetHandle handle);
 		void RenderAudioImportSettings(AudioImportOptions& opts, AssetHandle handle);
 		void RenderEquirectImportSettings(EquirectImportOptions& opts, AssetHandle handle);
+		void RenderMeshImportSettings(MeshImportOptions& opts, AssetHandle handle);
 		
 		// Call this for saving asset import setting
 		void ReimportAsset(AssetHandle handle);
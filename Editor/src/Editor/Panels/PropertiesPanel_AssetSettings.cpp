@@ -108,6 +108,9 @@ namespace ignis {
 		case AssetType::AudioClip:
 			m_pending_import_options = AudioImportOptions{};
 			break;
+		case AssetType::Mesh:
+			m_pending_import_options = MeshImportOptions{};
+			break;
 		default:
 			m_pending_import_options = std::monostate{};
 			break;
@@ -173,6 +176,9 @@ namespace ignis {
 			[this, handle](EquirectImportOptions& opts) {
 				RenderEquirectImportSettings(opts, handle);
 			},
+			[this, handle](MeshImportOptions& opts) {
+				RenderMeshImportSettings(opts, handle);
+			},
 		}, mutable_metadata->ImportOptions);
 
 		ImGui::Spacing();
@@ -361,6 +367,13 @@ namespace ignis {
 				ImGui::SetTooltip("Warning: Not a power of 2 (may reduce performance)");
 		}
 
+		ImGui::Spacing();
+
+		if (ImGui::Checkbox("Distance Field", &opts.DistanceField))
+			modified = true;
+
+		ImGui::TextDisabled("Stays sharp at any text size, Font Size sets the rasterization resolution");
+
 		if (modified)
 		{
 			// Check if current settings match original
@@ -369,7 +382,8 @@ namespace ignis {
 				auto& original = std::get<FontImportOptions>(m_original_import_options);
 				m_asset_settings_modified = !(opts.FontSize == original.FontSize &&
 					opts.AtlasWidth == original.AtlasWidth &&
-					opts.AtlasHeight == original.AtlasHeight);
+					opts.AtlasHeight == original.AtlasHeight &&
+					opts.DistanceField == original.DistanceField);
 			}
 			else
 			{
@@ -502,4 +516,102 @@ namespace ignis {
 		}
 	}
 
+	void PropertiesPanel::RenderMeshImportSettings(MeshImportOptions& opts, AssetHandle handle)
+	{
+		bool modified = false;
+
+		if (ImGui::Checkbox("Optimize Geometry", &opts.OptimizeGeometry))
+			modified = true;
+
+		ImGui::TextDisabled("Welds duplicate vertices and reorders triangles for the vertex cache");
+
+		ImGui::Spacing();
+
+		if (ImGui::Checkbox("Generate LODs", &opts.GenerateLODs))
+			modified = true;
+
+		ImGui::TextDisabled("Simplified index buffers used when the mesh is small on screen");
+
+		ImGui::BeginDisabled(!opts.GenerateLODs);
+
+		int lod_count = static_cast<int>(opts.LODCount);
+		if (ImGui::SliderInt("LOD Count", &lod_count, 1, static_cast<int>(MeshImportOptions::MaxLODs)))
+		{
+			opts.LODCount = static_cast<uint32_t>(std::clamp(lod_count, 1, static_cast<int>(MeshImportOptions::MaxLODs)));
+			modified = true;
+		}
+
+		ImGui::Spacing();
+
+		for (uint32_t i = 0; i < opts.LODCount; i++)
+		{
+			ImGui::PushID(static_cast<int>(i));
+			ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "LOD %u", i + 1);
+
+			// Each LOD keeps at most as many triangles as the one before it
+			const float max_ratio = i == 0 ? 1.0f : opts.LODRatios[i - 1];
+			if (ImGui::SliderFloat("Triangle Ratio", &opts.LODRatios[i], 0.01f, max_ratio, "%.3f"))
+			{
+				opts.LODRatios[i] = std::clamp(opts.LODRatios[i], 0.01f, max_ratio);
+				modified = true;
+			}
+
+			const float max_size = i == 0 ? 1.0f : opts.LODScreenSizes[i - 1];
+			if (ImGui::SliderFloat("Screen Size", &opts.LODScreenSizes[i], 0.0f, max_size, "%.3f"))
+			{
+				opts.LODScreenSizes[i] = std::clamp(opts.LODScreenSizes[i], 0.0f, max_size);
+				modified = true;
+			}
+			if (ImGui::IsItemHovered())
+				ImGui::SetTooltip("Switch to this LOD when the bounds cover less than this fraction of the viewport height");
+
+			ImGui::PopID();
+		}
+
+		ImGui::Spacing();
+
+		if (ImGui::SliderFloat("Hysteresis", &opts.LODHysteresis, 0.0f, 0.5f, "%.2f"))
+		{
+			opts.LODHysteresis = std::clamp(opts.LODHysteresis, 0.0f, 0.5f);
+			modified = true;
+		}
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Relative band around each threshold that prevents LODs from flickering");
+
+		ImGui::EndDisabled();
+
+		ImGui::Spacing();
+
+		if (ImGui::Checkbox("Release CPU Data", &opts.ReleaseCPUData))
+			modified = true;
+
+		ImGui::TextDisabled("Frees the vertex and index copies after upload, UVs can no longer be flipped");
+
+		if (ImGui::Checkbox("Use Geometry Arena", &opts.UseGeometryArena))
+			modified = true;
+
+		ImGui::TextDisabled("Shares one vertex and index buffer with other arena meshes");
+
+		if (modified)
+		{
+			// Check if current settings match original
+			if (std::holds_alternative<MeshImportOptions>(m_original_import_options))
+			{
+				auto& original = std::get<MeshImportOptions>(m_original_import_options);
+				m_asset_settings_modified = !(opts.OptimizeGeometry == original.OptimizeGeometry &&
+					opts.GenerateLODs == original.GenerateLODs &&
+					opts.LODCount == original.LODCount &&
+					opts.LODRatios == original.LODRatios &&
+					opts.LODScreenSizes == original.LODScreenSizes &&
+					opts.LODHysteresis == original.LODHysteresis &&
+					opts.ReleaseCPUData == original.ReleaseCPUData &&
+					opts.UseGeometryArena == original.UseGeometryArena);
+			}
+			else
+			{
+				m_asset_settings_modified = true;
+			}
+		}
+	}
+
 } // namespace ignis
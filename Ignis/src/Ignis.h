@@ -3,6 +3,7 @@
 #include "Ignis/Core/Log.h"
 #include "Ignis/Core/UUID.h"
 #include "Ignis/Core/Layer.h"
+#include "Ignis/Core/JobSystem.h"
 #include "Ignis/Core/File/FileSystem.h"
 #include "Ignis/Core/File/FileDialog.h"
 #include "Ignis/Core/File/File.h"
@@ -20,6 +21,7 @@
 #include "Ignis/Renderer/Camera.h"
 #include "Ignis/Renderer/Framebuffer.h"
 #include "Ignis/Renderer/Mesh.h"
+#include "Ignis/Renderer/GeometryArena.h"
 #include "Ignis/Renderer/SceneRenderer.h"
 
 #include "Ignis/Scene/Scene.h"
@@ -2,6 +2,7 @@
 #include "Ignis/Renderer/IBLBaker.h"
 #include "Ignis/Renderer/TextureTypes.h"
 #include "AssetType.h"
+#include <array>
 #include <variant>
 
 namespace ignis
@@ -22,6 +23,8 @@ namespace ignis
 		float    FontSize = 48.0f;
 		uint32_t AtlasWidth = 512;
 		uint32_t AtlasHeight = 512;
+		// Signed distance field glyphs rasterized at FontSize, one atlas then serves every text size
+		bool     DistanceField = false;
 	};
 
 	struct AudioImportOptions
@@ -29,6 +32,28 @@ namespace ignis
 		bool Stream = false;
 	};
 
+	struct MeshImportOptions
+	{
+		static constexpr uint32_t MaxLODs = 3;
+
+		// Weld duplicate vertices and reorder for vertex cache, overdraw and fetch locality
+		bool OptimizeGeometry = true;
+
+		bool GenerateLODs = false;
+		uint32_t LODCount = 3;
+		// Target index count of each LOD relative to LOD 0
+		std::array<float, MaxLODs> LODRatios{ 0.5f, 0.25f, 0.125f };
+		// Projected sphere height (fraction of the viewport) below which each LOD is used
+		std::array<float, MaxLODs> LODScreenSizes{ 0.5f, 0.25f, 0.1f };
+		float LODHysteresis = 0.1f;
+
+		// Drop the CPU vertex and index copies once the GPU buffers are built
+		bool ReleaseCPUData = false;
+
+		// Suballocate from the shared geometry arena instead of owning buffers, lets draws merge across meshes
+		bool UseGeometryArena = false;
+	};
+
 	struct EquirectImportOptions
 	{
 		TextureImportOptions TexOptions{};
@@ -40,7 +65,8 @@ namespace ignis
 		TextureImportOptions,
 		FontImportOptions,
 		AudioImportOptions,
-		EquirectImportOptions
+		EquirectImportOptions,
+		MeshImportOptions
 	>;
 
 	inline AssetImportOptions DefaultImportOptionsForType(AssetType type)
@@ -73,6 +99,9 @@ namespace ignis
 		case AssetType::AudioClip:
 			return AudioImportOptions{};
 
+		case AssetType::Mesh:
+			return MeshImportOptions{};
+
 		default:
 			return std::monostate{};
 		}
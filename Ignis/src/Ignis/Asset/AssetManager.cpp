@@ -64,11 +64,13 @@ namespace ignis
 	{
 		s_loaded_assets.erase(handle);
 		s_asset_registry.erase(handle);
+		s_generation++;
 	}
 
 	void AssetManager::UnloadAsset(AssetHandle handle)
 	{
 		s_loaded_assets.erase(handle);
+		s_generation++;
 	}
 
 	const AssetMetadata* AssetManager::GetMetadata(AssetHandle handle)
@@ -119,6 +121,7 @@ namespace ignis
 		if (auto registry = asset_serializer.Deserialize(path))
 		{
 			s_asset_registry = registry.value();
+			s_generation++;
 			return true;
 		}
 		return false;
@@ -203,6 +206,7 @@ namespace ignis
 		s_loaded_assets = {};
 		s_memory_assets = {};
 		s_asset_registry = {};
+		s_generation++;
 	}
 
 	std::shared_ptr<Asset> AssetManager::LoadAssetFromFile(const AssetMetadata& metadata)
@@ -76,6 +76,10 @@ namespace ignis
 
 		static void ClearAll();
 
+		// Bumped whenever an existing handle may resolve to a different asset (unload, remove,
+		// clear, registry reload). First loads and new handles leave cached resolutions valid.
+		static uint64_t GetGeneration() { return s_generation; }
+
 	private:
 		static std::shared_ptr<Asset> LoadAssetFromFile(const AssetMetadata& metadata);
 		static AssetImportOptions     DefaultImportOptions(AssetType type);
@@ -84,5 +88,6 @@ namespace ignis
 		inline static std::unordered_map<AssetHandle, std::shared_ptr<Asset>> s_memory_assets;
 		inline static std::unordered_map<AssetHandle, AssetMetadata> s_asset_registry;
 		inline static AssetLoadContext s_load_context;
+		inline static uint64_t s_generation = 0;
 	};
 }
\ No newline at end of file
@@ -39,6 +39,7 @@ namespace ignis
 		data["FontSize"] = opts.FontSize;
 		data["AtlasWidth"] = opts.AtlasWidth;
 		data["AtlasHeight"] = opts.AtlasHeight;
+		data["DistanceField"] = opts.DistanceField;
 		return data;
 	}
 
@@ -48,6 +49,7 @@ namespace ignis
 		opts.FontSize = data.value("FontSize", opts.FontSize);
 		opts.AtlasWidth = data.value("AtlasWidth", opts.AtlasWidth);
 		opts.AtlasHeight = data.value("AtlasHeight", opts.AtlasHeight);
+		opts.DistanceField = data.value("DistanceField", opts.DistanceField);
 		return opts;
 	}
 
@@ -65,6 +67,34 @@ namespace ignis
 		return opts;
 	}
 
+	static ordered_json SerializeMeshImportOptions(const MeshImportOptions& opts)
+	{
+		ordered_json data;
+		data["OptimizeGeometry"] = opts.OptimizeGeometry;
+		data["GenerateLODs"] = opts.GenerateLODs;
+		data["LODCount"] = opts.LODCount;
+		data["LODRatios"] = opts.LODRatios;
+		data["LODScreenSizes"] = opts.LODScreenSizes;
+		data["LODHysteresis"] = opts.LODHysteresis;
+		data["ReleaseCPUData"] = opts.ReleaseCPUData;
+		data["UseGeometryArena"] = opts.UseGeometryArena;
+		return data;
+	}
+
+	static MeshImportOptions DeserializeMeshImportOptions(const ordered_json& data)
+	{
+		MeshImportOptions opts{};
+		opts.OptimizeGeometry = data.value("OptimizeGeometry", opts.OptimizeGeometry);
+		opts.GenerateLODs = data.value("GenerateLODs", opts.GenerateLODs);
+		opts.LODCount = std::min(data.value("LODCount", opts.LODCount), MeshImportOptions::MaxLODs);
+		opts.LODRatios = data.value("LODRatios", opts.LODRatios);
+		opts.LODScreenSizes = data.value("LODScreenSizes", opts.LODScreenSizes);
+		opts.LODHysteresis = data.value("LODHysteresis", opts.LODHysteresis);
+		opts.ReleaseCPUData = data.value("ReleaseCPUData", opts.ReleaseCPUData);
+		opts.UseGeometryArena = data.value("UseGeometryArena", opts.UseGeometryArena);
+		return opts;
+	}
+
 	static ordered_json SerializeIBLBakeSettings(const IBLBakeSettings& settings)
 	{
 		ordered_json data;
@@ -127,6 +157,11 @@ namespace ignis
 			data["OptionsType"] = "Equirect";
 			data["Options"] = SerializeEquirectImportOptions(std::get<EquirectImportOptions>(options));
 		}
+		else if (std::holds_alternative<MeshImportOptions>(options))
+		{
+			data["OptionsType"] = "Mesh";
+			data["Options"] = SerializeMeshImportOptions(std::get<MeshImportOptions>(options));
+		}
 		else
 		{
 			data["OptionsType"] = "None";
@@ -150,6 +185,8 @@ namespace ignis
 			return DeserializeAudioImportOptions(data["Options"]);
 		if (type == "Equirect" && data.contains("Options"))
 			return DeserializeEquirectImportOptions(data["Options"]);
+		if (type == "Mesh" && data.contains("Options"))
+			return DeserializeMeshImportOptions(data["Options"]);
 
 		return std::monostate{};
 	}
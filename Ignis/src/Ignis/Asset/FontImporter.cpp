@@ -2,7 +2,6 @@
 #include "Ignis/Renderer/Font.h"
 #include "AssetLoadContext.h"
 
-#include <stb_truetype.h>
 #include <fstream>
 #include <filesystem>
 
@@ -26,48 +25,30 @@ namespace ignis
 		file.seekg(0);
 		file.read(reinterpret_cast<char*>(ttf.data()), (std::streamsize)ttf.size());
 
-		constexpr int kFirst = 32, kCount = 95;
-		std::vector<stbtt_packedchar> packed(kCount);
-		std::vector<uint8_t>          bitmap(options.AtlasWidth * options.AtlasHeight, 0);
-
-		stbtt_pack_context ctx;
-		if (!stbtt_PackBegin(&ctx, bitmap.data(), (int)options.AtlasWidth, (int)options.AtlasHeight, 0, 1, nullptr))
+		auto rasterizer = GlyphRasterizer::Create(std::move(ttf), options);
+		if (!rasterizer)
 		{
-			Log::CoreError("FontImporter: stbtt_PackBegin failed for '{}'", metadata.FilePath);
+			Log::CoreError("FontImporter: '{}' is not a valid TrueType font", metadata.FilePath);
 			return nullptr;
 		}
-		stbtt_PackSetOversampling(&ctx, 2, 2);
-		stbtt_PackFontRange(&ctx, ttf.data(), 0, options.FontSize, kFirst, kCount, packed.data());
-		stbtt_PackEnd(&ctx);
-
-		stbtt_fontinfo info;
-		stbtt_InitFont(&info, ttf.data(), 0);
-		float scale = stbtt_ScaleForPixelHeight(&info, options.FontSize);
-		int asc, desc, gap;
-		stbtt_GetFontVMetrics(&info, &asc, &desc, &gap);
-		float line_height = (asc - desc + gap) * scale;
 
-		float inv_w = 1.0f / (float)options.AtlasWidth;
-		float inv_h = 1.0f / (float)options.AtlasHeight;
+		// Printable ASCII is packed now, other pages are rasterized when text first uses them
+		constexpr uint32_t kFirst = 32, kCount = 95;
+		GlyphRangeBitmap ascii = rasterizer->Rasterize(kFirst, kCount);
 
 		auto font = std::make_shared<Font>();
-		font->m_line_height = line_height;
+		font->m_line_height = rasterizer->GetLineHeight();
+		font->m_distance_field = options.DistanceField;
 
-		for (int i = 0; i < kCount; ++i)
+		for (uint32_t i = 0; i < kCount; ++i)
 		{
-			const stbtt_packedchar& p = packed[i];
-			GlyphMetrics g;
-			g.AtlasMin = { p.x0 * inv_w, p.y0 * inv_h };
-			g.AtlasMax = { p.x1 * inv_w, p.y1 * inv_h };
-			g.QuadMin = { p.xoff,  p.yoff };
-			g.QuadMax = { p.xoff2, p.yoff2 };
-			g.Advance = p.xadvance;
-			font->m_glyphs[static_cast<uint32_t>(kFirst + i)] = g;
+			font->m_glyphs[kFirst + i] = ascii.Glyphs[i];
+			font->m_glyph_loaded[kFirst + i] = ascii.Loaded[i] != 0;
 		}
 
 		TextureSpecs specs;
-		specs.Width = options.AtlasWidth;
-		specs.Height = options.AtlasHeight;
+		specs.Width = ascii.Width;
+		specs.Height = ascii.Height;
 		specs.Format = TextureFormat::R8;
 		specs.WrapS = TextureWrap::ClampToEdge;
 		specs.WrapT = TextureWrap::ClampToEdge;
@@ -75,19 +56,27 @@ namespace ignis
 		specs.MagFilter = TextureFilter::Linear;
 		specs.GenMipmaps = false;
 
-		std::vector<std::byte> r8(bitmap.size());
-		for (size_t i = 0; i < bitmap.size(); ++i)
-			r8[i] = (std::byte)bitmap[i];
-
-		font->m_atlas = Texture2D::Create(specs, ImageFormat::R8, r8);
-		if (!font->m_atlas)
+		// Glyph pages index from 0, so the ASCII range's pages go in first, in order
+		for (const auto& pixels : ascii.Pages)
+		{
+			auto atlas = Texture2D::Create(specs, ImageFormat::R8, pixels);
+			if (!atlas)
+			{
+				Log::CoreError("FontImporter: GPU upload failed for '{}'", metadata.FilePath);
+				return nullptr;
+			}
+			font->m_atlas_pages.push_back(atlas);
+		}
+		if (font->m_atlas_pages.empty())
 		{
-			Log::CoreError("FontImporter: GPU upload failed for '{}'", metadata.FilePath);
+			Log::CoreError("FontImporter: '{}' has no printable ASCII glyphs", metadata.FilePath);
 			return nullptr;
 		}
+		font->SetRasterizer(std::move(rasterizer));
 
-		Log::CoreInfo("FontImporter: Loaded '{}' ({:.0f}px, {}x{} atlas)",
-			metadata.FilePath, options.FontSize, options.AtlasWidth, options.AtlasHeight);
+		Log::CoreInfo("FontImporter: Loaded '{}' ({:.0f}px, {}x{} {} atlas, {} ASCII pages)",
+			metadata.FilePath, options.FontSize, options.AtlasWidth, options.AtlasHeight,
+			options.DistanceField ? "distance field" : "bitmap", ascii.Pages.size());
 		return font;
 	}
 
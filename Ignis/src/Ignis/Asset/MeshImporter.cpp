@@ -1,6 +1,8 @@
 #include "MeshImporter.h"
 #include "Ignis/Renderer/VertexBuffer.h"
 #include "Ignis/Renderer/IndexBuffer.h"
+#include "Ignis/Renderer/MeshSimplifier.h"
+#include "Ignis/Renderer/MeshOptimizer.h"
 #include "TextureImporter.h"
 #include "AssetManager.h"
 
@@ -8,6 +10,9 @@
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 
+#include <algorithm>
+#include <unordered_map>
+
 namespace ignis
 {
 	static glm::mat4 AIToGLMMat4(const aiMatrix4x4& m)
@@ -42,6 +47,180 @@ namespace ignis
 		return this_index;
 	}
 
+	static BoundingSphere ComputeBoundingSphere(const AABB& bounds, const Vertex* vertices, size_t count)
+	{
+		BoundingSphere sphere;
+		sphere.Center = bounds.GetCenter();
+
+		float radius_sq = 0.0f;
+		for (size_t i = 0; i < count; ++i)
+		{
+			const glm::vec3 offset = vertices[i].Position - sphere.Center;
+			radius_sq = std::max(radius_sq, glm::dot(offset, offset));
+		}
+		sphere.Radius = std::sqrt(radius_sq);
+		return sphere;
+	}
+
+	// Keeps the largest triangles up to a budget. Dropping triangles only shrinks
+	// what the proxy covers, so occlusion stays conservative.
+	static OccluderMesh BuildOccluderProxy(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+	{
+		constexpr size_t k_max_occluder_triangles = 512;
+		constexpr float k_min_area_fraction = 1e-4f;
+
+		struct Triangle
+		{
+			uint32_t First;
+			float Area;
+		};
+
+		AABB bounds;
+		for (const auto& vertex : vertices)
+			bounds.Expand(vertex.Position);
+
+		OccluderMesh occluder;
+		if (!bounds.IsValid())
+			return occluder;
+
+		const glm::vec3 size = bounds.Max - bounds.Min;
+		const float min_area = k_min_area_fraction * std::max({ size.x * size.y, size.y * size.z, size.z * size.x });
+
+		std::vector<Triangle> triangles;
+		triangles.reserve(indices.size() / 3);
+		for (uint32_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			const glm::vec3& a = vertices[indices[i]].Position;
+			const glm::vec3& b = vertices[indices[i + 1]].Position;
+			const glm::vec3& c = vertices[indices[i + 2]].Position;
+			const float area = 0.5f * glm::length(glm::cross(b - a, c - a));
+			if (area > min_area)
+				triangles.push_back({ i, area });
+		}
+
+		if (triangles.size() > k_max_occluder_triangles)
+		{
+			std::nth_element(triangles.begin(), triangles.begin() + k_max_occluder_triangles, triangles.end(),
+				[](const Triangle& a, const Triangle& b) { return a.Area > b.Area; });
+			triangles.resize(k_max_occluder_triangles);
+		}
+
+		// Compact to the vertices the kept triangles reference
+		std::unordered_map<uint32_t, uint32_t> remap;
+		occluder.Indices.reserve(triangles.size() * 3);
+		for (const auto& triangle : triangles)
+		{
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				const uint32_t index = indices[triangle.First + k];
+				auto [it, inserted] = remap.try_emplace(index, static_cast<uint32_t>(occluder.Positions.size()));
+				if (inserted)
+					occluder.Positions.push_back(vertices[index].Position);
+				occluder.Indices.push_back(it->second);
+			}
+		}
+		return occluder;
+	}
+
+	// Runs each submesh through welding, vertex cache, overdraw and fetch ordering,
+	// then rebuilds the combined arrays since vertex counts change
+	static void OptimizeSubmeshGeometry(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices,
+		std::vector<Submesh>& submeshes, const std::string& name)
+	{
+		std::vector<Vertex> out_vertices;
+		std::vector<uint32_t> out_indices;
+		out_vertices.reserve(vertices.size());
+		out_indices.reserve(indices.size());
+
+		size_t misses_before = 0;
+		size_t misses_after = 0;
+
+		std::vector<Vertex> sub_vertices;
+		std::vector<uint32_t> sub_indices;
+		for (auto& sub : submeshes)
+		{
+			sub_vertices.assign(vertices.begin() + sub.BaseVertex, vertices.begin() + sub.BaseVertex + sub.VertexCount);
+			sub_indices.assign(indices.begin() + sub.BaseIndex, indices.begin() + sub.BaseIndex + sub.IndexCount);
+			for (uint32_t& index : sub_indices)
+				index -= sub.BaseVertex;
+
+			misses_before += MeshOptimizer::CountCacheMisses(sub_indices.data(), sub_indices.size(), sub_vertices.size());
+
+			MeshOptimizer::WeldVertices(sub_vertices, sub_indices);
+			MeshOptimizer::OptimizeVertexCache(sub_indices, sub_vertices.size());
+			MeshOptimizer::OptimizeOverdraw(sub_indices, sub_vertices);
+			MeshOptimizer::OptimizeVertexFetch(sub_vertices, sub_indices);
+
+			misses_after += MeshOptimizer::CountCacheMisses(sub_indices.data(), sub_indices.size(), sub_vertices.size());
+
+			sub.BaseVertex = static_cast<uint32_t>(out_vertices.size());
+			sub.BaseIndex = static_cast<uint32_t>(out_indices.size());
+			sub.VertexCount = static_cast<uint32_t>(sub_vertices.size());
+			sub.IndexCount = static_cast<uint32_t>(sub_indices.size());
+
+			out_vertices.insert(out_vertices.end(), sub_vertices.begin(), sub_vertices.end());
+			for (uint32_t index : sub_indices)
+				out_indices.push_back(sub.BaseVertex + index);
+		}
+
+		const float triangles = std::max(static_cast<float>(indices.size() / 3), 1.0f);
+		Log::Info("Optimized {}: {} -> {} vertices, ACMR {:.3f} -> {:.3f}", name,
+			vertices.size(), out_vertices.size(),
+			static_cast<float>(misses_before) / triangles, static_cast<float>(misses_after) / triangles);
+
+		vertices = std::move(out_vertices);
+		indices = std::move(out_indices);
+	}
+
+	// Appends simplified index ranges for every submesh. Each LOD is simplified
+	// from the previous one, and the chain stops once a step barely reduces.
+	static void BuildSubmeshLODs(const MeshImportOptions& options, const std::vector<Vertex>& vertices,
+		std::vector<uint32_t>& indices, std::vector<Submesh>& submeshes)
+	{
+		constexpr uint32_t k_min_lod_triangles = 16;
+		constexpr float k_min_reduction = 0.95f;
+
+		const uint32_t lod_count = std::min(options.LODCount, MeshImportOptions::MaxLODs);
+
+		std::vector<uint32_t> source;
+		for (auto& sub : submeshes)
+		{
+			sub.LODs.clear();
+			if (sub.IndexCount < k_min_lod_triangles * 3)
+				continue;
+
+			// Local indices so the simplifier only sees this submesh's vertices
+			source.assign(indices.begin() + sub.BaseIndex, indices.begin() + sub.BaseIndex + sub.IndexCount);
+			for (uint32_t& index : source)
+				index -= sub.BaseVertex;
+
+			for (uint32_t lod = 0; lod < lod_count; lod++)
+			{
+				const size_t target = std::max<size_t>(
+					static_cast<size_t>(sub.IndexCount * std::clamp(options.LODRatios[lod], 0.0f, 1.0f)) / 3 * 3,
+					k_min_lod_triangles * 3);
+				if (target >= source.size())
+					break;
+
+				std::vector<uint32_t> simplified = MeshSimplifier::Simplify(&vertices[sub.BaseVertex].Position,
+					sub.VertexCount, sizeof(Vertex), source.data(), source.size(), target);
+				if (simplified.empty() || simplified.size() > source.size() * k_min_reduction)
+					break;
+
+				MeshOptimizer::OptimizeVertexCache(simplified, sub.VertexCount);
+
+				SubmeshLOD sub_lod;
+				sub_lod.BaseIndex = static_cast<uint32_t>(indices.size());
+				sub_lod.IndexCount = static_cast<uint32_t>(simplified.size());
+				for (uint32_t index : simplified)
+					indices.push_back(sub.BaseVertex + index);
+				sub.LODs.push_back(sub_lod);
+
+				source = std::move(simplified);
+			}
+		}
+	}
+
 	static UVTransform ReadUVTransform(const aiMaterial* aimat, aiTextureType type, unsigned int index)
 	{
 		UVTransform result;
@@ -383,6 +562,7 @@ namespace ignis
 		mesh->m_vertices.clear();
 		mesh->m_indices.clear();
 		mesh->m_submeshes.clear();
+		mesh->m_uv_set_mask = 0;
 
 		uint32_t base_vertex = 0;
 		uint32_t base_index = 0;
@@ -391,6 +571,12 @@ namespace ignis
 		{
 			aiMesh* aimesh = scene->mMeshes[mesh_index];
 
+			for (uint32_t set = 0; set < 3; set++)
+			{
+				if (aimesh->HasTextureCoords(set))
+					mesh->m_uv_set_mask |= 1u << set;
+			}
+
 			Submesh sub;
 			sub.BaseVertex = base_vertex;
 			sub.BaseIndex = base_index;
@@ -465,6 +651,7 @@ namespace ignis
 					vertex.Bitangent = glm::vec3(0.0f, 1.0f, 0.0f);
 				}
 
+				sub.Bounds.Expand(vertex.Position);
 				mesh->m_vertices.push_back(vertex);
 			}			
 
@@ -479,32 +666,43 @@ namespace ignis
 
 			sub.VertexCount = static_cast<uint32_t>(mesh->m_vertices.size()) - sub.BaseVertex;
 			sub.IndexCount = static_cast<uint32_t>(mesh->m_indices.size()) - sub.BaseIndex;
+			sub.Sphere = ComputeBoundingSphere(sub.Bounds, mesh->m_vertices.data() + sub.BaseVertex, sub.VertexCount);
+			mesh->m_bounds.Expand(sub.Bounds);
 			mesh->m_submeshes.push_back(sub);
 
 			base_vertex = static_cast<uint32_t>(mesh->m_vertices.size());
 			base_index = static_cast<uint32_t>(mesh->m_indices.size());
 		}
 
-		mesh->m_vertex_array = VertexArray::Create();
+		const auto* mesh_opts = std::get_if<MeshImportOptions>(&metadata.ImportOptions);
+		if (!mesh_opts || mesh_opts->OptimizeGeometry)
+			OptimizeSubmeshGeometry(mesh->m_vertices, mesh->m_indices, mesh->m_submeshes, metadata.FilePath);
+
+		if (mesh->m_bounds.IsValid())
+			mesh->m_bounding_sphere = ComputeBoundingSphere(mesh->m_bounds, mesh->m_vertices.data(), mesh->m_vertices.size());
+
+		mesh->m_occluder = BuildOccluderProxy(mesh->m_vertices, mesh->m_indices);
 
-		mesh->m_vertex_buffer = VertexBuffer::Create(mesh->m_vertices.data(),
-			(uint32_t)(mesh->m_vertices.size() * sizeof(Vertex)));
+		if (mesh_opts && mesh_opts->GenerateLODs)
+		{
+			BuildSubmeshLODs(*mesh_opts, mesh->m_vertices, mesh->m_indices, mesh->m_submeshes);
+
+			for (const auto& sub : mesh->m_submeshes)
+				mesh->m_lod_count = std::max(mesh->m_lod_count, sub.GetLODCount());
+			mesh->m_lod_screen_sizes.assign(mesh_opts->LODScreenSizes.begin(), mesh_opts->LODScreenSizes.begin() + (mesh->m_lod_count - 1));
+			mesh->m_lod_hysteresis = mesh_opts->LODHysteresis;
+		}
 
-		mesh->m_vertex_buffer->SetLayout(VertexBuffer::Layout({
-			{0, Shader::DataType::Float3},  // Position
-			{1, Shader::DataType::Float3},  // Normal
-			{2, Shader::DataType::Float2},  // TexCoords  (UV0)
-			{3, Shader::DataType::Float2},  // TexCoords1 (UV1)
-			{4, Shader::DataType::Float2},  // TexCoords2 (UV2)
-			{5, Shader::DataType::Float3},  // Tangent
-			{6, Shader::DataType::Float3},  // Bitangent
-			}));
+		const bool use_arena = mesh_opts && mesh_opts->UseGeometryArena;
+		const size_t source_bytes = mesh->m_vertices.size() * sizeof(Vertex);
+		mesh->UploadGeometry(use_arena);
 
-		mesh->m_index_buffer = IndexBuffer::Create(mesh->m_indices.data(),
-			(uint32_t)(mesh->m_indices.size() * sizeof(uint32_t)));
+		const size_t packed_stride = use_arena ? GeometryArena::Get()->GetLayout().GetStride() : mesh->m_vertex_buffer->GetLayout().GetStride();
+		Log::Info("Packed {} vertices of {}: {} KB -> {} KB{}", mesh->m_vertex_count, metadata.FilePath,
+			source_bytes / 1024, mesh->m_vertex_count * packed_stride / 1024, use_arena ? " (geometry arena)" : "");
 
-		mesh->m_vertex_array->AddVertexBuffer(mesh->m_vertex_buffer);
-		mesh->m_vertex_array->SetIndexBuffer(mesh->m_index_buffer);
+		if (mesh_opts && mesh_opts->ReleaseCPUData)
+			mesh->ReleaseCPUData();
 
 		return mesh;
 	}
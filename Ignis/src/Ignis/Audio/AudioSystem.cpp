@@ -46,13 +46,12 @@ namespace ignis
 		ma_engine* engine = static_cast<ma_engine*>(AudioEngine::Get().GetNativeHandle());
 
 		{
-			auto view = m_scene->GetAllEntitiesWith<AudioListenerComponent, TransformComponent>();
-			view.each([&](auto entity_handle, AudioListenerComponent& listener, TransformComponent&)
+			auto view = m_scene->GetAllEntitiesWith<AudioListenerComponent, WorldTransformComponent>();
+			view.each([&](AudioListenerComponent& listener, WorldTransformComponent& world_transform)
 				{
 					if (!listener.Primary) return;
 
-					Entity entity(entity_handle, m_scene);
-					glm::mat4 world = entity.GetWorldTransform();
+					const glm::mat4& world = world_transform.World;
 
 					glm::vec3 pos = glm::vec3(world[3]);
 					glm::vec3 fwd = glm::normalize(-glm::vec3(world[2]));
@@ -65,10 +64,9 @@ namespace ignis
 		}
 
 		{
-			auto view = m_scene->GetAllEntitiesWith<AudioSourceComponent, TransformComponent, IDComponent>();
-			view.each([&](auto entity_handle,
-				AudioSourceComponent& src,
-				TransformComponent& /*tc*/,
+			auto view = m_scene->GetAllEntitiesWith<AudioSourceComponent, WorldTransformComponent, IDComponent>();
+			view.each([&](AudioSourceComponent& src,
+				WorldTransformComponent& world_transform,
 				IDComponent& id)
 				{
 					if (!src.Spatial) return;
@@ -76,8 +74,7 @@ namespace ignis
 					auto it = m_impl->Sounds.find(id.ID);
 					if (it == m_impl->Sounds.end()) return;
 
-					Entity entity(entity_handle, m_scene);
-					glm::vec3 pos = glm::vec3(entity.GetWorldTransform()[3]);
+					glm::vec3 pos = glm::vec3(world_transform.World[3]);
 					ma_sound_set_position(it->second.get(), pos.x, pos.y, pos.z);
 				});
 		}
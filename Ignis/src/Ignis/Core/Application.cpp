@@ -2,6 +2,7 @@
 #include "Ignis/ImGui/ImGuiLayer.h"
 #include "Ignis/Core/Events/KeyEvents.h"
 #include "Input.h"
+#include "JobSystem.h"
 #include "Ignis/Renderer/Camera.h"
 #include "Ignis/Renderer/RendererContext.h"
 
@@ -19,6 +20,8 @@ namespace ignis
 
 		ignis::Log::CoreInfo("VFS initialized");
 
+		JobSystem::Init();
+
 		m_window = Window::Create();
 		m_window->SetEventCallback([this](EventBase& e) { OnEvent(e); });
 
@@ -43,6 +46,7 @@ namespace ignis
 	Application::~Application()
 	{
 		Log::CoreInfo("Application shutting down...");
+		JobSystem::Shutdown();
 		VFS::Shutdown();
 	}
 
@@ -86,6 +90,7 @@ namespace ignis
 			}
 
 			m_window->OnUpdate();
+			JobSystem::EndFrame();
 		}
 		
 		Log::CoreInfoTag("Core", "Application main loop ended");
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <functional>
+
+namespace ignis
+{
+	template<typename T>
+	inline void HashCombine(std::size_t& seed, const T& value)
+	{
+		seed ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+	}
+}
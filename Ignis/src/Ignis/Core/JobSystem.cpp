@@ -0,0 +1,302 @@
+#include "JobSystem.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+namespace ignis
+{
+	namespace
+	{
+		constexpr uint32_t k_max_workers = 63;
+
+		struct Job
+		{
+			const char* Name = nullptr;
+			JobSystem::JobFunction Function;
+			JobCounter* Counter = nullptr;
+			const JobCounter* Dependency = nullptr;
+		};
+
+		// One per thread, the mutex covers both the deque and the stats
+		struct JobQueue
+		{
+			std::mutex Mutex;
+			std::deque<Job> Jobs;
+
+			std::vector<JobStats> Stats;
+			double BusyMilliseconds = 0.0;
+			uint32_t Steals = 0;
+		};
+
+		struct JobSystemData
+		{
+			// Queue 0 belongs to the thread that called Init, threads that are not workers share it
+			std::vector<std::unique_ptr<JobQueue>> Queues;
+			std::vector<std::thread> Workers;
+
+			// Jobs whose dependency had not finished when they were submitted. They stay out of the
+			// deques and Queued, so idle workers sleep instead of cycling them, until released.
+			std::mutex WaitingMutex;
+			std::vector<Job> Waiting;
+
+			std::mutex SleepMutex;
+			std::condition_variable WakeCondition;
+			std::atomic<uint32_t> Queued = 0;
+			std::atomic<bool> Running = false;
+
+			JobFrameStats FrameStats;
+		};
+
+		JobSystemData* s_data = nullptr;
+		JobFrameStats s_empty_stats;
+		thread_local uint32_t s_queue_index = 0;
+
+		void AddStats(std::vector<JobStats>& stats, const char* name, uint32_t count, double milliseconds)
+		{
+			// Few distinct names per frame, a linear search beats hashing here
+			for (auto& entry : stats)
+			{
+				if (entry.Name == name || std::string_view(entry.Name) == name)
+				{
+					entry.Count += count;
+					entry.Milliseconds += milliseconds;
+					return;
+				}
+			}
+			stats.push_back({ name, count, milliseconds });
+		}
+
+		void Push(uint32_t queue_index, Job&& job)
+		{
+			JobQueue& queue = *s_data->Queues[queue_index];
+			{
+				std::lock_guard lock(queue.Mutex);
+				queue.Jobs.push_back(std::move(job));
+			}
+			s_data->Queued.fetch_add(1, std::memory_order_release);
+
+			// Taking the sleep mutex orders this against a worker between its check and its wait
+			{
+				std::lock_guard lock(s_data->SleepMutex);
+			}
+			s_data->WakeCondition.notify_one();
+		}
+
+		bool Pop(uint32_t queue_index, Job& out_job)
+		{
+			JobQueue& queue = *s_data->Queues[queue_index];
+			std::lock_guard lock(queue.Mutex);
+			if (queue.Jobs.empty())
+				return false;
+
+			out_job = std::move(queue.Jobs.back());
+			queue.Jobs.pop_back();
+			return true;
+		}
+
+		bool Steal(uint32_t queue_index, Job& out_job)
+		{
+			const uint32_t queue_count = static_cast<uint32_t>(s_data->Queues.size());
+			for (uint32_t offset = 1; offset < queue_count; offset++)
+			{
+				JobQueue& victim = *s_data->Queues[(queue_index + offset) % queue_count];
+				std::unique_lock lock(victim.Mutex);
+				if (victim.Jobs.empty())
+					continue;
+
+				out_job = std::move(victim.Jobs.front());
+				victim.Jobs.pop_front();
+				lock.unlock();
+
+				JobQueue& own = *s_data->Queues[queue_index];
+				std::lock_guard own_lock(own.Mutex);
+				own.Steals++;
+				return true;
+			}
+			return false;
+		}
+
+		// Called after a counter reaches zero, moves the jobs it was holding back into the deques
+		void ReleaseWaiting(uint32_t queue_index)
+		{
+			std::vector<Job> ready;
+			{
+				std::lock_guard lock(s_data->WaitingMutex);
+				auto it = std::partition(s_data->Waiting.begin(), s_data->Waiting.end(),
+					[](const Job& job) { return !job.Dependency->IsDone(); });
+				std::move(it, s_data->Waiting.end(), std::back_inserter(ready));
+				s_data->Waiting.erase(it, s_data->Waiting.end());
+			}
+
+			for (Job& job : ready)
+				Push(queue_index, std::move(job));
+		}
+
+		bool TryExecute(uint32_t queue_index)
+		{
+			Job job;
+			if (!Pop(queue_index, job) && !Steal(queue_index, job))
+				return false;
+			s_data->Queued.fetch_sub(1, std::memory_order_acq_rel);
+
+			const auto start = std::chrono::steady_clock::now();
+			job.Function();
+			const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			{
+				JobQueue& queue = *s_data->Queues[queue_index];
+				std::lock_guard lock(queue.Mutex);
+				AddStats(queue.Stats, job.Name, 1, milliseconds);
+				queue.BusyMilliseconds += milliseconds;
+			}
+
+			if (job.Counter && job.Counter->Pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				ReleaseWaiting(queue_index);
+			return true;
+		}
+
+		void WorkerLoop(uint32_t queue_index)
+		{
+			s_queue_index = queue_index;
+
+			while (s_data->Running.load(std::memory_order_acquire))
+			{
+				if (TryExecute(queue_index))
+					continue;
+
+				std::unique_lock lock(s_data->SleepMutex);
+				s_data->WakeCondition.wait(lock, []()
+					{
+						return s_data->Queued.load(std::memory_order_acquire) > 0 || !s_data->Running.load(std::memory_order_acquire);
+					});
+			}
+		}
+	}
+
+	void JobSystem::Init(uint32_t worker_count)
+	{
+		if (s_data)
+			return;
+
+		if (worker_count == 0)
+			worker_count = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+		worker_count = std::min(worker_count, k_max_workers);
+
+		s_data = new JobSystemData();
+		s_data->Running = true;
+		s_queue_index = 0;
+
+		for (uint32_t i = 0; i <= worker_count; i++)
+			s_data->Queues.push_back(std::make_unique<JobQueue>());
+
+		s_data->Workers.reserve(worker_count);
+		for (uint32_t i = 1; i <= worker_count; i++)
+			s_data->Workers.emplace_back(WorkerLoop, i);
+
+		Log::CoreInfo("JobSystem: {} workers", worker_count);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		if (!s_data)
+			return;
+
+		{
+			std::lock_guard lock(s_data->SleepMutex);
+			s_data->Running = false;
+		}
+		s_data->WakeCondition.notify_all();
+
+		for (auto& worker : s_data->Workers)
+			worker.join();
+
+		delete s_data;
+		s_data = nullptr;
+	}
+
+	void JobSystem::Run(const char* name, JobFunction job, JobCounter* counter, const JobCounter* dependency)
+	{
+		if (counter)
+			counter->Pending.fetch_add(1, std::memory_order_acq_rel);
+
+		if (!s_data)
+		{
+			// Nothing to defer to, dependencies have already run inline as well
+			job();
+			if (counter)
+				counter->Pending.fetch_sub(1, std::memory_order_acq_rel);
+			return;
+		}
+
+		if (dependency && !dependency->IsDone())
+		{
+			// Rechecked under the lock, a counter finishing meanwhile releases only after taking it
+			std::lock_guard lock(s_data->WaitingMutex);
+			if (!dependency->IsDone())
+			{
+				s_data->Waiting.push_back({ name, std::move(job), counter, dependency });
+				return;
+			}
+		}
+
+		Push(s_queue_index, { name, std::move(job), counter, dependency });
+	}
+
+	void JobSystem::Wait(const JobCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			if (!s_data || !TryExecute(s_queue_index))
+				std::this_thread::yield();
+		}
+	}
+
+	uint32_t JobSystem::GetThreadCount()
+	{
+		return s_data ? static_cast<uint32_t>(s_data->Queues.size()) : 1u;
+	}
+
+	void JobSystem::EndFrame()
+	{
+		if (!s_data)
+			return;
+
+		JobFrameStats& frame = s_data->FrameStats;
+		frame.Jobs.clear();
+		frame.ThreadBusyMilliseconds.assign(s_data->Queues.size(), 0.0);
+		frame.JobCount = 0;
+		frame.Steals = 0;
+
+		for (size_t i = 0; i < s_data->Queues.size(); i++)
+		{
+			JobQueue& queue = *s_data->Queues[i];
+			std::lock_guard lock(queue.Mutex);
+
+			for (const auto& stats : queue.Stats)
+			{
+				AddStats(frame.Jobs, stats.Name, stats.Count, stats.Milliseconds);
+				frame.JobCount += stats.Count;
+			}
+			frame.ThreadBusyMilliseconds[i] = queue.BusyMilliseconds;
+			frame.Steals += queue.Steals;
+
+			queue.Stats.clear();
+			queue.BusyMilliseconds = 0.0;
+			queue.Steals = 0;
+		}
+
+		std::sort(frame.Jobs.begin(), frame.Jobs.end(),
+			[](const JobStats& a, const JobStats& b) { return a.Milliseconds > b.Milliseconds; });
+	}
+
+	const JobFrameStats& JobSystem::GetFrameStats()
+	{
+		return s_data ? s_data->FrameStats : s_empty_stats;
+	}
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "API.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace ignis
+{
+	// Jobs submitted with a counter increment it and decrement it when they finish
+	struct JobCounter
+	{
+		std::atomic<uint32_t> Pending = 0;
+
+		bool IsDone() const { return Pending.load(std::memory_order_acquire) == 0; }
+	};
+
+	struct JobStats
+	{
+		const char* Name = nullptr;
+		uint32_t Count = 0;
+		double Milliseconds = 0.0;
+	};
+
+	// Closed by JobSystem::EndFrame, jobs still running at the boundary count towards the next frame
+	struct JobFrameStats
+	{
+		std::vector<JobStats> Jobs;
+		// Time spent inside jobs per thread, index 0 is the thread that called Init
+		std::vector<double> ThreadBusyMilliseconds;
+		uint32_t JobCount = 0;
+		uint32_t Steals = 0;
+	};
+
+	// Engine-wide worker pool. Every thread owns a deque, pops its newest job and steals the
+	// oldest from the others when it runs dry. Threads waiting on a counter run jobs meanwhile,
+	// so jobs may submit and wait on further jobs.
+	class IGNIS_API JobSystem
+	{
+	public:
+		using JobFunction = std::function<void()>;
+
+		// worker_count 0 uses one worker per hardware thread besides the caller
+		static void Init(uint32_t worker_count = 0);
+		static void Shutdown();
+
+		// Names key the per-frame stats and must outlive them, string literals are expected.
+		// A job with a dependency does not start until that counter reaches zero.
+		static void Run(const char* name, JobFunction job, JobCounter* counter = nullptr, const JobCounter* dependency = nullptr);
+		static void Wait(const JobCounter& counter);
+
+		// Calls func(begin, end) over [0, count) in batches of at least min_batch and returns once
+		// all have run. Work that fits in one batch, or a system without workers, runs inline.
+		template<typename Func>
+		static void ParallelFor(const char* name, uint32_t count, uint32_t min_batch, Func&& func);
+
+		// Calls func(entity) for every entity of an entt view or group
+		template<typename View, typename Func>
+		static void ParallelForEach(const char* name, const View& view, uint32_t min_batch, Func&& func);
+
+		// Workers plus the thread that called Init, 1 before Init
+		static uint32_t GetThreadCount();
+
+		static void EndFrame();
+		static const JobFrameStats& GetFrameStats();
+	};
+
+	template<typename Func>
+	void JobSystem::ParallelFor(const char* name, uint32_t count, uint32_t min_batch, Func&& func)
+	{
+		if (count == 0)
+			return;
+
+		// A few batches per thread so stealing can even out uneven work
+		const uint32_t thread_count = GetThreadCount();
+		const uint32_t batch = std::max({ min_batch, 1u, (count + thread_count * 4 - 1) / (thread_count * 4) });
+		if (thread_count == 1 || batch >= count)
+		{
+			func(0u, count);
+			return;
+		}
+
+		JobCounter counter;
+		for (uint32_t begin = 0; begin < count; begin += batch)
+		{
+			const uint32_t end = std::min(begin + batch, count);
+			Run(name, [&func, begin, end]() { func(begin, end); }, &counter);
+		}
+		Wait(counter);
+	}
+
+	template<typename View, typename Func>
+	void JobSystem::ParallelForEach(const char* name, const View& view, uint32_t min_batch, Func&& func)
+	{
+		// Multi-component views only iterate forwards, so the handles are gathered first
+		std::vector<std::decay_t<decltype(*view.begin())>> entities(view.begin(), view.end());
+		ParallelFor(name, static_cast<uint32_t>(entities.size()), min_batch, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; i++)
+					func(entities[i]);
+			});
+	}
+}
@@ -0,0 +1,150 @@
+#include "GLDynamicRingBuffer.h"
+#include "Ignis/Renderer/Renderer.h"
+
+#include <glad/glad.h>
+#include <cstring>
+
+namespace ignis
+{
+	namespace
+	{
+		// Unfenced data is fenced once it spans this fraction of the ring, so small appends share a fence
+		constexpr size_t k_fence_granularity = 4;
+
+		constexpr GLuint64 k_wait_timeout_ns = 1000000;
+	}
+
+	GLDynamicRingBuffer::GLDynamicRingBuffer(size_t size)
+	{
+		glGenBuffers(1, &m_id);
+		Reallocate(size);
+	}
+
+	GLDynamicRingBuffer::~GLDynamicRingBuffer()
+	{
+		for (const auto& range : m_fenced_ranges)
+			glDeleteSync(static_cast<GLsync>(range.Fence));
+		glDeleteBuffers(1, &m_id);
+	}
+
+	void GLDynamicRingBuffer::Bind()
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_id);
+	}
+
+	void GLDynamicRingBuffer::UnBind()
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	void GLDynamicRingBuffer::SetData(const void* data, size_t size)
+	{
+		FencePending();
+		if (size > m_capacity)
+			Reallocate(size);
+		else
+			WaitForRange(0, m_capacity);
+
+		Write(0, data, size);
+		m_cursor = size;
+		m_pending_begin = 0;
+	}
+
+	uint32_t GLDynamicRingBuffer::Append(const void* data, size_t size)
+	{
+		// Offsets stay whole vertices so the draw can start from a base vertex
+		const size_t stride = std::max<size_t>(m_layout.GetStride(), 1);
+
+		if (size > m_capacity / 2)
+			Reallocate(std::max(size * 2, m_capacity * 2));
+
+		size_t offset = (m_cursor + stride - 1) / stride * stride;
+		if (offset + size > m_capacity)
+		{
+			// Wrapping, the tail is left unused
+			FencePending();
+			offset = 0;
+			m_pending_begin = 0;
+		}
+		else if (offset - m_pending_begin >= m_capacity / k_fence_granularity)
+		{
+			FencePending();
+			m_pending_begin = offset;
+		}
+
+		WaitForRange(offset, offset + size);
+		Write(offset, data, size);
+		m_cursor = offset + size;
+
+		Renderer::GetStats().StreamedBytes += static_cast<uint32_t>(size);
+		return static_cast<uint32_t>(offset / stride);
+	}
+
+	void GLDynamicRingBuffer::FencePending()
+	{
+		if (m_cursor == m_pending_begin)
+			return;
+
+		GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		m_fenced_ranges.push_back({ m_pending_begin, m_cursor, fence });
+		m_pending_begin = m_cursor;
+	}
+
+	void GLDynamicRingBuffer::WaitForRange(size_t begin, size_t end)
+	{
+		// Ranges ahead of the cursor are the oldest, stop at the first one the write misses
+		while (!m_fenced_ranges.empty())
+		{
+			const FencedRange& range = m_fenced_ranges.front();
+			if (range.End <= begin || range.Begin >= end)
+				break;
+
+			GLsync fence = static_cast<GLsync>(range.Fence);
+			GLenum result = glClientWaitSync(fence, 0, 0);
+			if (result == GL_TIMEOUT_EXPIRED)
+			{
+				Renderer::GetStats().StreamStalls++;
+				do
+				{
+					result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, k_wait_timeout_ns);
+				} while (result == GL_TIMEOUT_EXPIRED);
+			}
+
+			glDeleteSync(fence);
+			m_fenced_ranges.pop_front();
+		}
+	}
+
+	void GLDynamicRingBuffer::Reallocate(size_t capacity)
+	{
+		// New storage, the driver keeps the old one alive for draws still reading it
+		for (const auto& range : m_fenced_ranges)
+			glDeleteSync(static_cast<GLsync>(range.Fence));
+		m_fenced_ranges.clear();
+
+		m_capacity = capacity;
+		m_cursor = 0;
+		m_pending_begin = 0;
+
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+		glBufferData(GL_COPY_WRITE_BUFFER, m_capacity, nullptr, GL_STREAM_DRAW);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+
+	void GLDynamicRingBuffer::Write(size_t offset, const void* data, size_t size)
+	{
+		if (size == 0)
+			return;
+
+		// The range was checked against the fences, so the driver need not synchronize
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+		void* mapped = glMapBufferRange(GL_COPY_WRITE_BUFFER, offset, size,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		if (mapped)
+		{
+			std::memcpy(mapped, data, size);
+			glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+		}
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Ignis/Renderer/VertexBuffer.h"
+
+#include <deque>
+
+namespace ignis
+{
+	// Streaming vertex buffer written as a ring. Each Append lands after the data of
+	// earlier ones, so draws still reading those are never waited on; fences are only
+	// waited for once the ring wraps around onto data the GPU may not have read yet.
+	class GLDynamicRingBuffer : public VertexBuffer
+	{
+	public:
+		explicit GLDynamicRingBuffer(size_t size);
+		~GLDynamicRingBuffer() override;
+
+		void Bind() override;
+		void UnBind() override;
+
+		// Restarts the ring at offset 0, waiting for every draw that may still read the buffer
+		void SetData(const void* data, size_t size) override;
+		uint32_t Append(const void* data, size_t size) override;
+
+	private:
+		struct FencedRange
+		{
+			size_t Begin;
+			size_t End;
+			void* Fence;
+		};
+
+		// Covers everything appended since the last fence, whose draws have all been issued
+		void FencePending();
+		void WaitForRange(size_t begin, size_t end);
+		void Reallocate(size_t capacity);
+		void Write(size_t offset, const void* data, size_t size);
+
+	private:
+		uint32_t m_id = 0;
+		size_t m_capacity = 0;
+		size_t m_cursor = 0;
+		size_t m_pending_begin = 0;
+		// Oldest first, in ring order from the cursor
+		std::deque<FencedRange> m_fenced_ranges;
+	};
+}
@@ -0,0 +1,61 @@
+#include "GLGeometryArena.h"
+#include "GLVertexArray.h"
+
+#include <glad/glad.h>
+
+namespace ignis
+{
+	namespace
+	{
+		void CopyRanges(uint32_t source, uint32_t destination, const std::vector<GeometryArena::Move>& moves)
+		{
+			glBindBuffer(GL_COPY_READ_BUFFER, source);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, destination);
+			for (const auto& move : moves)
+			{
+				if (move.Size > 0)
+					glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, move.Source, move.Destination, move.Size);
+			}
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+			glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+		}
+	}
+
+	GLGeometryArena::GLGeometryArena(const VertexBuffer::Layout& layout)
+		: GeometryArena(layout)
+	{
+	}
+
+	void GLGeometryArena::Rebuild(uint32_t vertex_capacity, uint32_t index_capacity,
+		const std::vector<Move>& vertex_moves, const std::vector<Move>& index_moves)
+	{
+		auto vertex_buffer = std::make_shared<GLVertexBuffer>(static_cast<size_t>(vertex_capacity) * GetLayout().GetStride(), VertexBuffer::Usage::Static);
+		vertex_buffer->SetLayout(GetLayout());
+		auto index_buffer = std::make_shared<GLIndexBuffer>(nullptr, index_capacity);
+
+		// Copied on the GPU, the CPU copies of arena meshes may already be released
+		if (m_vertex_buffer)
+			CopyRanges(m_vertex_buffer->GetID(), vertex_buffer->GetID(), vertex_moves);
+		if (m_index_buffer)
+			CopyRanges(m_index_buffer->GetID(), index_buffer->GetID(), index_moves);
+
+		m_vertex_buffer = vertex_buffer;
+		m_index_buffer = index_buffer;
+
+		// A new vertex array rather than rebinding the old one, attachments made by the renderer are redone lazily
+		m_vertex_array = std::make_shared<GLVertexArray>();
+		m_vertex_array->AddVertexBuffer(m_vertex_buffer);
+		m_vertex_array->SetIndexBuffer(m_index_buffer);
+	}
+
+	void GLGeometryArena::Upload(uint32_t vertex_offset, const void* vertices, uint32_t vertex_size,
+		uint32_t index_offset, const void* indices, uint32_t index_size)
+	{
+		// The copy target keeps the array and element bindings of whatever is bound untouched
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_vertex_buffer->GetID());
+		glBufferSubData(GL_COPY_WRITE_BUFFER, vertex_offset, vertex_size, vertices);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_index_buffer->GetID());
+		glBufferSubData(GL_COPY_WRITE_BUFFER, index_offset, index_size, indices);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+	}
+}
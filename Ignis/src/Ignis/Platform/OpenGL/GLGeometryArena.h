@@ -0,0 +1,28 @@
+#pragma once
+
+#include "Ignis/Renderer/GeometryArena.h"
+#include "GLVertexBuffer.h"
+#include "GLIndexBuffer.h"
+
+namespace ignis
+{
+	class GLGeometryArena : public GeometryArena
+	{
+	public:
+		explicit GLGeometryArena(const VertexBuffer::Layout& layout);
+		~GLGeometryArena() override = default;
+
+		std::shared_ptr<VertexArray> GetVertexArray() const override { return m_vertex_array; }
+
+	protected:
+		void Rebuild(uint32_t vertex_capacity, uint32_t index_capacity,
+			const std::vector<Move>& vertex_moves, const std::vector<Move>& index_moves) override;
+		void Upload(uint32_t vertex_offset, const void* vertices, uint32_t vertex_size,
+			uint32_t index_offset, const void* indices, uint32_t index_size) override;
+
+	private:
+		std::shared_ptr<VertexArray> m_vertex_array;
+		std::shared_ptr<GLVertexBuffer> m_vertex_buffer;
+		std::shared_ptr<GLIndexBuffer> m_index_buffer;
+	};
+}
@@ -1,5 +1,6 @@
 #include "GLIBLBaker.h"
 #include "GLTexture.h"
+#include "GLStateCache.h"
 #include "Ignis/Renderer/Shader.h"
 #include "Ignis/Renderer/VertexArray.h"
 #include "Ignis/Renderer/Renderer.h"
@@ -49,7 +50,7 @@ namespace ignis
 		glGetIntegerv(GL_VIEWPORT, prev_viewport);
 		const GLboolean cull_was_enabled = glIsEnabled(GL_CULL_FACE);
 
-		glDisable(GL_CULL_FACE);
+		GLStateCache::Disable(GL_CULL_FACE);
 
 		// 1) Upload equirect HDR to 2D texture
 		TextureSpecs hdr_specs{};
@@ -65,7 +66,7 @@ namespace ignis
 		auto hdr_tex = Texture2D::Create(hdr_specs, hdr_image.GetFormat(), hdr_image.GetPixels());
 		if (!hdr_tex)
 		{
-			if (cull_was_enabled) glEnable(GL_CULL_FACE);
+			if (cull_was_enabled) GLStateCache::Enable(GL_CULL_FACE);
 			glViewport(prev_viewport[0], prev_viewport[1], prev_viewport[2], prev_viewport[3]);
 			return out;
 		}
@@ -84,7 +85,7 @@ namespace ignis
 
 		if (!out.EnvironmentCube)
 		{
-			if (cull_was_enabled) glEnable(GL_CULL_FACE);
+			if (cull_was_enabled) GLStateCache::Enable(GL_CULL_FACE);
 			glViewport(prev_viewport[0], prev_viewport[1], prev_viewport[2], prev_viewport[3]);
 			return out;
 		}
@@ -125,7 +126,7 @@ namespace ignis
 				glBindFramebuffer(GL_FRAMEBUFFER, 0);
 				glDeleteFramebuffers(1, &capture_fbo);
 				glDeleteRenderbuffers(1, &capture_rbo);
-				if (cull_was_enabled) glEnable(GL_CULL_FACE);
+				if (cull_was_enabled) GLStateCache::Enable(GL_CULL_FACE);
 				glViewport(prev_viewport[0], prev_viewport[1], prev_viewport[2], prev_viewport[3]);
 				return out;
 			}
@@ -136,7 +137,7 @@ namespace ignis
 		}
 
 		// Create environment mip, for prefilter to sample
-		glBindTexture(GL_TEXTURE_CUBE_MAP, env_cube_id);
+		GLStateCache::BindTexture(GL_TEXTURE_CUBE_MAP, env_cube_id);
 		glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
 		// 4) Create Irradiance Cube
@@ -154,7 +155,7 @@ namespace ignis
 			glBindFramebuffer(GL_FRAMEBUFFER, 0);
 			glDeleteFramebuffers(1, &capture_fbo);
 			glDeleteRenderbuffers(1, &capture_rbo);
-			if (cull_was_enabled) glEnable(GL_CULL_FACE);
+			if (cull_was_enabled) GLStateCache::Enable(GL_CULL_FACE);
 			glViewport(prev_viewport[0], prev_viewport[1], prev_viewport[2], prev_viewport[3]);
 			return out;
 		}
@@ -183,7 +184,7 @@ namespace ignis
 				glBindFramebuffer(GL_FRAMEBUFFER, 0);
 				glDeleteFramebuffers(1, &capture_fbo);
 				glDeleteRenderbuffers(1, &capture_rbo);
-				if (cull_was_enabled) glEnable(GL_CULL_FACE);
+				if (cull_was_enabled) GLStateCache::Enable(GL_CULL_FACE);
 				glViewport(prev_viewport[0], prev_viewport[1], prev_viewport[2], prev_viewport[3]);
 				return out;
 			}
@@ -209,7 +210,7 @@ namespace ignis
 			glBindFramebuffer(GL_FRAMEBUFFER, 0);
 			glDeleteFramebuffers(1, &capture_fbo);
 			glDeleteRenderbuffers(1, &capture_rbo);
-			if (cull_was_enabled) glEnable(GL_CULL_FACE);
+			if (cull_was_enabled) GLStateCache::Enable(GL_CULL_FACE);
 			glViewport(prev_viewport[0], prev_viewport[1], prev_viewport[2], prev_viewport[3]);
 			return out;
 		}
@@ -217,7 +218,7 @@ namespace ignis
 		const GLuint prefilter_cube_id = static_cast<GLTextureCube*>(out.PrefilterCube.get())->m_id;
 
 		// Ensure mip chain has been allocated
-		glBindTexture(GL_TEXTURE_CUBE_MAP, prefilter_cube_id);
+		GLStateCache::BindTexture(GL_TEXTURE_CUBE_MAP, prefilter_cube_id);
 		glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
 
 		auto prefilter_mat = Material::Create(m_renderer.GetShaderLibrary().Get("PrefilterGGX"));
@@ -252,7 +253,7 @@ namespace ignis
 					glBindFramebuffer(GL_FRAMEBUFFER, 0);
 					glDeleteFramebuffers(1, &capture_fbo);
 					glDeleteRenderbuffers(1, &capture_rbo);
-					if (cull_was_enabled) glEnable(GL_CULL_FACE);
+					if (cull_was_enabled) GLStateCache::Enable(GL_CULL_FACE);
 					glViewport(prev_viewport[0], prev_viewport[1], prev_viewport[2], prev_viewport[3]);
 					return out;
 				}
@@ -280,7 +281,7 @@ namespace ignis
 			glBindFramebuffer(GL_FRAMEBUFFER, 0);
 			glDeleteFramebuffers(1, &capture_fbo);
 			glDeleteRenderbuffers(1, &capture_rbo);
-			if (cull_was_enabled) glEnable(GL_CULL_FACE);
+			if (cull_was_enabled) GLStateCache::Enable(GL_CULL_FACE);
 			glViewport(prev_viewport[0], prev_viewport[1], prev_viewport[2], prev_viewport[3]);
 			return out;
 		}
@@ -300,7 +301,7 @@ namespace ignis
 			glBindFramebuffer(GL_FRAMEBUFFER, 0);
 			glDeleteFramebuffers(1, &capture_fbo);
 			glDeleteRenderbuffers(1, &capture_rbo);
-			if (cull_was_enabled) glEnable(GL_CULL_FACE);
+			if (cull_was_enabled) GLStateCache::Enable(GL_CULL_FACE);
 			glViewport(prev_viewport[0], prev_viewport[1], prev_viewport[2], prev_viewport[3]);
 			return out;
 		}
@@ -314,7 +315,7 @@ namespace ignis
 		glDeleteFramebuffers(1, &capture_fbo);
 		glDeleteRenderbuffers(1, &capture_rbo);
 
-		if (cull_was_enabled) glEnable(GL_CULL_FACE);
+		if (cull_was_enabled) GLStateCache::Enable(GL_CULL_FACE);
 		glViewport(prev_viewport[0], prev_viewport[1], prev_viewport[2], prev_viewport[3]);
 
 		return out;
@@ -1,13 +1,16 @@
 #include "GLIndexBuffer.h"
+#include "GLStateCache.h"
 
 #include <glad/glad.h>
 
 namespace ignis
 {
-	GLIndexBuffer::GLIndexBuffer(const uint32_t* indices, uint32_t size)
+	GLIndexBuffer::GLIndexBuffer(const void* indices, uint32_t size)
 		: m_size(size)
 	{
 		glGenBuffers(1, &m_id);
+		// The element binding is VAO state, keep whatever VAO is still bound untouched
+		GLStateCache::BindVertexArray(0);
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id);
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
 	}
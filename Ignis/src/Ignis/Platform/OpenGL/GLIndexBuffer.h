@@ -7,7 +7,7 @@ namespace ignis
 	class GLIndexBuffer : public IndexBuffer
 	{
 	public:
-		GLIndexBuffer(const uint32_t* indices, uint32_t size);
+		GLIndexBuffer(const void* indices, uint32_t size);
 		~GLIndexBuffer() override;
 
 		void Bind() override;
@@ -15,6 +15,8 @@ namespace ignis
 
 		unsigned int GetCount() const override { return m_size / sizeof(uint32_t); }
 
+		uint32_t GetID() const { return m_id; }
+
 	private:
 		uint32_t m_id;
 		uint32_t m_size;
@@ -1,4 +1,5 @@
 #include "GLMaterial.h"
+#include "Ignis/Renderer/Renderer.h"
 #include <glad/glad.h>
 
 namespace ignis
@@ -6,20 +7,29 @@ namespace ignis
 	GLMaterial::GLMaterial(std::shared_ptr<Shader> shader, const std::string& name)
 		: m_shader(std::dynamic_pointer_cast<GLShader>(std::move(shader)))
 		, m_name(name)
+		, m_material_id(s_next_material_id++)
 	{
 		m_uniform_buffer.resize(m_shader->GetUniformBufferSize(), 0);
+		m_dirty_uniforms.resize(m_shader->m_uniform_table.size(), 0);
+		m_textures.resize(m_shader->m_sampler_table.size());
+		m_cubemap_textures.resize(m_shader->m_sampler_table.size());
 	}
 
 	GLMaterial::GLMaterial(const std::shared_ptr<Material>& other, const std::string& name)
 		: m_shader(std::dynamic_pointer_cast<GLShader>(other->GetShader()))
 		, m_name(name)
+		, m_material_id(s_next_material_id++)
 	{
 		m_uniform_buffer.resize(m_shader->GetUniformBufferSize(), 0);
+		m_dirty_uniforms.resize(m_shader->m_uniform_table.size(), 0);
+		m_textures.resize(m_shader->m_sampler_table.size());
+		m_cubemap_textures.resize(m_shader->m_sampler_table.size());
 
 		if (auto* src = dynamic_cast<const GLMaterial*>(other.get()))
 		{
 			m_uniform_buffer = src->m_uniform_buffer;
 			m_textures = src->m_textures;
+			m_cubemap_textures = src->m_cubemap_textures;
 		}
 	}
 
@@ -32,15 +42,45 @@ namespace ignis
 				name, m_shader->GetName());
 			return;
 		}
-		const ShaderUniform& u = it->second;
-		assert(u.size == size && "The data size of the Set does not match the uniform type");
-		std::memcpy(m_uniform_buffer.data() + u.offset, data, size);
+		WriteBytes(it->second, data, size);
+	}
+
+	void GLMaterial::SetBytes(const UniformHandle& handle, const void* data, uint32_t size)
+	{
+		const ShaderUniform* u = m_shader->ResolveUniform(handle);
+		if (!u)
+		{
+			Log::Warn("GLMaterial::Set: uniform handle {0:#x} does not exist in shader '{1}'",
+				handle.NameHash, m_shader->GetName());
+			return;
+		}
+		WriteBytes(*u, data, size);
+	}
+
+	void GLMaterial::WriteBytes(const ShaderUniform& uniform, const void* data, uint32_t size)
+	{
+		assert(uniform.size == size && "The data size of the Set does not match the uniform type");
+
+		uint8_t* dst = m_uniform_buffer.data() + uniform.offset;
+		if (std::memcmp(dst, data, size) == 0)
+			return;
+
+		std::memcpy(dst, data, size);
+		MarkDirty(uniform.index);
+	}
+
+	void GLMaterial::MarkDirty(uint32_t uniform_index)
+	{
+		m_dirty_uniforms[uniform_index] = 1;
+		m_any_dirty = true;
 	}
 
 	void* GLMaterial::GetBytes(const std::string& name)
 	{
 		auto it = m_shader->GetUniforms().find(name);
 		assert(it != m_shader->GetUniforms().end() && "Uniform does not exist");
+		// The caller may write through the returned reference
+		MarkDirty(it->second.index);
 		return m_uniform_buffer.data() + it->second.offset;
 	}
 
@@ -64,15 +104,48 @@ namespace ignis
 	void GLMaterial::Set(const std::string& name, const glm::mat3& value) { SetBytes(name, &value[0][0], sizeof(value)); }
 	void GLMaterial::Set(const std::string& name, const glm::mat4& value) { SetBytes(name, &value[0][0], sizeof(value)); }
 
+	void GLMaterial::Set(const UniformHandle& handle, bool value)
+	{
+		int32_t v = value ? 1 : 0;
+		SetBytes(handle, &v, sizeof(v));
+	}
+	void GLMaterial::Set(const UniformHandle& handle, float value) { SetBytes(handle, &value, sizeof(value)); }
+	void GLMaterial::Set(const UniformHandle& handle, const glm::vec2& value) { SetBytes(handle, &value[0], sizeof(value)); }
+	void GLMaterial::Set(const UniformHandle& handle, const glm::vec3& value) { SetBytes(handle, &value[0], sizeof(value)); }
+	void GLMaterial::Set(const UniformHandle& handle, const glm::vec4& value) { SetBytes(handle, &value[0], sizeof(value)); }
+	void GLMaterial::Set(const UniformHandle& handle, int value) { SetBytes(handle, &value, sizeof(value)); }
+	void GLMaterial::Set(const UniformHandle& handle, const glm::ivec2& value) { SetBytes(handle, &value[0], sizeof(value)); }
+	void GLMaterial::Set(const UniformHandle& handle, const glm::ivec3& value) { SetBytes(handle, &value[0], sizeof(value)); }
+	void GLMaterial::Set(const UniformHandle& handle, const glm::ivec4& value) { SetBytes(handle, &value[0], sizeof(value)); }
+	void GLMaterial::Set(const UniformHandle& handle, uint32_t value) { SetBytes(handle, &value, sizeof(value)); }
+	void GLMaterial::Set(const UniformHandle& handle, const glm::uvec2& value) { SetBytes(handle, &value[0], sizeof(value)); }
+	void GLMaterial::Set(const UniformHandle& handle, const glm::uvec3& value) { SetBytes(handle, &value[0], sizeof(value)); }
+	void GLMaterial::Set(const UniformHandle& handle, const glm::uvec4& value) { SetBytes(handle, &value[0], sizeof(value)); }
+	void GLMaterial::Set(const UniformHandle& handle, const glm::mat3& value) { SetBytes(handle, &value[0][0], sizeof(value)); }
+	void GLMaterial::Set(const UniformHandle& handle, const glm::mat4& value) { SetBytes(handle, &value[0][0], sizeof(value)); }
+
 	void GLMaterial::Set(const std::string& name, const std::shared_ptr<Texture2D>& texture)
 	{
-		if (m_shader->GetSamplers().find(name) == m_shader->GetSamplers().end())
+		auto it = m_shader->GetSamplers().find(name);
+		if (it == m_shader->GetSamplers().end())
 		{
 			Log::Warn("GLMaterial::Set: sampler '{}' does not exist in shader '{}'",
 				name, m_shader->GetName());
 			return;
 		}
-		m_textures[name] = texture;
+		m_textures[it->second.index] = texture;
+	}
+
+	void GLMaterial::Set(const SamplerHandle& handle, const std::shared_ptr<Texture2D>& texture)
+	{
+		const ShaderSampler* sampler = m_shader->ResolveSampler(handle);
+		if (!sampler)
+		{
+			Log::Warn("GLMaterial::Set: sampler handle {:#x} does not exist in shader '{}'",
+				handle.NameHash, m_shader->GetName());
+			return;
+		}
+		m_textures[sampler->index] = texture;
 	}
 
 	float& GLMaterial::GetFloat(const std::string& name) { return GetValue<float>(name); }
@@ -84,13 +157,19 @@ namespace ignis
 	glm::mat3& GLMaterial::GetMat3(const std::string& name) { return GetValue<glm::mat3>(name); }
 	glm::mat4& GLMaterial::GetMat4(const std::string& name) { return GetValue<glm::mat4>(name); }
 
-	void GLMaterial::UploadUniforms()
+	void GLMaterial::UploadUniforms(bool dirty_only)
 	{
-		for (const auto& [name, u] : m_shader->GetUniforms())
+		uint32_t uploaded = 0;
+
+		for (const auto& u : m_shader->m_uniform_table)
 		{
-			int32_t loc = m_shader->GetUniformLocation(name);
+			if (dirty_only && !m_dirty_uniforms[u.index]) continue;
+
+			int32_t loc = u.location;
 			if (loc == -1) continue;
 
+			uploaded++;
+
 			const void* data = m_uniform_buffer.data() + u.offset;
 
 			switch (u.type)
@@ -115,40 +194,68 @@ namespace ignis
 			default: break;
 			}
 		}
+
+		std::fill(m_dirty_uniforms.begin(), m_dirty_uniforms.end(), 0);
+		m_any_dirty = false;
+
+		Renderer::GetStats().UniformsUploaded += uploaded;
 	}
 
 	void GLMaterial::Set(const std::string& name, const std::shared_ptr<TextureCube>& texture)
 	{
-		if (m_shader->GetSamplers().find(name) == m_shader->GetSamplers().end())
+		auto it = m_shader->GetSamplers().find(name);
+		if (it == m_shader->GetSamplers().end())
 		{
 			Log::Warn("GLMaterial::Set: sampler '{}' does not exist in '{}'", name, m_shader->GetName());
 			return;
 		}
-		m_cubemap_textures[name] = texture;
+		m_cubemap_textures[it->second.index] = texture;
+	}
+
+	void GLMaterial::Set(const SamplerHandle& handle, const std::shared_ptr<TextureCube>& texture)
+	{
+		const ShaderSampler* sampler = m_shader->ResolveSampler(handle);
+		if (!sampler)
+		{
+			Log::Warn("GLMaterial::Set: sampler handle {:#x} does not exist in '{}'", handle.NameHash, m_shader->GetName());
+			return;
+		}
+		m_cubemap_textures[sampler->index] = texture;
 	}
 
 	void GLMaterial::Bind()
 	{
 		m_shader->Bind();
-		UploadUniforms();
 
-		for (const auto& [name, sampler] : m_shader->GetSamplers())
+		// Program uniforms persist across binds, so only push what another material
+		// overwrote or what changed since this material last uploaded
+		if (m_shader->m_last_material_id != m_material_id)
 		{
-			int32_t loc = m_shader->GetUniformLocation(name);
-			if (loc == -1) continue;
+			UploadUniforms(false);
+			m_shader->m_last_material_id = m_material_id;
+		}
+		else if (m_any_dirty)
+		{
+			UploadUniforms(true);
+		}
+		else
+		{
+			Renderer::GetStats().MaterialUploadsSkipped++;
+		}
 
-			glUniform1i(loc, static_cast<int32_t>(sampler.slot));
+		// Sampler units are assigned once at link time, only the textures need binding
+		for (const auto& sampler : m_shader->m_sampler_table)
+		{
+			if (sampler.location == -1) continue;
 
-			auto it2d = m_textures.find(name);
-			if (it2d != m_textures.end() && it2d->second)
+			if (const auto& texture = m_textures[sampler.index])
 			{
-				it2d->second->Bind(sampler.slot);
+				texture->Bind(sampler.slot);
 				continue;
 			}
 
-			auto itCube = m_cubemap_textures.find(name);
-			if (itCube != m_cubemap_textures.end() && itCube->second)
-				itCube->second->Bind(sampler.slot);
+			if (const auto& cubemap = m_cubemap_textures[sampler.index])
+				cubemap->Bind(sampler.slot);
 		}
 	}
 }
\ No newline at end of file
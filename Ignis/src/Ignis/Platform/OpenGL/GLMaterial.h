@@ -29,6 +29,24 @@ namespace ignis
 		void Set(const std::string& name, const std::shared_ptr<Texture2D>& texture) override;
 		void Set(const std::string& name, const std::shared_ptr<TextureCube>& texture) override;
 
+		void Set(const UniformHandle& handle, bool value) override;
+		void Set(const UniformHandle& handle, float value) override;
+		void Set(const UniformHandle& handle, const glm::vec2& value) override;
+		void Set(const UniformHandle& handle, const glm::vec3& value) override;
+		void Set(const UniformHandle& handle, const glm::vec4& value) override;
+		void Set(const UniformHandle& handle, int value) override;
+		void Set(const UniformHandle& handle, const glm::ivec2& value) override;
+		void Set(const UniformHandle& handle, const glm::ivec3& value) override;
+		void Set(const UniformHandle& handle, const glm::ivec4& value) override;
+		void Set(const UniformHandle& handle, uint32_t value) override;
+		void Set(const UniformHandle& handle, const glm::uvec2& value) override;
+		void Set(const UniformHandle& handle, const glm::uvec3& value) override;
+		void Set(const UniformHandle& handle, const glm::uvec4& value) override;
+		void Set(const UniformHandle& handle, const glm::mat3& value) override;
+		void Set(const UniformHandle& handle, const glm::mat4& value) override;
+		void Set(const SamplerHandle& handle, const std::shared_ptr<Texture2D>& texture) override;
+		void Set(const SamplerHandle& handle, const std::shared_ptr<TextureCube>& texture) override;
+
 		float& GetFloat(const std::string& name) override;
 		int32_t& GetInt(const std::string& name) override;
 		uint32_t& GetUInt(const std::string& name) override;
@@ -45,6 +63,8 @@ namespace ignis
 
 	private:
 		void SetBytes(const std::string& name, const void* data, uint32_t size);
+		void SetBytes(const UniformHandle& handle, const void* data, uint32_t size);
+		void WriteBytes(const ShaderUniform& uniform, const void* data, uint32_t size);
 		void* GetBytes(const std::string& name);
 
 		template<typename T>
@@ -53,15 +73,22 @@ namespace ignis
 			return *reinterpret_cast<T*>(GetBytes(name));
 		}
 
-		void UploadUniforms();
+		void UploadUniforms(bool dirty_only);
+		void MarkDirty(uint32_t uniform_index);
 
 	private:
 		std::shared_ptr<GLShader> m_shader;
 		std::string m_name;
 
 		std::vector<uint8_t>      m_uniform_buffer;
+		std::vector<uint8_t>      m_dirty_uniforms;
+		bool                      m_any_dirty = false;
+
+		uint64_t m_material_id = 0;
+		inline static uint64_t s_next_material_id = 1;
 
-		std::unordered_map<std::string, std::shared_ptr<Texture2D>> m_textures;
-		std::unordered_map<std::string, std::shared_ptr<TextureCube>> m_cubemap_textures;
+		// Indexed by ShaderSampler::index
+		std::vector<std::shared_ptr<Texture2D>> m_textures;
+		std::vector<std::shared_ptr<TextureCube>> m_cubemap_textures;
 	};
 }
\ No newline at end of file
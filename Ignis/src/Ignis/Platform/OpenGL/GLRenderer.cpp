@@ -1,7 +1,11 @@
 #include "GLRenderer.h"
 #include "Ignis/Renderer/Shader.h"
+#include "Ignis/Renderer/PBRUniforms.h"
+#include "Ignis/Scene/Scene.h"
+#include "GLStateCache.h"
 
 #include <glad/glad.h>
+#include <algorithm>
 
 namespace ignis
 {
@@ -38,9 +42,28 @@ namespace ignis
 			 1.0f,  1.0f, 1.0f, 1.0f
 		};
 
+		namespace text_uniforms
+		{
+			UniformHandle Model("u_Model");
+			UniformHandle View("u_View");
+			UniformHandle Projection("u_Projection");
+			UniformHandle ScreenSize("u_ScreenSize");
+			UniformHandle Color("u_Color");
+			SamplerHandle Atlas("u_Atlas");
+			UniformHandle DistanceField("u_DistanceField");
+		}
+
 		static constexpr uint32_t kMaxTextQuads = 4096;
 		static constexpr uint32_t kMaxTextVertices = kMaxTextQuads * 4;
 
+		static constexpr uint32_t kMaxInstancesPerDraw = 1024;
+		static constexpr uint32_t kMaxStreamedSprites = 4096;
+
+		static GLenum ToGL(IndexFormat f)
+		{
+			return f == IndexFormat::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+		}
+
 		static GLenum ToGL(RenderState::DepthFunc f)
 		{
 			switch (f)
@@ -79,13 +102,18 @@ namespace ignis
 		m_shader_library = std::make_unique<ShaderLibrary>();
 
 		m_shader_library->Load("resources://shaders/IgnisPBR.glsl", "IgnisPBR");
+		m_shader_library->Load("resources://shaders/IgnisPBR.glsl", "IgnisPBR_Instanced", "#define INSTANCED 1\n");
+		m_shader_library->Load("resources://shaders/DepthPrepass.glsl", "DepthPrepass");
+		m_shader_library->Load("resources://shaders/DepthPrepass.glsl", "DepthPrepass_Instanced", "#define INSTANCED 1\n");
 		m_shader_library->Load("resources://shaders/Skybox.glsl", "Skybox");
 		m_shader_library->Load("resources://shaders/EquirectToCube.glsl", "EquirectToCube");
 		m_shader_library->Load("resources://shaders/IrradianceConvolution.glsl", "IrradianceConvolution");
 		m_shader_library->Load("resources://shaders/PrefilterGGX.glsl", "PrefilterGGX");
 		m_shader_library->Load("resources://shaders/BRDFIntegration.glsl", "BRDFIntegration");
 		m_shader_library->Load("resources://shaders/Text.glsl", "Text");
+		m_shader_library->Load("resources://shaders/Text.glsl", "Text_Batched", "#define BATCHED 1\n");
 		m_shader_library->Load("resources://shaders/UI.glsl", "UI");
+		m_shader_library->Load("resources://shaders/UI.glsl", "UI_Batched", "#define BATCHED 1\n");
 
 		// Cube
 		m_cube_vao = VertexArray::Create();
@@ -104,8 +132,13 @@ namespace ignis
 
 		m_shader_library->Load("resources://screen.glsl");
 
+		// Instancing
+		m_instance_vbo = VertexBuffer::Create(kMaxInstancesPerDraw * sizeof(glm::mat4), VertexBuffer::Usage::Dynamic);
+		m_instance_vbo->SetLayout({ { 7, Shader::DataType::Mat4 } });
+
 		// Text
-		m_text_vbo = VertexBuffer::Create(kMaxTextVertices * sizeof(float) * 4, VertexBuffer::Usage::Dynamic);
+		// Streaming buffers are rings, sized for a few frames of writes before they wrap
+		m_text_vbo = VertexBuffer::Create(kMaxTextVertices * sizeof(float) * 4, VertexBuffer::Usage::Stream);
 		m_text_vbo->SetLayout({
 			{ 0, Shader::DataType::Float2 },   // a_Position
 			{ 1, Shader::DataType::Float2 }    // a_TexCoord
@@ -114,8 +147,35 @@ namespace ignis
 		m_text_vao = VertexArray::Create();
 		m_text_vao->AddVertexBuffer(m_text_vbo);
 
-		// Sprite quad (dynamic, reused every draw call)
-		m_sprite_vbo = VertexBuffer::Create(4 * sizeof(float) * 4, VertexBuffer::Usage::Dynamic);
+		// World text, anchor and color per vertex so strings sharing an atlas draw together
+		m_text_batch_vbo = VertexBuffer::Create(kMaxTextVertices * sizeof(TextBatchVertex) * 2, VertexBuffer::Usage::Stream);
+		m_text_batch_vbo->SetLayout({
+			{ 0, Shader::DataType::Float2 },   // a_Position
+			{ 1, Shader::DataType::Float2 },   // a_TexCoord
+			{ 2, Shader::DataType::Float3 },   // a_Anchor
+			{ 3, Shader::DataType::Float4 }    // a_Color
+		});
+
+		m_text_batch_vao = VertexArray::Create();
+		m_text_batch_vao->AddVertexBuffer(m_text_batch_vbo);
+
+		// Quad indices are the same for every glyph, one static buffer serves all text draws
+		std::vector<uint16_t> quad_indices;
+		quad_indices.reserve(kMaxTextQuads * 6);
+		for (uint32_t quad = 0; quad < kMaxTextQuads; quad++)
+		{
+			const uint16_t b = static_cast<uint16_t>(quad * 4);
+			quad_indices.insert(quad_indices.end(), { b, uint16_t(b + 1), uint16_t(b + 2), b, uint16_t(b + 2), uint16_t(b + 3) });
+		}
+		m_quad_index_buffer = IndexBuffer::Create(quad_indices.data(), static_cast<uint32_t>(quad_indices.size() * sizeof(uint16_t)));
+		m_text_vao->SetIndexBuffer(m_quad_index_buffer);
+		m_text_batch_vao->SetIndexBuffer(m_quad_index_buffer);
+
+		m_text_batch_material = Material::Create(m_shader_library->Get("Text_Batched"));
+		m_ui_text_material = Material::Create(m_shader_library->Get("Text"));
+
+		// Sprite quads, one appended per draw call
+		m_sprite_vbo = VertexBuffer::Create(kMaxStreamedSprites * 4 * sizeof(float) * 4, VertexBuffer::Usage::Stream);
 		m_sprite_vbo->SetLayout({
 			{ 0, Shader::DataType::Float2 },  // a_Position
 			{ 1, Shader::DataType::Float2 }   // a_TexCoord
@@ -127,14 +187,43 @@ namespace ignis
 		uint32_t sprite_indices[6] = { 0, 1, 2, 0, 2, 3 };
 		auto sprite_ibo = IndexBuffer::Create(sprite_indices, sizeof(sprite_indices));
 		m_sprite_vao->SetIndexBuffer(sprite_ibo);
+
+		// Batched UI quads, texture index and color per vertex so one draw covers many rects
+		m_sprite_batch_vbo = VertexBuffer::Create(kMaxTextVertices * sizeof(SpriteVertex) * 2, VertexBuffer::Usage::Stream);
+		m_sprite_batch_vbo->SetLayout({
+			{ 0, Shader::DataType::Float2 },  // a_Position
+			{ 1, Shader::DataType::Float2 },  // a_TexCoord
+			{ 2, Shader::DataType::Float4 },  // a_Color
+			{ 3, Shader::DataType::Float }    // a_TextureIndex
+			});
+		m_sprite_batch_vao = VertexArray::Create();
+		m_sprite_batch_vao->AddVertexBuffer(m_sprite_batch_vbo);
+		m_sprite_batch_vao->SetIndexBuffer(m_quad_index_buffer);
+
+		// Per-frame uniform blocks
+		m_camera_uniform_buffer = UniformBuffer::Create(sizeof(CameraUniformData), UniformBufferBinding::Camera);
+		m_light_uniform_buffer = UniformBuffer::Create(sizeof(LightUniformData), UniformBufferBinding::Lights);
+		m_cluster_uniform_buffer = UniformBuffer::Create(sizeof(ClusterUniformData), UniformBufferBinding::Clusters);
+
+		// Clustered lights, grown on upload when a scene needs more
+		m_light_texture_buffer = TextureBuffer::Create(TextureBufferFormat::RGBA32F,
+			64 * LightGrid::TexelsPerLight * sizeof(glm::vec4), TextureBufferBinding::Lights);
+		m_cluster_texture_buffer = TextureBuffer::Create(TextureBufferFormat::RG32UI,
+			LightGrid::ClusterCount * sizeof(glm::uvec2), TextureBufferBinding::Clusters);
+		m_light_index_texture_buffer = TextureBuffer::Create(TextureBufferFormat::R32UI,
+			LightGrid::ClusterCount * 4 * sizeof(uint32_t), TextureBufferBinding::LightIndices);
 	}
 
 	void GLRenderer::BeginFrame()
 	{
+		GetStats().Reset();
+		// ImGui and other code outside the renderer may have touched GL state since last frame
+		GLStateCache::Invalidate();
+
 		if (m_framebuffer)
 			m_framebuffer->Bind();
 
-		glEnable(GL_DEPTH_TEST);
+		GLStateCache::Enable(GL_DEPTH_TEST);
 	}
 
 	void GLRenderer::EndFrame()
@@ -171,71 +260,170 @@ namespace ignis
 		glViewport(viewport.x, viewport.y, viewport.z, viewport.w);
 	}
 
-	void GLRenderer::DrawIndexed(VertexArray& va)
+	void GLRenderer::DrawIndexed(VertexArray& va, uint32_t base_vertex)
 	{
 		va.Bind();
-		glDrawElements(GL_TRIANGLES, va.GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr);
-		va.UnBind();
+		glDrawElementsBaseVertex(GL_TRIANGLES, va.GetIndexBuffer()->GetCount(), GL_UNSIGNED_INT, nullptr, base_vertex);
 	}
 
-	void GLRenderer::DrawLines(VertexArray& va, uint32_t vertex_count)
+	void GLRenderer::DrawLines(VertexArray& va, uint32_t vertex_count, uint32_t first_vertex)
 	{
 		va.Bind();
-		glDrawArrays(GL_LINES, 0, vertex_count);
-		va.UnBind();
+		glDrawArrays(GL_LINES, first_vertex, vertex_count);
 	}
 
-	void GLRenderer::RenderMesh(const Mesh& mesh, const glm::mat4& model, 
-		const Environment& scene_environment, const EnvironmentSettings& environment_settings, const LightEnvironment& light_environment)
+	void GLRenderer::UploadCameraData(const Camera& camera)
 	{
-		auto vao = mesh.GetVertexArray();
-		vao->Bind();
+		CameraUniformData data = CameraUniformData::From(camera);
+		m_camera_uniform_buffer->SetData(&data, sizeof(data));
+	}
+
+	void GLRenderer::UploadLightEnvironment(const LightEnvironment& light_environment)
+	{
+		if (light_environment.Version == m_uploaded_light_version)
+			return;
+
+		LightUniformData data = LightUniformData::From(light_environment);
+		m_light_uniform_buffer->SetData(&data, sizeof(data));
+
+		LightGrid::PackLights(light_environment, m_light_texels);
+		m_light_texture_buffer->SetData(m_light_texels.data(), static_cast<uint32_t>(m_light_texels.size() * sizeof(glm::vec4)));
+
+		m_uploaded_light_version = light_environment.Version;
+	}
+
+	void GLRenderer::UploadLightGrid(const LightGrid& light_grid)
+	{
+		const auto& uniform_data = light_grid.GetUniformData();
+		m_cluster_uniform_buffer->SetData(&uniform_data, sizeof(uniform_data));
+
+		const auto& clusters = light_grid.GetClusters();
+		const auto& light_indices = light_grid.GetLightIndices();
+		m_cluster_texture_buffer->SetData(clusters.data(), static_cast<uint32_t>(clusters.size() * sizeof(glm::uvec2)));
+		m_light_index_texture_buffer->SetData(light_indices.data(), static_cast<uint32_t>(light_indices.size() * sizeof(uint32_t)));
+
+		// Units are reserved for these, rebinding is filtered by the state cache unless something else took them
+		m_light_texture_buffer->Bind();
+		m_cluster_texture_buffer->Bind();
+		m_light_index_texture_buffer->Bind();
+
+		auto& stats = GetStats();
+		stats.ClusteredLights = light_grid.GetLightCount();
+		stats.LightIndices = static_cast<uint32_t>(light_indices.size());
+	}
 
+	void GLRenderer::RenderMesh(const Mesh& mesh, const glm::mat4& model, 
+		const Environment& scene_environment, const EnvironmentSettings& environment_settings)
+	{
 		const auto& materials_data = mesh.GetMaterialsData();
 
 		for (const auto& sm : mesh.GetSubmeshes())
 		{
 			const auto& material_data = materials_data[sm.MaterialIndex];
+			auto material = m_pipeline->GetMaterial(material_data, scene_environment, environment_settings);
 
-			RenderState state;
-			switch (material_data.Alpha)
-			{
-			case AlphaMode::Opaque:
-			case AlphaMode::Mask:
-				state = RenderState::Default();
-				break;
-			case AlphaMode::Blend:
-				state = RenderState::Transparent();
-				break;
-			}
+			RenderSubmesh(mesh, sm, *material, RenderState::ForMaterial(material_data), model, 0);
+		}
+
+		ResetRenderState();
+	}
+
+	void GLRenderer::RenderSubmesh(const Mesh& mesh, const Submesh& submesh, Material& material,
+		const RenderState& state, const glm::mat4& model, uint32_t lod)
+	{
+		SetRenderState(state);
+		mesh.GetVertexArray()->Bind();
+
+		// TODO hard coded to be refactored
+		material.Set(pbr_uniforms::Model, model);
+
+		const SubmeshLOD range = submesh.GetLOD(lod);
+
+		material.Bind();
+		glDrawElementsBaseVertex(
+			GL_TRIANGLES,
+			range.IndexCount,
+			ToGL(submesh.Format),
+			(void*)static_cast<uintptr_t>(range.IndexOffset + mesh.GetIndexBufferOffset()),
+			submesh.BaseVertex + mesh.GetBaseVertexOffset()
+		);
+
+		GetStats().DrawCalls++;
+	}
+
+	void GLRenderer::RenderSubmeshes(const SubmeshDraw* draws, uint32_t draw_count, Material& material,
+		const RenderState& state, const glm::mat4& model)
+	{
+		if (draw_count == 0)
+			return;
 
-			if (material_data.DoubleSided)
-				state.CullFace = false;
+		SetRenderState(state);
+		draws[0].MeshPtr->GetVertexArray()->Bind();
 
-			SetRenderState(state);
+		material.Set(pbr_uniforms::Model, model);
+		material.Bind();
 
-			// TODO a performance bottleneck?
-			auto material = m_pipeline->CreateMaterial(material_data);
-			m_pipeline->ApplyEnvironment(*material, scene_environment, environment_settings, light_environment);
+		m_multi_draw_counts.clear();
+		m_multi_draw_offsets.clear();
+		m_multi_draw_base_vertices.clear();
+		for (uint32_t i = 0; i < draw_count; i++)
+		{
+			const auto& draw = draws[i];
+			const SubmeshLOD range = draw.SubmeshPtr->GetLOD(draw.LOD);
+			m_multi_draw_counts.push_back(static_cast<GLsizei>(range.IndexCount));
+			m_multi_draw_offsets.push_back((const void*)static_cast<uintptr_t>(range.IndexOffset + draw.MeshPtr->GetIndexBufferOffset()));
+			m_multi_draw_base_vertices.push_back(static_cast<GLint>(draw.SubmeshPtr->BaseVertex + draw.MeshPtr->GetBaseVertexOffset()));
+		}
 
-			material->Set("view", m_camera->GetView());
-			material->Set("projection", m_camera->GetProjection());
+		glMultiDrawElementsBaseVertex(
+			GL_TRIANGLES,
+			m_multi_draw_counts.data(),
+			ToGL(draws[0].SubmeshPtr->Format),
+			m_multi_draw_offsets.data(),
+			static_cast<GLsizei>(draw_count),
+			m_multi_draw_base_vertices.data()
+		);
+
+		auto& stats = GetStats();
+		stats.DrawCalls++;
+		stats.MultiDrawCalls++;
+		stats.MultiDrawSubmeshes += draw_count;
+	}
 
-			// TODO hard coded to be refactored
-			material->Set("model", model);
-			material->Set("viewPos", m_camera->GetPosition());
+	void GLRenderer::RenderSubmeshInstanced(const Mesh& mesh, const Submesh& submesh, Material& material,
+		const RenderState& state, const glm::mat4* models, uint32_t instance_count, uint32_t lod)
+	{
+		auto vao = mesh.GetVertexArray();
+
+		const auto& vertex_buffers = vao->GetVertexBuffers();
+		if (std::find(vertex_buffers.begin(), vertex_buffers.end(), m_instance_vbo) == vertex_buffers.end())
+			vao->AddVertexBuffer(m_instance_vbo);
+
+		SetRenderState(state);
+		vao->Bind();
+		material.Bind();
 
-			material->Bind();
-			glDrawElements(
+		const SubmeshLOD range = submesh.GetLOD(lod);
+
+		auto& stats = GetStats();
+		for (uint32_t first = 0; first < instance_count; first += kMaxInstancesPerDraw)
+		{
+			const uint32_t count = std::min(instance_count - first, kMaxInstancesPerDraw);
+			m_instance_vbo->SetData(models + first, count * sizeof(glm::mat4));
+
+			glDrawElementsInstancedBaseVertex(
 				GL_TRIANGLES,
-				sm.IndexCount,
-				GL_UNSIGNED_INT,
-				(void*)(sm.BaseIndex * sizeof(uint32_t))
+				range.IndexCount,
+				ToGL(submesh.Format),
+				(void*)static_cast<uintptr_t>(range.IndexOffset + mesh.GetIndexBufferOffset()),
+				count,
+				submesh.BaseVertex + mesh.GetBaseVertexOffset()
 			);
-		}
 
-		ResetRenderState();
-		vao->UnBind();
+			stats.DrawCalls++;
+			stats.InstancedDrawCalls++;
+			stats.InstancesDrawn += count;
+		}
 	}
 
 	void GLRenderer::RenderSkybox(const Environment& environment, const EnvironmentSettings& environment_settings)
@@ -243,11 +431,6 @@ namespace ignis
 		SetRenderState(RenderState::Skybox());
 
 		auto material = m_pipeline->CreateSkyboxMaterial(environment, environment_settings);
-
-		glm::mat4 view = glm::mat4(glm::mat3(m_camera->GetView()));
-		material->Set("view", view);
-		material->Set("projection", m_camera->GetProjection());
-
 		material->Bind();
 		RenderCube();
 
@@ -259,80 +442,86 @@ namespace ignis
 		if (text.empty() || !font.GetAtlas())
 			return;
 
-		struct Vertex { float x, y, u, v; };
-		std::vector<Vertex>   vertices;
-		std::vector<uint32_t> indices;
-		vertices.reserve(text.size() * 4);
-		indices.reserve(text.size() * 6);
-
-		float    cursor_x = 0.0f;
-		float    cursor_y = 0.0f;
-		uint32_t quad_idx = 0;
+		m_text_layout.Update(font, text, scale);
 
-		for (unsigned char c : text)
-		{
-			if (c == '\n')
-			{
-				cursor_x = 0.0f;
-				cursor_y += font.GetLineHeight() * scale;
-				continue;
-			}
-
-			const GlyphMetrics* g = font.GetGlyph(static_cast<char>(c));
-			if (!g)
-			{
-				if (const GlyphMetrics* sp = font.GetGlyph(' '))
-					cursor_x += sp->Advance * scale;
-				continue;
-			}
+		const TextDraw draw{ &m_text_layout, glm::vec3(transform[3]), color };
+		RenderTextBatch(font, &draw, 1);
+	}
 
-			const float px0 = cursor_x + g->QuadMin.x * scale;
-			const float py0 = cursor_y - g->QuadMax.y * scale;
-			const float px1 = cursor_x + g->QuadMax.x * scale;
-			const float py1 = cursor_y - g->QuadMin.y * scale;
+	void GLRenderer::RenderTextBatch(const Font& font, const TextDraw* draws, uint32_t draw_count)
+	{
+		if (draw_count == 0 || !font.GetAtlas())
+			return;
 
-			const float u0 = g->AtlasMin.x, v0 = g->AtlasMin.y;
-			const float u1 = g->AtlasMax.x, v1 = g->AtlasMax.y;
+		m_text_batch_material->Set(text_uniforms::View, m_camera->GetView());
+		m_text_batch_material->Set(text_uniforms::Projection, m_camera->GetProjection());
+		m_text_batch_material->Set(text_uniforms::ScreenSize, glm::vec2(m_viewport_width, m_viewport_height));
+		m_text_batch_material->Set(text_uniforms::DistanceField, font.IsDistanceField() ? 1 : 0);
 
-			vertices.push_back({ px0, py1, u0, v0 });
-			vertices.push_back({ px1, py1, u1, v0 });
-			vertices.push_back({ px1, py0, u1, v1 });
-			vertices.push_back({ px0, py0, u0, v1 });
+		SetRenderState(RenderState::Transparent());
 
-			const uint32_t b = quad_idx * 4;
-			indices.insert(indices.end(), { b, b + 1, b + 2,  b, b + 2, b + 3 });
+		uint32_t max_page = 0;
+		for (uint32_t i = 0; i < draw_count; i++)
+			max_page = std::max(max_page, draws[i].Layout->GetMaxPage());
 
-			cursor_x += g->Advance * scale;
-			++quad_idx;
+		// Anchor and color are per vertex, so every string sharing the atlas goes in the same draw.
+		// Glyphs from lazily loaded pages add one pass per page.
+		for (uint32_t page = 0; page <= max_page && page < font.GetAtlasPageCount(); page++)
+		{
+			m_text_batch_material->Set(text_uniforms::Atlas, font.GetAtlasPage(page));
+			m_text_batch_material->Bind();
+			DrawTextBatchPage(draws, draw_count, page);
 		}
 
-		if (vertices.empty())
-			return;
+		GetStats().TextStrings += draw_count;
 
-		m_text_vbo->SetData(vertices.data(), vertices.size() * sizeof(Vertex));
+		ResetRenderState();
+	}
 
-		auto ibo = IndexBuffer::Create(
-			indices.data(),
-			static_cast<uint32_t>(indices.size() * sizeof(uint32_t)));
-		m_text_vao->SetIndexBuffer(ibo);
+	void GLRenderer::DrawTextBatchPage(const TextDraw* draws, uint32_t draw_count, uint32_t page)
+	{
+		m_text_batch_vertices.clear();
+		for (uint32_t i = 0; i < draw_count; i++)
+		{
+			const TextDraw& draw = draws[i];
+			if (draw.Layout->GetMaxPage() < page)
+				continue;
 
-		const glm::vec2 screen_size = { m_viewport_width, m_viewport_height };
+			for (const GlyphQuad& quad : draw.Layout->GetQuads())
+			{
+				if (quad.Page != page)
+					continue;
+
+				if (m_text_batch_vertices.size() == kMaxTextVertices)
+				{
+					DrawTextQuads(*m_text_batch_vao, *m_text_batch_vbo, m_text_batch_vertices.data(), kMaxTextQuads, sizeof(TextBatchVertex));
+					m_text_batch_vertices.clear();
+				}
+
+				m_text_batch_vertices.push_back({ { quad.Min.x, quad.Max.y }, { quad.UVMin.x, quad.UVMin.y }, draw.Anchor, draw.Color });
+				m_text_batch_vertices.push_back({ { quad.Max.x, quad.Max.y }, { quad.UVMax.x, quad.UVMin.y }, draw.Anchor, draw.Color });
+				m_text_batch_vertices.push_back({ { quad.Max.x, quad.Min.y }, { quad.UVMax.x, quad.UVMax.y }, draw.Anchor, draw.Color });
+				m_text_batch_vertices.push_back({ { quad.Min.x, quad.Min.y }, { quad.UVMin.x, quad.UVMax.y }, draw.Anchor, draw.Color });
+			}
+		}
 
-		auto mat = Material::Create(m_shader_library->Get("Text"));
-		mat->Set("u_Model", transform);
-		mat->Set("u_View", m_camera->GetView());
-		mat->Set("u_Projection", m_camera->GetProjection());
-		mat->Set("u_ScreenSize", screen_size);
-		mat->Set("u_Color", color);
-		mat->Set("u_Atlas", font.GetAtlas());
-		font.GetAtlas()->Bind(0);
+		if (!m_text_batch_vertices.empty())
+		{
+			DrawTextQuads(*m_text_batch_vao, *m_text_batch_vbo, m_text_batch_vertices.data(),
+				static_cast<uint32_t>(m_text_batch_vertices.size() / 4), sizeof(TextBatchVertex));
+		}
+	}
 
-		SetRenderState(RenderState::Transparent());
+	void GLRenderer::DrawTextQuads(VertexArray& va, VertexBuffer& vb, const void* vertices, uint32_t quad_count, size_t vertex_size)
+	{
+		const uint32_t base_vertex = vb.Append(vertices, quad_count * 4 * vertex_size);
 
-		mat->Bind();
-		DrawIndexed(*m_text_vao);
+		va.Bind();
+		glDrawElementsBaseVertex(GL_TRIANGLES, quad_count * 6, GL_UNSIGNED_SHORT, nullptr, base_vertex);
 
-		ResetRenderState();
+		auto& stats = GetStats();
+		stats.TextDrawCalls++;
+		stats.TextGlyphs += quad_count;
 	}
 
 	void GLRenderer::Clear()
@@ -349,14 +538,12 @@ namespace ignis
 	{
 		m_cube_vao->Bind();
 		glDrawArrays(GL_TRIANGLES, 0, 36);
-		m_cube_vao->UnBind();
 	}
 
 	void GLRenderer::RenderQuad()
 	{
 		m_quad_vao->Bind();
 		glDrawArrays(GL_TRIANGLES, 0, 6);
-		m_quad_vao->UnBind();
 	}
 
 	void GLRenderer::RenderSprite(const glm::vec2& min, const glm::vec2& max)
@@ -369,93 +556,83 @@ namespace ignis
 			{ max.x, max.y, 1.0f, 1.0f },   // bottom-right
 			{ min.x, max.y, 0.0f, 1.0f }    // bottom-left
 		};
-		m_sprite_vbo->SetData(verts, sizeof(verts));
+		const uint32_t base_vertex = m_sprite_vbo->Append(verts, sizeof(verts));
 
 		SetRenderState(RenderState::Transparent());
 
-		DrawIndexed(*m_sprite_vao);
+		DrawIndexed(*m_sprite_vao, base_vertex);
 
 		ResetRenderState();
 	}
 
-	void GLRenderer::RenderUIText(const Font& font, const std::string& text,
-		const glm::mat4& projection,
-		const glm::mat4& model,
-		const glm::vec4& color,
-		float scale)
+	void GLRenderer::RenderSpriteBatch(const SpriteVertex* vertices, uint32_t quad_count)
 	{
-		// Identical vertex-building logic to RenderText,
-		// but uses explicit projection + identity view.
-		if (text.empty() || !font.GetAtlas()) return;
-
-		struct Vertex { float x, y, u, v; };
-		std::vector<Vertex>   vertices;
-		std::vector<uint32_t> indices;
-		vertices.reserve(text.size() * 4);
-		indices.reserve(text.size() * 6);
+		if (quad_count == 0) return;
 
-		float    cursor_x = 0.0f;
-		float    cursor_y = 0.0f;
-		uint32_t quad_idx = 0;
+		SetRenderState(RenderState::Transparent());
 
-		for (unsigned char c : text)
+		auto& stats = GetStats();
+		for (uint32_t first = 0; first < quad_count; first += kMaxTextQuads)
 		{
-			if (c == '\n')
-			{
-				cursor_x = 0.0f;
-				cursor_y -= font.GetLineHeight() * scale; // y-up: move down = subtract
-				continue;
-			}
-
-			const GlyphMetrics* g = font.GetGlyph(static_cast<char>(c));
-			if (!g)
-			{
-				if (const GlyphMetrics* sp = font.GetGlyph(' '))
-					cursor_x += sp->Advance * scale;
-				continue;
-			}
+			const uint32_t count = std::min(quad_count - first, kMaxTextQuads);
+			const uint32_t base_vertex = m_sprite_batch_vbo->Append(vertices + first * 4, count * 4 * sizeof(SpriteVertex));
 
-			const float px0 = cursor_x + g->QuadMin.x * scale;
-			const float py0 = cursor_y - g->QuadMax.y * scale;
-			const float px1 = cursor_x + g->QuadMax.x * scale;
-			const float py1 = cursor_y - g->QuadMin.y * scale;
-
-			const float u0 = g->AtlasMin.x, v0 = g->AtlasMin.y;
-			const float u1 = g->AtlasMax.x, v1 = g->AtlasMax.y;
-
-			vertices.push_back({ px0, py1, u0, v0 });
-			vertices.push_back({ px1, py1, u1, v0 });
-			vertices.push_back({ px1, py0, u1, v1 });
-			vertices.push_back({ px0, py0, u0, v1 });
-
-			const uint32_t b = quad_idx * 4;
-			indices.insert(indices.end(), { b, b + 1, b + 2,  b, b + 2, b + 3 });
-
-			cursor_x += g->Advance * scale;
-			++quad_idx;
+			m_sprite_batch_vao->Bind();
+			glDrawElementsBaseVertex(GL_TRIANGLES, count * 6, GL_UNSIGNED_SHORT, nullptr, base_vertex);
+			stats.UIDrawCalls++;
 		}
+		stats.UIRects += quad_count;
 
-		if (vertices.empty()) return;
+		ResetRenderState();
+	}
 
-		m_text_vbo->SetData(vertices.data(), vertices.size() * sizeof(Vertex));
-		auto ibo = IndexBuffer::Create(indices.data(),
-			static_cast<uint32_t>(indices.size() * sizeof(uint32_t)));
-		m_text_vao->SetIndexBuffer(ibo);
+	void GLRenderer::RenderUIText(const Font& font, const TextLayout& layout,
+		const glm::mat4& projection,
+		const glm::mat4& model,
+		const glm::vec4& color)
+	{
+		// Same quads as RenderText with lines stacked downwards, explicit projection + identity view
+		if (layout.IsEmpty() || !font.GetAtlas()) return;
 
-		auto mat = Material::Create(m_shader_library->Get("Text"));
-		mat->Set("u_Model", model);
-		mat->Set("u_View", glm::mat4(1.0f));   // identity  no 3D camera
-		mat->Set("u_Projection", projection);
-		mat->Set("u_ScreenSize", glm::vec2(static_cast<float>(m_viewport_width),
+		m_ui_text_material->Set(text_uniforms::Model, model);
+		m_ui_text_material->Set(text_uniforms::View, glm::mat4(1.0f));   // identity  no 3D camera
+		m_ui_text_material->Set(text_uniforms::Projection, projection);
+		m_ui_text_material->Set(text_uniforms::ScreenSize, glm::vec2(static_cast<float>(m_viewport_width),
 			static_cast<float>(m_viewport_height)));
-		mat->Set("u_Color", color);
-		mat->Set("u_Atlas", font.GetAtlas());
-		font.GetAtlas()->Bind(0);
+		m_ui_text_material->Set(text_uniforms::Color, color);
+		m_ui_text_material->Set(text_uniforms::DistanceField, font.IsDistanceField() ? 1 : 0);
 
 		SetRenderState(RenderState::Transparent());
 
-		mat->Bind();
-		DrawIndexed(*m_text_vao);
+		const uint32_t page_count = std::min(layout.GetMaxPage() + 1, font.GetAtlasPageCount());
+		for (uint32_t page = 0; page < page_count; page++)
+		{
+			m_ui_text_vertices.clear();
+			for (const GlyphQuad& quad : layout.GetQuads())
+			{
+				if (quad.Page != page)
+					continue;
+
+				m_ui_text_vertices.push_back({ quad.Min.x, quad.Max.y, quad.UVMin.x, quad.UVMin.y });
+				m_ui_text_vertices.push_back({ quad.Max.x, quad.Max.y, quad.UVMax.x, quad.UVMin.y });
+				m_ui_text_vertices.push_back({ quad.Max.x, quad.Min.y, quad.UVMax.x, quad.UVMax.y });
+				m_ui_text_vertices.push_back({ quad.Min.x, quad.Min.y, quad.UVMin.x, quad.UVMax.y });
+			}
+			if (m_ui_text_vertices.empty())
+				continue;
+
+			m_ui_text_material->Set(text_uniforms::Atlas, font.GetAtlasPage(page));
+			m_ui_text_material->Bind();
+
+			// The shared quad index buffer covers kMaxTextQuads, longer strings take several draws
+			const uint32_t quad_count = static_cast<uint32_t>(m_ui_text_vertices.size() / 4);
+			for (uint32_t first = 0; first < quad_count; first += kMaxTextQuads)
+			{
+				DrawTextQuads(*m_text_vao, *m_text_vbo, m_ui_text_vertices.data() + first * 4,
+					std::min(quad_count - first, kMaxTextQuads), sizeof(UITextVertex));
+			}
+		}
+		GetStats().TextStrings++;
 
 		ResetRenderState();
 	}
@@ -463,36 +640,27 @@ namespace ignis
 	void GLRenderer::SetRenderState(const RenderState& state)
 	{
 		// Depth test
-		state.DepthTest ? glEnable(GL_DEPTH_TEST) : glDisable(GL_DEPTH_TEST);
-		glDepthFunc(ToGL(state.Depth));
-		glDepthMask(state.DepthWrite ? GL_TRUE : GL_FALSE);
+		GLStateCache::SetEnabled(GL_DEPTH_TEST, state.DepthTest);
+		GLStateCache::DepthFunc(ToGL(state.Depth));
+		GLStateCache::DepthMask(state.DepthWrite);
+		GLStateCache::ColorMask(state.ColorWrite);
 
 		// Culling
+		GLStateCache::SetEnabled(GL_CULL_FACE, state.CullFace);
 		if (state.CullFace)
 		{
-			glEnable(GL_CULL_FACE);
 			switch (state.Cull)
 			{
-			case RenderState::CullMode::Back:         glCullFace(GL_BACK);  break;
-			case RenderState::CullMode::Front:        glCullFace(GL_FRONT); break;
-			case RenderState::CullMode::FrontAndBack: glCullFace(GL_FRONT_AND_BACK); break;
+			case RenderState::CullMode::Back:         GLStateCache::CullFace(GL_BACK);  break;
+			case RenderState::CullMode::Front:        GLStateCache::CullFace(GL_FRONT); break;
+			case RenderState::CullMode::FrontAndBack: GLStateCache::CullFace(GL_FRONT_AND_BACK); break;
 			}
 		}
-		else
-		{
-			glDisable(GL_CULL_FACE);
-		}
 
 		// Blend
+		GLStateCache::SetEnabled(GL_BLEND, state.Blend);
 		if (state.Blend)
-		{
-			glEnable(GL_BLEND);
-			glBlendFunc(ToGL(state.BlendSrc), ToGL(state.BlendDst));
-		}
-		else
-		{
-			glDisable(GL_BLEND);
-		}
+			GLStateCache::BlendFunc(ToGL(state.BlendSrc), ToGL(state.BlendDst));
 	}
 
 	void GLRenderer::ResetRenderState()
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Ignis/Renderer/Renderer.h"
+#include "Ignis/Renderer/UniformBuffer.h"
+#include "Ignis/Renderer/TextureBuffer.h"
 
 namespace ignis
 {
@@ -24,13 +26,20 @@ namespace ignis
 		void SetViewport(int x, int y, int width, int height) override;
 		void SetViewport(const glm::ivec4& viewport) override;
 
-		void DrawIndexed(VertexArray& va) override;
-		void DrawLines(VertexArray& va, uint32_t vertex_count) override;
+		void DrawIndexed(VertexArray& va, uint32_t base_vertex = 0) override;
+		void DrawLines(VertexArray& va, uint32_t vertex_count, uint32_t first_vertex = 0) override;
 
 		void RenderMesh(const Mesh& mesh, const glm::mat4& model,
-			const Environment& scene_environment, const EnvironmentSettings& environment_settings, const LightEnvironment& light_environment) override;
+			const Environment& scene_environment, const EnvironmentSettings& environment_settings) override;
+		void RenderSubmesh(const Mesh& mesh, const Submesh& submesh, Material& material,
+			const RenderState& state, const glm::mat4& model, uint32_t lod) override;
+		void RenderSubmeshInstanced(const Mesh& mesh, const Submesh& submesh, Material& material,
+			const RenderState& state, const glm::mat4* models, uint32_t instance_count, uint32_t lod) override;
+		void RenderSubmeshes(const SubmeshDraw* draws, uint32_t draw_count, Material& material,
+			const RenderState& state, const glm::mat4& model) override;
 		void RenderSkybox(const Environment& environment, const EnvironmentSettings& environment_settings) override;
 		void RenderText(const Font& font, const std::string& text, const glm::mat4& transform, const glm::vec4& color, float scale) override;
+		void RenderTextBatch(const Font& font, const TextDraw* draws, uint32_t draw_count) override;
 
 		void Clear() override;
 
@@ -38,6 +47,9 @@ namespace ignis
 		std::shared_ptr<Framebuffer> GetFramebuffer() const { return m_framebuffer; }
 
 		void SetCamera(std::shared_ptr<Camera> camera) override { m_camera = camera; }
+		void UploadCameraData(const Camera& camera) override;
+		void UploadLightEnvironment(const LightEnvironment& light_environment) override;
+		void UploadLightGrid(const LightGrid& light_grid) override;
 		void SetPipeline(std::shared_ptr<Pipeline> pipeline) override { m_pipeline = pipeline; }
 
 		const ShaderLibrary& GetShaderLibrary() const override { return *m_shader_library; }
@@ -47,11 +59,31 @@ namespace ignis
 		void RenderQuad() override;
 
 		void RenderSprite(const glm::vec2& min, const glm::vec2& max) override;
-		void RenderUIText(const Font& font, const std::string& text, const glm::mat4& projection, const glm::mat4& model, const glm::vec4& color, float scale) override;
+		void RenderSpriteBatch(const SpriteVertex* vertices, uint32_t quad_count) override;
+		void RenderUIText(const Font& font, const TextLayout& layout, const glm::mat4& projection, const glm::mat4& model, const glm::vec4& color) override;
 
 		void SetRenderState(const RenderState& state) override;
 		void ResetRenderState() override;
 
+	private:
+		struct TextBatchVertex
+		{
+			glm::vec2 Position;
+			glm::vec2 TexCoord;
+			glm::vec3 Anchor;
+			glm::vec4 Color;
+		};
+
+		struct UITextVertex
+		{
+			float x, y, u, v;
+		};
+
+		// Draws the quads of every layout that sample the given atlas page
+		void DrawTextBatchPage(const TextDraw* draws, uint32_t draw_count, uint32_t page);
+		// Appends quad_count glyph quads and draws them with the shared quad index buffer
+		void DrawTextQuads(VertexArray& va, VertexBuffer& vb, const void* vertices, uint32_t quad_count, size_t vertex_size);
+
 	private:
 		std::shared_ptr<VertexArray> m_cube_vao;
 		std::shared_ptr<VertexArray> m_quad_vao;
@@ -62,9 +94,37 @@ namespace ignis
 		std::unique_ptr<ShaderLibrary> m_shader_library;
 		std::shared_ptr<VertexArray> m_text_vao;
 		std::shared_ptr<VertexBuffer> m_text_vbo;
+		std::shared_ptr<VertexArray> m_text_batch_vao;
+		std::shared_ptr<VertexBuffer> m_text_batch_vbo;
+		std::shared_ptr<IndexBuffer> m_quad_index_buffer;
+		std::shared_ptr<Material> m_text_batch_material;
+		std::shared_ptr<Material> m_ui_text_material;
+		// Reused between calls so text draws do not allocate once warmed up
+		TextLayout m_text_layout;
+		std::vector<TextBatchVertex> m_text_batch_vertices;
+		std::vector<UITextVertex> m_ui_text_vertices;
 		uint32_t m_viewport_width = 1920;
 		uint32_t m_viewport_height = 1080;
 		std::shared_ptr<VertexArray>  m_sprite_vao;
 		std::shared_ptr<VertexBuffer> m_sprite_vbo;
+		std::shared_ptr<VertexArray>  m_sprite_batch_vao;
+		std::shared_ptr<VertexBuffer> m_sprite_batch_vbo;
+		// Model matrices for instanced draws, attached to a mesh VAO on its first instanced draw
+		std::shared_ptr<VertexBuffer> m_instance_vbo;
+		// Scratch arrays for glMultiDrawElementsBaseVertex
+		std::vector<int32_t> m_multi_draw_counts;
+		std::vector<const void*> m_multi_draw_offsets;
+		std::vector<int32_t> m_multi_draw_base_vertices;
+
+		std::shared_ptr<UniformBuffer> m_camera_uniform_buffer;
+		std::shared_ptr<UniformBuffer> m_light_uniform_buffer;
+		std::shared_ptr<UniformBuffer> m_cluster_uniform_buffer;
+
+		// Clustered point and spot lights
+		std::shared_ptr<TextureBuffer> m_light_texture_buffer;
+		std::shared_ptr<TextureBuffer> m_cluster_texture_buffer;
+		std::shared_ptr<TextureBuffer> m_light_index_texture_buffer;
+		std::vector<glm::vec4> m_light_texels;
+		uint64_t m_uploaded_light_version = UINT64_MAX;
 	};
 }
\ No newline at end of file
@@ -1,8 +1,39 @@
 #include "GLShader.h"
+#include "Ignis/Renderer/UniformBuffer.h"
+#include "Ignis/Renderer/TextureBuffer.h"
+#include "GLStateCache.h"
 #include <glad/glad.h>
+#include <atomic>
 
 namespace ignis
 {
+	namespace
+	{
+		std::atomic<uint32_t> s_next_uniform_handle_id = 0;
+		std::atomic<uint32_t> s_next_sampler_handle_id = 0;
+
+		constexpr uint32_t k_slot_unresolved = UINT32_MAX;
+		constexpr uint32_t k_slot_missing = UINT32_MAX - 1;
+
+		template<typename Handle, typename Entry>
+		const Entry* ResolveSlot(const Handle& handle, std::atomic<uint32_t>& next_id, std::vector<uint32_t>& slots,
+			const std::vector<Entry>& table, const std::unordered_map<uint32_t, uint32_t>& lookup)
+		{
+			if (handle.Id == UINT32_MAX)
+				handle.Id = next_id.fetch_add(1, std::memory_order_relaxed);
+			if (handle.Id >= slots.size())
+				slots.resize(handle.Id + 1, k_slot_unresolved);
+
+			// Misses are cached too, variants often lack uniforms the shared handles name
+			uint32_t& slot = slots[handle.Id];
+			if (slot == k_slot_unresolved)
+			{
+				auto it = lookup.find(handle.NameHash);
+				slot = it != lookup.end() ? it->second : k_slot_missing;
+			}
+			return slot == k_slot_missing ? nullptr : &table[slot];
+		}
+	}
 
 	std::string InjectStageDefine(const std::string& source, const std::string& define_line)
 	{
@@ -189,6 +220,19 @@ namespace ignis
 		}
 	}
 
+	static bool GLTypeIsBufferSampler(GLenum type)
+	{
+		switch (type)
+		{
+		case GL_SAMPLER_BUFFER:
+		case GL_INT_SAMPLER_BUFFER:
+		case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+			return true;
+		default:
+			return false;
+		}
+	}
+
 	GLShader::GLShader(const std::string& name, const std::string& vertex_source, const std::string& fragment_source)
 		: m_id(0), m_name(name)
 	{
@@ -211,7 +255,7 @@ namespace ignis
 			Reflect();
 	}
 
-	GLShader::GLShader(const std::string& filepath)
+	GLShader::GLShader(const std::string& filepath, const std::string& defines)
 		: m_id(0), m_name(filepath)
 	{
 		const std::string combined_source = ReadFileToString(filepath);
@@ -220,8 +264,8 @@ namespace ignis
 			return;
 		}
 
-		const std::string vertex_define = "#define VERTEX_STAGE 1\n";
-		const std::string fragment_define = "#define FRAGMENT_STAGE 1\n";
+		const std::string vertex_define = defines + "#define VERTEX_STAGE 1\n";
+		const std::string fragment_define = defines + "#define FRAGMENT_STAGE 1\n";
 
 		const GLuint vertex_shader = CompileShaderStage(GL_VERTEX_SHADER, combined_source, vertex_define, "VERTEX");
 		if (vertex_shader == 0)
@@ -244,17 +288,18 @@ namespace ignis
 
 	GLShader::~GLShader()
 	{
+		GLStateCache::OnProgramDeleted(m_id);
 		glDeleteProgram(m_id);
 	}
 
 	void GLShader::Bind()
 	{
-		glUseProgram(m_id);
+		GLStateCache::UseProgram(m_id);
 	}
 
 	void GLShader::UnBind()
 	{
-		glUseProgram(0);
+		GLStateCache::UseProgram(0);
 	}
 
 	void GLShader::Reflect()
@@ -266,6 +311,8 @@ namespace ignis
 
 		m_uniformBufferSize = 0;
 		uint32_t samplerSlot = 0;
+		// Engine-fed buffer samplers on their reserved units, hidden from materials
+		std::vector<std::pair<GLint, int32_t>> buffer_samplers;
 
 		for (GLint i = 0; i < uniformCount; ++i)
 		{
@@ -278,14 +325,39 @@ namespace ignis
 				sizeof(nameBuffer), &nameLength,
 				&arraySize, &glType, nameBuffer);
 
+			// Block members are fed by uniform buffers, not by materials
+			const GLuint index = static_cast<GLuint>(i);
+			GLint block_index = -1;
+			glGetActiveUniformsiv(m_id, 1, &index, GL_UNIFORM_BLOCK_INDEX, &block_index);
+			if (block_index != -1)
+				continue;
+
 			std::string name(nameBuffer, static_cast<size_t>(nameLength));
 
 			if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
 				name.resize(name.size() - 3);
 
-			if (GLTypeIsSampler(glType))
+			if (GLTypeIsBufferSampler(glType))
 			{
-				m_samplers[name] = { name, samplerSlot++ };
+				const int32_t unit = TextureBuffer::GetSamplerBinding(name);
+				if (unit < 0)
+				{
+					Log::CoreWarn("Shader '{}': buffer sampler '{}' has no reserved texture unit", m_name, name);
+					continue;
+				}
+				buffer_samplers.emplace_back(glGetUniformLocation(m_id, name.c_str()), unit);
+			}
+			else if (GLTypeIsSampler(glType))
+			{
+				ShaderSampler s;
+				s.name = name;
+				s.slot = samplerSlot++;
+				s.hash = HashUniformName(name);
+				s.index = static_cast<uint32_t>(m_sampler_table.size());
+				s.location = glGetUniformLocation(m_id, name.c_str());
+
+				m_samplers[name] = s;
+				m_sampler_table.push_back(s);
 			}
 			else
 			{
@@ -298,11 +370,83 @@ namespace ignis
 				u.type = type;
 				u.size = ShaderUniform::TypeSize(type);
 				u.offset = m_uniformBufferSize;
+				u.hash = HashUniformName(name);
+				u.index = static_cast<uint32_t>(m_uniform_table.size());
+				u.location = glGetUniformLocation(m_id, name.c_str());
 				m_uniformBufferSize += u.size;
 
 				m_uniforms[name] = u;
+				m_uniform_table.push_back(u);
 			}
 		}
+
+		for (const auto& u : m_uniform_table)
+		{
+			if (!m_uniform_lookup.emplace(u.hash, u.index).second)
+				Log::CoreWarn("Shader '{}': uniform '{}' hash collides, handle lookups may resolve wrongly", m_name, u.name);
+		}
+
+		for (const auto& s : m_sampler_table)
+		{
+			if (!m_sampler_lookup.emplace(s.hash, s.index).second)
+				Log::CoreWarn("Shader '{}': sampler '{}' hash collides, handle lookups may resolve wrongly", m_name, s.name);
+		}
+
+		// Sampler units never change after linking, assign them once
+		GLint previous_program = 0;
+		glGetIntegerv(GL_CURRENT_PROGRAM, &previous_program);
+		glUseProgram(m_id);
+		for (const auto& s : m_sampler_table)
+		{
+			if (s.location != -1)
+				glUniform1i(s.location, static_cast<int32_t>(s.slot));
+		}
+		for (const auto& [location, unit] : buffer_samplers)
+		{
+			if (location != -1)
+				glUniform1i(location, unit);
+		}
+		glUseProgram(static_cast<GLuint>(previous_program));
+
+		ReflectUniformBlocks();
+	}
+
+	const ShaderUniform* GLShader::ResolveUniform(const UniformHandle& handle) const
+	{
+		return ResolveSlot(handle, s_next_uniform_handle_id, m_uniform_slots, m_uniform_table, m_uniform_lookup);
+	}
+
+	const ShaderSampler* GLShader::ResolveSampler(const SamplerHandle& handle) const
+	{
+		return ResolveSlot(handle, s_next_sampler_handle_id, m_sampler_slots, m_sampler_table, m_sampler_lookup);
+	}
+
+	void GLShader::ReflectUniformBlocks()
+	{
+		GLint block_count = 0;
+		glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_BLOCKS, &block_count);
+
+		for (GLint i = 0; i < block_count; ++i)
+		{
+			GLchar  name_buffer[256];
+			GLsizei name_length = 0;
+			glGetActiveUniformBlockName(m_id, static_cast<GLuint>(i), sizeof(name_buffer), &name_length, name_buffer);
+
+			GLint data_size = 0;
+			glGetActiveUniformBlockiv(m_id, static_cast<GLuint>(i), GL_UNIFORM_BLOCK_DATA_SIZE, &data_size);
+
+			ShaderUniformBlock block;
+			block.name = std::string(name_buffer, static_cast<size_t>(name_length));
+			block.size = static_cast<uint32_t>(data_size);
+			block.binding = UniformBuffer::GetBlockBinding(block.name);
+
+			if (block.binding >= 0)
+				glUniformBlockBinding(m_id, static_cast<GLuint>(i), static_cast<GLuint>(block.binding));
+			else
+				Log::CoreWarn("Shader '{}': uniform block '{}' has no engine binding", m_name, block.name);
+
+			m_uniform_blocks[block.name] = block;
+		}
 	}
 
 	int32_t GLShader::GetUniformLocation(const std::string& name) const
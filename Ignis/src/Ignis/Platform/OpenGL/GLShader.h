@@ -8,7 +8,7 @@ namespace ignis
 	{
 	public:
 		GLShader(const std::string& name, const std::string& vertex_source, const std::string& fragment_source);
-		GLShader(const std::string& filepath);
+		GLShader(const std::string& filepath, const std::string& defines = "");
 
 		~GLShader() override;
 
@@ -19,22 +19,40 @@ namespace ignis
 
 		const std::unordered_map<std::string, ShaderUniform>& GetUniforms() const override { return m_uniforms; }
 		const std::unordered_map<std::string, ShaderSampler>& GetSamplers() const override { return m_samplers; }
+		const std::unordered_map<std::string, ShaderUniformBlock>& GetUniformBlocks() const override { return m_uniform_blocks; }
 		uint32_t GetUniformBufferSize() const override { return m_uniformBufferSize; }
 
+		const ShaderUniform* ResolveUniform(const UniformHandle& handle) const override;
+		const ShaderSampler* ResolveSampler(const SamplerHandle& handle) const override;
+
 		int32_t GetUniformLocation(const std::string& name) const;
 
 	private:
 		void Reflect();
+		void ReflectUniformBlocks();
 
 		uint32_t m_id = 0;
 		std::string m_name = "";
 
 		std::unordered_map<std::string, ShaderUniform> m_uniforms;
 		std::unordered_map<std::string, ShaderSampler> m_samplers;
+		std::unordered_map<std::string, ShaderUniformBlock> m_uniform_blocks;
 		uint32_t m_uniformBufferSize = 0;
 
+		// Flat tables indexed by ShaderUniform::index / ShaderSampler::index
+		std::vector<ShaderUniform> m_uniform_table;
+		std::vector<ShaderSampler> m_sampler_table;
+		std::unordered_map<uint32_t, uint32_t> m_uniform_lookup;
+		std::unordered_map<uint32_t, uint32_t> m_sampler_lookup;
+		// Table indices indexed by handle id, filled in as handles are first resolved against this shader
+		mutable std::vector<uint32_t> m_uniform_slots;
+		mutable std::vector<uint32_t> m_sampler_slots;
+
 		mutable std::unordered_map<std::string, int32_t> m_location_cache;
 
+		// Material whose values are currently resident in this program's uniforms
+		uint64_t m_last_material_id = 0;
+
 		friend class GLMaterial;
 	};
 }
\ No newline at end of file
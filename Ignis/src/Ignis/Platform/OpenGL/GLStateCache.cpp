@@ -0,0 +1,218 @@
+#include "GLStateCache.h"
+#include "Ignis/Renderer/Renderer.h"
+
+#include <glad/glad.h>
+
+namespace ignis
+{
+	namespace
+	{
+		constexpr uint32_t k_unknown = UINT32_MAX;
+
+		enum class TextureTarget : uint32_t
+		{
+			Texture2D = 0,
+			TextureCube,
+			Texture2DMultisample,
+			TextureBuffer,
+			Count
+		};
+
+		struct State
+		{
+			// -1 unknown, 0 disabled, 1 enabled
+			int8_t DepthTest = -1;
+			int8_t CullFace = -1;
+			int8_t Blend = -1;
+			int8_t DepthMask = -1;
+			int8_t ColorMask = -1;
+
+			uint32_t DepthFunc = k_unknown;
+			uint32_t CullMode = k_unknown;
+			uint32_t BlendSrc = k_unknown;
+			uint32_t BlendDst = k_unknown;
+
+			uint32_t Program = k_unknown;
+			uint32_t VertexArray = k_unknown;
+
+			uint32_t ActiveUnit = k_unknown;
+			uint32_t Textures[GLStateCache::MaxTextureUnits][static_cast<size_t>(TextureTarget::Count)];
+
+			State()
+			{
+				for (auto& unit : Textures)
+					for (auto& texture : unit)
+						texture = k_unknown;
+			}
+		};
+
+		State s_state;
+
+		int8_t* GetCapSlot(uint32_t cap)
+		{
+			switch (cap)
+			{
+			case GL_DEPTH_TEST: return &s_state.DepthTest;
+			case GL_CULL_FACE:  return &s_state.CullFace;
+			case GL_BLEND:      return &s_state.Blend;
+			default:            return nullptr;
+			}
+		}
+
+		bool GetTargetSlot(uint32_t target, TextureTarget& out)
+		{
+			switch (target)
+			{
+			case GL_TEXTURE_2D:             out = TextureTarget::Texture2D; return true;
+			case GL_TEXTURE_CUBE_MAP:       out = TextureTarget::TextureCube; return true;
+			case GL_TEXTURE_2D_MULTISAMPLE: out = TextureTarget::Texture2DMultisample; return true;
+			case GL_TEXTURE_BUFFER:         out = TextureTarget::TextureBuffer; return true;
+			default:                        return false;
+			}
+		}
+
+		// Returns true if the call has to be issued
+		template<typename T>
+		bool Update(T& cached, T value, uint32_t& skipped)
+		{
+			if (cached == value)
+			{
+				++skipped;
+				return false;
+			}
+			cached = value;
+			++Renderer::GetStats().StateChangesIssued;
+			return true;
+		}
+	}
+
+	void GLStateCache::Invalidate()
+	{
+		s_state = State();
+	}
+
+	void GLStateCache::SetEnabled(uint32_t cap, bool enabled)
+	{
+		int8_t* slot = GetCapSlot(cap);
+		if (!slot)
+		{
+			enabled ? glEnable(cap) : glDisable(cap);
+			return;
+		}
+
+		if (Update<int8_t>(*slot, enabled ? 1 : 0, Renderer::GetStats().StateChangesSkipped))
+			enabled ? glEnable(cap) : glDisable(cap);
+	}
+
+	void GLStateCache::DepthFunc(uint32_t func)
+	{
+		if (Update(s_state.DepthFunc, func, Renderer::GetStats().StateChangesSkipped))
+			glDepthFunc(func);
+	}
+
+	void GLStateCache::DepthMask(bool write)
+	{
+		if (Update<int8_t>(s_state.DepthMask, write ? 1 : 0, Renderer::GetStats().StateChangesSkipped))
+			glDepthMask(write ? GL_TRUE : GL_FALSE);
+	}
+
+	void GLStateCache::ColorMask(bool write)
+	{
+		const GLboolean value = write ? GL_TRUE : GL_FALSE;
+		if (Update<int8_t>(s_state.ColorMask, write ? 1 : 0, Renderer::GetStats().StateChangesSkipped))
+			glColorMask(value, value, value, value);
+	}
+
+	void GLStateCache::CullFace(uint32_t mode)
+	{
+		if (Update(s_state.CullMode, mode, Renderer::GetStats().StateChangesSkipped))
+			glCullFace(mode);
+	}
+
+	void GLStateCache::BlendFunc(uint32_t src, uint32_t dst)
+	{
+		if (s_state.BlendSrc == src && s_state.BlendDst == dst)
+		{
+			++Renderer::GetStats().StateChangesSkipped;
+			return;
+		}
+
+		s_state.BlendSrc = src;
+		s_state.BlendDst = dst;
+		++Renderer::GetStats().StateChangesIssued;
+		glBlendFunc(src, dst);
+	}
+
+	void GLStateCache::UseProgram(uint32_t program)
+	{
+		if (Update(s_state.Program, program, Renderer::GetStats().ProgramBindsSkipped))
+			glUseProgram(program);
+	}
+
+	void GLStateCache::BindVertexArray(uint32_t vertex_array)
+	{
+		if (Update(s_state.VertexArray, vertex_array, Renderer::GetStats().VertexArrayBindsSkipped))
+			glBindVertexArray(vertex_array);
+	}
+
+	void GLStateCache::ActiveTexture(uint32_t unit)
+	{
+		if (s_state.ActiveUnit == unit)
+			return;
+
+		s_state.ActiveUnit = unit;
+		glActiveTexture(GL_TEXTURE0 + unit);
+	}
+
+	void GLStateCache::BindTexture(uint32_t target, uint32_t texture)
+	{
+		TextureTarget slot;
+		if (s_state.ActiveUnit >= MaxTextureUnits || !GetTargetSlot(target, slot))
+		{
+			glBindTexture(target, texture);
+			return;
+		}
+
+		auto& cached = s_state.Textures[s_state.ActiveUnit][static_cast<size_t>(slot)];
+		if (Update(cached, texture, Renderer::GetStats().TextureBindsSkipped))
+			glBindTexture(target, texture);
+	}
+
+	void GLStateCache::BindTexture(uint32_t unit, uint32_t target, uint32_t texture)
+	{
+		TextureTarget slot;
+		if (unit < MaxTextureUnits && GetTargetSlot(target, slot)
+			&& s_state.Textures[unit][static_cast<size_t>(slot)] == texture)
+		{
+			++Renderer::GetStats().TextureBindsSkipped;
+			return;
+		}
+
+		ActiveTexture(unit);
+		BindTexture(target, texture);
+	}
+
+	void GLStateCache::OnProgramDeleted(uint32_t program)
+	{
+		if (s_state.Program == program)
+			s_state.Program = k_unknown;
+	}
+
+	void GLStateCache::OnVertexArrayDeleted(uint32_t vertex_array)
+	{
+		if (s_state.VertexArray == vertex_array)
+			s_state.VertexArray = k_unknown;
+	}
+
+	void GLStateCache::OnTextureDeleted(uint32_t texture)
+	{
+		for (auto& unit : s_state.Textures)
+		{
+			for (auto& cached : unit)
+			{
+				if (cached == texture)
+					cached = k_unknown;
+			}
+		}
+	}
+}
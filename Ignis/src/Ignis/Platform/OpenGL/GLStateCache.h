@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ignis
+{
+	// Shadow of the GL state the renderer touches most often. Setters only
+	// reach the driver when the requested value differs from the shadowed one.
+	// Code that changes this state behind the cache's back must either restore
+	// it or call Invalidate().
+	class GLStateCache
+	{
+	public:
+		static constexpr uint32_t MaxTextureUnits = 32;
+
+		static void Invalidate();
+
+		// GL_DEPTH_TEST, GL_CULL_FACE and GL_BLEND are shadowed, other caps pass through
+		static void SetEnabled(uint32_t cap, bool enabled);
+		static void Enable(uint32_t cap) { SetEnabled(cap, true); }
+		static void Disable(uint32_t cap) { SetEnabled(cap, false); }
+
+		static void DepthFunc(uint32_t func);
+		static void DepthMask(bool write);
+		static void ColorMask(bool write);
+		static void CullFace(uint32_t mode);
+		static void BlendFunc(uint32_t src, uint32_t dst);
+
+		static void UseProgram(uint32_t program);
+		static void BindVertexArray(uint32_t vertex_array);
+
+		static void ActiveTexture(uint32_t unit);
+		// Binds to the currently active unit
+		static void BindTexture(uint32_t target, uint32_t texture);
+		static void BindTexture(uint32_t unit, uint32_t target, uint32_t texture);
+
+		// GL recycles names, forget deleted objects so a new one with the same id gets bound
+		static void OnProgramDeleted(uint32_t program);
+		static void OnVertexArrayDeleted(uint32_t vertex_array);
+		static void OnTextureDeleted(uint32_t texture);
+	};
+}
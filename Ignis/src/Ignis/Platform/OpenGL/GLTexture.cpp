@@ -1,6 +1,7 @@
 #include "GLTexture.h"
 #include "Ignis/Renderer/Image.h"
 #include "GLUtils.h"
+#include "GLStateCache.h"
 #include <glad/glad.h>
 
 namespace ignis
@@ -23,7 +24,7 @@ namespace ignis
 		}
 
 		glGenTextures(1, &m_id);
-		glBindTexture(GL_TEXTURE_2D, m_id);
+		GLStateCache::BindTexture(GL_TEXTURE_2D, m_id);
 
 		ApplyTextureParameters(m_specs);
 
@@ -31,7 +32,7 @@ namespace ignis
 		SetData(source_format, data);
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
-		glBindTexture(GL_TEXTURE_2D, 0);
+		GLStateCache::BindTexture(GL_TEXTURE_2D, 0);
 	}
 
 	GLTexture2D::GLTexture2D(const TextureSpecs& specs)
@@ -44,7 +45,7 @@ namespace ignis
 		}
 
 		glGenTextures(1, &m_id);
-		glBindTexture(GL_TEXTURE_2D, m_id);
+		GLStateCache::BindTexture(GL_TEXTURE_2D, m_id);
 
 		ApplyTextureParameters(m_specs);
 
@@ -107,23 +108,23 @@ namespace ignis
 
 		if (m_specs.Samples > 1)
 		{
-			glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, m_id);
+			GLStateCache::BindTexture(GL_TEXTURE_2D_MULTISAMPLE, m_id);
 
 			glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_specs.Samples,
 				internal_format, m_specs.Width, m_specs.Height, GL_TRUE);
 
-			glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+			GLStateCache::BindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
 		}
 		else
 		{
-			glBindTexture(GL_TEXTURE_2D, m_id);
+			GLStateCache::BindTexture(GL_TEXTURE_2D, m_id);
 
 			ApplyTextureParameters(m_specs);
 
 			glTexImage2D(GL_TEXTURE_2D, 0, internal_format, m_specs.Width, m_specs.Height, 0,
 				format, type, nullptr);
 
-			glBindTexture(GL_TEXTURE_2D, 0);
+			GLStateCache::BindTexture(GL_TEXTURE_2D, 0);
 		}
 	}
 
@@ -141,15 +142,31 @@ namespace ignis
 		}
 	}
 
+	void GLTexture2D::SetSubData(uint32_t x, uint32_t y, uint32_t width, uint32_t height, ImageFormat source_format, std::span<const std::byte> data) const
+	{
+		GLStateCache::BindTexture(GL_TEXTURE_2D, m_id);
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+		glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height,
+			utils::ToGLImageFormat(source_format), utils::ToGLDataType(source_format), static_cast<const void*>(data.data()));
+
+		if (m_specs.GenMipmaps)
+		{
+			glGenerateMipmap(GL_TEXTURE_2D);
+		}
+
+		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		GLStateCache::BindTexture(GL_TEXTURE_2D, 0);
+	}
+
 	void GLTexture2D::Bind(uint32_t unit) const
 	{
-		glActiveTexture(GL_TEXTURE0 + unit);
-		glBindTexture(GL_TEXTURE_2D, m_id);
+		GLStateCache::BindTexture(unit, GL_TEXTURE_2D, m_id);
 	}
 
 	void GLTexture2D::UnBind() const
 	{
-		glBindTexture(GL_TEXTURE_2D, 0);
+		GLStateCache::BindTexture(GL_TEXTURE_2D, 0);
 	}
 
 
@@ -164,7 +181,7 @@ namespace ignis
 		}
 
 		glGenTextures(1, &m_id);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_id);
+		GLStateCache::BindTexture(GL_TEXTURE_CUBE_MAP, m_id);
 
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -176,7 +193,7 @@ namespace ignis
 		SetData(source_format, data);
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
-		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		GLStateCache::BindTexture(GL_TEXTURE_CUBE_MAP, 0);
 	}
 
 	GLTextureCube::GLTextureCube(const TextureSpecs& specs)
@@ -189,7 +206,7 @@ namespace ignis
 		}
 
 		glGenTextures(1, &m_id);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_id);
+		GLStateCache::BindTexture(GL_TEXTURE_CUBE_MAP, m_id);
 
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 		glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -215,7 +232,7 @@ namespace ignis
 			);
 		}
 
-		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		GLStateCache::BindTexture(GL_TEXTURE_CUBE_MAP, 0);
 	}
 
 	void GLTextureCube::SetData(ImageFormat source_format, std::span<const std::byte> data) const
@@ -259,12 +276,11 @@ namespace ignis
 
 	void GLTextureCube::Bind(uint32_t unit) const
 	{
-		glActiveTexture(GL_TEXTURE0 + unit);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_id);
+		GLStateCache::BindTexture(unit, GL_TEXTURE_CUBE_MAP, m_id);
 	}
 
 	void GLTextureCube::UnBind() const
 	{
-		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		GLStateCache::BindTexture(GL_TEXTURE_CUBE_MAP, 0);
 	}
 }
\ No newline at end of file
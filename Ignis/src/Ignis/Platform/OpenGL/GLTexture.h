@@ -13,6 +13,7 @@ namespace ignis
 		uint32_t GetHeight() const override { return m_specs.Height; }
 
 		void SetData(ImageFormat source_format, std::span<const std::byte> data) const override;
+		void SetSubData(uint32_t x, uint32_t y, uint32_t width, uint32_t height, ImageFormat source_format, std::span<const std::byte> data) const override;
 
 		void Bind(uint32_t unit) const override;
 		void UnBind() const override;
@@ -0,0 +1,59 @@
+#include "GLTextureBuffer.h"
+#include "GLStateCache.h"
+
+#include <glad/glad.h>
+#include <algorithm>
+
+namespace ignis
+{
+	static GLenum ToGLInternalFormat(TextureBufferFormat format)
+	{
+		switch (format)
+		{
+		case TextureBufferFormat::RGBA32F: return GL_RGBA32F;
+		case TextureBufferFormat::RG32UI:  return GL_RG32UI;
+		case TextureBufferFormat::R32UI:   return GL_R32UI;
+		default:                           return GL_R32UI;
+		}
+	}
+
+	GLTextureBuffer::GLTextureBuffer(TextureBufferFormat format, uint32_t size, uint32_t binding)
+		: m_capacity(std::max(size, 16u)), m_binding(binding)
+	{
+		glGenBuffers(1, &m_buffer_id);
+		glBindBuffer(GL_TEXTURE_BUFFER, m_buffer_id);
+		glBufferData(GL_TEXTURE_BUFFER, m_capacity, nullptr, GL_STREAM_DRAW);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+		glGenTextures(1, &m_texture_id);
+		GLStateCache::BindTexture(m_binding, GL_TEXTURE_BUFFER, m_texture_id);
+		glTexBuffer(GL_TEXTURE_BUFFER, ToGLInternalFormat(format), m_buffer_id);
+	}
+
+	GLTextureBuffer::~GLTextureBuffer()
+	{
+		GLStateCache::OnTextureDeleted(m_texture_id);
+		glDeleteTextures(1, &m_texture_id);
+		glDeleteBuffers(1, &m_buffer_id);
+	}
+
+	void GLTextureBuffer::SetData(const void* data, uint32_t size)
+	{
+		glBindBuffer(GL_TEXTURE_BUFFER, m_buffer_id);
+
+		if (size > m_capacity)
+			m_capacity = std::max(size, m_capacity + m_capacity / 2);
+
+		// Orphaned every update; the texture samples the buffer object rather than one data store, so it stays attached
+		glBufferData(GL_TEXTURE_BUFFER, m_capacity, nullptr, GL_STREAM_DRAW);
+
+		if (size > 0)
+			glBufferSubData(GL_TEXTURE_BUFFER, 0, size, data);
+		glBindBuffer(GL_TEXTURE_BUFFER, 0);
+	}
+
+	void GLTextureBuffer::Bind() const
+	{
+		GLStateCache::BindTexture(m_binding, GL_TEXTURE_BUFFER, m_texture_id);
+	}
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Ignis/Renderer/TextureBuffer.h"
+
+namespace ignis
+{
+	class GLTextureBuffer : public TextureBuffer
+	{
+	public:
+		GLTextureBuffer(TextureBufferFormat format, uint32_t size, uint32_t binding);
+		~GLTextureBuffer() override;
+
+		void SetData(const void* data, uint32_t size) override;
+		void Bind() const override;
+
+		uint32_t GetBinding() const override { return m_binding; }
+
+	private:
+		uint32_t m_buffer_id = 0;
+		uint32_t m_texture_id = 0;
+		uint32_t m_capacity = 0;
+		uint32_t m_binding = 0;
+	};
+}
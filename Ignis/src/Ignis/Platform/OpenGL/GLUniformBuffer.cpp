@@ -0,0 +1,39 @@
+#include "GLUniformBuffer.h"
+
+#include <glad/glad.h>
+
+namespace ignis
+{
+	GLUniformBuffer::GLUniformBuffer(uint32_t size, uint32_t binding)
+		: m_size(size), m_binding(binding)
+	{
+		glGenBuffers(1, &m_id);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_id);
+		glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		glBindBufferBase(GL_UNIFORM_BUFFER, m_binding, m_id);
+	}
+
+	GLUniformBuffer::~GLUniformBuffer()
+	{
+		glDeleteBuffers(1, &m_id);
+	}
+
+	void GLUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
+	{
+		if (offset + size > m_size)
+		{
+			Log::CoreError("GLUniformBuffer::SetData out of range ({} + {} > {})", offset, size, m_size);
+			return;
+		}
+
+		glBindBuffer(GL_UNIFORM_BUFFER, m_id);
+		// Orphan on full updates so the driver does not stall on the previous frame's draws
+		if (offset == 0 && size == m_size)
+			glBufferData(GL_UNIFORM_BUFFER, m_size, data, GL_DYNAMIC_DRAW);
+		else
+			glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	}
+}
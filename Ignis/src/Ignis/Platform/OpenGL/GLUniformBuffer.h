@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Ignis/Renderer/UniformBuffer.h"
+
+namespace ignis
+{
+	class GLUniformBuffer : public UniformBuffer
+	{
+	public:
+		GLUniformBuffer(uint32_t size, uint32_t binding);
+		~GLUniformBuffer() override;
+
+		void SetData(const void* data, uint32_t size, uint32_t offset = 0) override;
+		uint32_t GetBinding() const override { return m_binding; }
+
+	private:
+		uint32_t m_id = 0;
+		uint32_t m_size = 0;
+		uint32_t m_binding = 0;
+	};
+}
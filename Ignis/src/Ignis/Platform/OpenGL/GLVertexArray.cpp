@@ -1,4 +1,5 @@
 #include "GLVertexArray.h"
+#include "GLStateCache.h"
 
 #include <glad/glad.h>
 
@@ -8,27 +9,28 @@ namespace ignis
 	GLVertexArray::GLVertexArray()
 	{
 		glGenVertexArrays(1, &m_id);
-		glBindVertexArray(m_id);
+		GLStateCache::BindVertexArray(m_id);
 	}
 
 	GLVertexArray::~GLVertexArray()
 	{
+		GLStateCache::OnVertexArrayDeleted(m_id);
 		glDeleteVertexArrays(1, &m_id);
 	}
 
 	void GLVertexArray::Bind()
 	{
-		glBindVertexArray(m_id);
+		GLStateCache::BindVertexArray(m_id);
 	}
 
 	void GLVertexArray::UnBind()
 	{
-		glBindVertexArray(0);
+		GLStateCache::BindVertexArray(0);
 	}
 
 	void GLVertexArray::AddVertexBuffer(const std::shared_ptr<VertexBuffer>& vertex_buffer)
 	{
-		glBindVertexArray(m_id);
+		GLStateCache::BindVertexArray(m_id);
 		vertex_buffer->Bind();
 		
 		const auto& layout = vertex_buffer->GetLayout();
@@ -50,6 +52,25 @@ namespace ignis
 					layout.GetStride(),
 					(const void*)attrib.Offset);
 				break;
+			case Shader::DataType::Short2:
+			case Shader::DataType::Short4:
+				glEnableVertexAttribArray(attrib.Index);
+				glVertexAttribPointer(attrib.Index,
+					count,
+					GL_SHORT,
+					attrib.Normalized ? GL_TRUE : GL_FALSE,
+					layout.GetStride(),
+					(const void*)attrib.Offset);
+				break;
+			case Shader::DataType::Half2:
+				glEnableVertexAttribArray(attrib.Index);
+				glVertexAttribPointer(attrib.Index,
+					count,
+					GL_HALF_FLOAT,
+					GL_FALSE,
+					layout.GetStride(),
+					(const void*)attrib.Offset);
+				break;
 			case Shader::DataType::Int:
 			case Shader::DataType::Int2:
 			case Shader::DataType::Int3:
@@ -85,16 +106,18 @@ namespace ignis
 				break;
 			case Shader::DataType::Mat3:
 			case Shader::DataType::Mat4:
+				// Matrices are per-instance data, one location per column
 				for (uint32_t i = 0; i < count; i++)
 				{
-					glEnableVertexAttribArray(attrib.Index);
-					glVertexAttribPointer(attrib.Index,
+					const uint32_t location = attrib.Index + i;
+					glEnableVertexAttribArray(location);
+					glVertexAttribPointer(location,
 						count,
 						GL_FLOAT,
 						attrib.Normalized ? GL_TRUE : GL_FALSE,
 						layout.GetStride(),
 						(const void*)(attrib.Offset + sizeof(float) * count * i));
-					glVertexAttribDivisor(attrib.Index, 1);
+					glVertexAttribDivisor(location, 1);
 				}
 				break;
 			}
@@ -105,7 +128,7 @@ namespace ignis
 
 	void GLVertexArray::SetIndexBuffer(const std::shared_ptr<IndexBuffer>& index_buffer)
 	{
-		glBindVertexArray(m_id);
+		GLStateCache::BindVertexArray(m_id);
 		index_buffer->Bind();
 		m_index_buffer = index_buffer;
 	}
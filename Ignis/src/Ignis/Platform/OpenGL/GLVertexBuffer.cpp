@@ -5,6 +5,7 @@
 namespace ignis
 {
 	GLVertexBuffer::GLVertexBuffer(size_t size, Usage usage)
+		: m_size(size), m_usage(usage)
 	{
 		glGenBuffers(1, &m_id);
 		glBindBuffer(GL_ARRAY_BUFFER, m_id);
@@ -12,6 +13,7 @@ namespace ignis
 	}
 
 	GLVertexBuffer::GLVertexBuffer(const void* vertices, size_t size, Usage usage)
+		: m_size(size), m_usage(usage)
 	{
 		glGenBuffers(1, &m_id);
 		glBindBuffer(GL_ARRAY_BUFFER, m_id);
@@ -36,6 +38,9 @@ namespace ignis
 	void GLVertexBuffer::SetData(const void* data, size_t size)
 	{
 		glBindBuffer(GL_ARRAY_BUFFER, m_id);
+		// Dynamic buffers are rewritten every frame, orphan the old storage instead of waiting on draws still reading it
+		if (m_usage == Usage::Dynamic)
+			glBufferData(GL_ARRAY_BUFFER, m_size, nullptr, GL_DYNAMIC_DRAW);
 		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
 	}
 }
\ No newline at end of file
@@ -18,7 +18,11 @@ namespace ignis
 
 		void SetData(const void* data, size_t size) override;
 
+		uint32_t GetID() const { return m_id; }
+
 	private:
 		uint32_t m_id = 0;
+		size_t m_size = 0;
+		Usage m_usage = Usage::Static;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace ignis
+{
+	struct AABB
+	{
+		// Starts inverted so the first Expand sets both corners
+		glm::vec3 Min{ FLT_MAX };
+		glm::vec3 Max{ -FLT_MAX };
+
+		bool IsValid() const { return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z; }
+
+		glm::vec3 GetCenter() const { return (Min + Max) * 0.5f; }
+		glm::vec3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+		void Expand(const glm::vec3& point)
+		{
+			Min = glm::min(Min, point);
+			Max = glm::max(Max, point);
+		}
+
+		void Expand(const AABB& other)
+		{
+			Min = glm::min(Min, other.Min);
+			Max = glm::max(Max, other.Max);
+		}
+
+		// Box enclosing this one after transform, exact for the eight corners
+		AABB Transform(const glm::mat4& transform) const
+		{
+			const glm::vec3 center = glm::vec3(transform * glm::vec4(GetCenter(), 1.0f));
+			const glm::vec3 extents = GetExtents();
+			const glm::mat3 abs_basis = glm::mat3(glm::abs(transform[0]), glm::abs(transform[1]), glm::abs(transform[2]));
+			const glm::vec3 world_extents = abs_basis * extents;
+
+			AABB result;
+			result.Min = center - world_extents;
+			result.Max = center + world_extents;
+			return result;
+		}
+	};
+
+	struct BoundingSphere
+	{
+		glm::vec3 Center{ 0.0f };
+		float Radius = 0.0f;
+
+		// Conservative under non-uniform scale, radius grows with the largest axis
+		BoundingSphere Transform(const glm::mat4& transform) const
+		{
+			const float scale_sq = std::max({
+				glm::dot(glm::vec3(transform[0]), glm::vec3(transform[0])),
+				glm::dot(glm::vec3(transform[1]), glm::vec3(transform[1])),
+				glm::dot(glm::vec3(transform[2]), glm::vec3(transform[2])) });
+
+			BoundingSphere result;
+			result.Center = glm::vec3(transform * glm::vec4(Center, 1.0f));
+			result.Radius = Radius * std::sqrt(scale_sq);
+			return result;
+		}
+	};
+}
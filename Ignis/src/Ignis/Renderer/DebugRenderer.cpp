@@ -7,6 +7,8 @@
 
 namespace ignis
 {
+	static UniformHandle s_view_projection_uniform("u_ViewProjection");
+
 	DebugRenderer::DebugRenderer(Renderer& renderer)
 		: m_renderer(renderer)
 	{
@@ -18,9 +20,9 @@ namespace ignis
 		m_renderer.GetShaderLibrary().Load("resources://shaders/DebugLine.glsl", "DebugLine");
 		m_line_shader = m_renderer.GetShaderLibrary().Get("DebugLine");
 
-		// Dynamic VBO updated every Flush()
+		// Streamed every Flush(), a batch per flush is appended to the ring
 		m_line_vbo = VertexBuffer::Create(kMaxLineVertices * sizeof(LineVertex),
-			VertexBuffer::Usage::Dynamic);
+			VertexBuffer::Usage::Stream);
 		m_line_vbo->SetLayout({
 			{ 0, Shader::DataType::Float3 },   // a_Position
 			{ 1, Shader::DataType::Float4 }    // a_Color
@@ -46,17 +48,17 @@ namespace ignis
 		if (m_vertices.empty() || !m_camera || !m_line_shader)
 			return;
 
-		m_line_vbo->SetData(m_vertices.data(),
+		const uint32_t first_vertex = m_line_vbo->Append(m_vertices.data(),
 			static_cast<uint32_t>(m_vertices.size() * sizeof(LineVertex)));
 
 		const glm::mat4 view_proj = m_camera->GetProjection() * m_camera->GetView();
 
 		auto mat = Material::Create(m_line_shader);
-		mat->Set("u_ViewProjection", view_proj);
+		mat->Set(s_view_projection_uniform, view_proj);
 		mat->Bind();
 
 		m_renderer.SetRenderState(RenderState::Overlay());
-		m_renderer.DrawLines(*m_line_vao, static_cast<uint32_t>(m_vertices.size()));
+		m_renderer.DrawLines(*m_line_vao, static_cast<uint32_t>(m_vertices.size()), first_vertex);
 		m_renderer.ResetRenderState();
 
 		m_vertices.clear();
@@ -0,0 +1,212 @@
+#include "Font.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ignis
+{
+	// Filled by the worker, drained by Font::Update. Shared so a job can finish after its font is gone.
+	struct Font::PageResults
+	{
+		std::mutex                   Mutex;
+		std::vector<GlyphRangeBitmap> Finished;
+		std::atomic<bool>            HasFinished = false;
+	};
+
+	namespace
+	{
+		// One background thread rasterizing glyph pages for every font, pages are rare
+		// enough that they never need more than that
+		class GlyphPageWorker
+		{
+		public:
+			static GlyphPageWorker& Get()
+			{
+				static GlyphPageWorker worker;
+				return worker;
+			}
+
+			void Enqueue(std::function<void()> job)
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_jobs.push_back(std::move(job));
+				}
+				m_condition.notify_one();
+			}
+
+		private:
+			GlyphPageWorker()
+				: m_thread([this]() { Run(); })
+			{
+			}
+
+			~GlyphPageWorker()
+			{
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_stop = true;
+				}
+				m_condition.notify_one();
+				m_thread.join();
+			}
+
+			void Run()
+			{
+				while (true)
+				{
+					std::function<void()> job;
+					{
+						std::unique_lock<std::mutex> lock(m_mutex);
+						m_condition.wait(lock, [this]() { return m_stop || !m_jobs.empty(); });
+						if (m_stop)
+							return;
+						job = std::move(m_jobs.front());
+						m_jobs.pop_front();
+					}
+					job();
+				}
+			}
+
+			std::mutex m_mutex;
+			std::condition_variable m_condition;
+			std::deque<std::function<void()>> m_jobs;
+			bool m_stop = false;
+			std::thread m_thread;
+		};
+	}
+
+	void Font::SetRasterizer(std::shared_ptr<GlyphRasterizer> rasterizer)
+	{
+		m_rasterizer = std::move(rasterizer);
+		m_page_results = std::make_shared<PageResults>();
+	}
+
+	const GlyphMetrics* Font::GetGlyph(uint32_t codepoint) const
+	{
+		if (codepoint < ASCIIGlyphCount)
+			return m_glyph_loaded[codepoint] ? &m_glyphs[codepoint] : nullptr;
+
+		const uint32_t page_index = codepoint / GlyphsPerPage;
+		auto it = m_unicode_pages.find(page_index);
+		if (it != m_unicode_pages.end())
+		{
+			const uint32_t slot = codepoint % GlyphsPerPage;
+			return it->second.Loaded[slot] ? &it->second.Glyphs[slot] : nullptr;
+		}
+
+		// Unknown page, reserve it so it is only requested once
+		m_unicode_pages.emplace(page_index, GlyphPage{});
+		if (!m_rasterizer || !m_page_results)
+			return nullptr;
+
+		// The first page starts after ASCII, which was packed at import
+		const uint32_t first = std::max(page_index * GlyphsPerPage, ASCIIGlyphCount);
+		const uint32_t count = (page_index + 1) * GlyphsPerPage - first;
+		GlyphPageWorker::Get().Enqueue([rasterizer = m_rasterizer, results = m_page_results, first, count]()
+			{
+				GlyphRangeBitmap range = rasterizer->Rasterize(first, count);
+
+				std::lock_guard<std::mutex> lock(results->Mutex);
+				results->Finished.push_back(std::move(range));
+				results->HasFinished.store(true, std::memory_order_release);
+			});
+		return nullptr;
+	}
+
+	bool Font::Update() const
+	{
+		if (!m_page_results || !m_page_results->HasFinished.load(std::memory_order_acquire))
+			return false;
+
+		std::vector<GlyphRangeBitmap> finished;
+		{
+			std::lock_guard<std::mutex> lock(m_page_results->Mutex);
+			finished.swap(m_page_results->Finished);
+			m_page_results->HasFinished.store(false, std::memory_order_relaxed);
+		}
+
+		TextureSpecs specs;
+		specs.Format = TextureFormat::R8;
+		specs.WrapS = TextureWrap::ClampToEdge;
+		specs.WrapT = TextureWrap::ClampToEdge;
+		specs.MinFilter = TextureFilter::Linear;
+		specs.MagFilter = TextureFilter::Linear;
+		specs.GenMipmaps = false;
+
+		bool added = false;
+		for (const GlyphRangeBitmap& range : finished)
+		{
+			// Blocks the font has no glyphs for stay reserved but empty
+			if (range.Pages.empty())
+				continue;
+
+			specs.Width = range.Width;
+			specs.Height = range.Height;
+			std::vector<std::shared_ptr<Texture2D>> textures;
+			for (const auto& pixels : range.Pages)
+			{
+				auto texture = Texture2D::Create(specs, ImageFormat::R8, pixels);
+				if (!texture)
+					break;
+				textures.push_back(std::move(texture));
+			}
+			if (textures.size() != range.Pages.size())
+				continue;
+
+			// A block that overflowed one atlas spans several pages, glyphs index them from first_page
+			const uint32_t first_page = static_cast<uint32_t>(m_atlas_pages.size());
+			m_atlas_pages.insert(m_atlas_pages.end(), textures.begin(), textures.end());
+
+			GlyphPage& page = m_unicode_pages[range.FirstCodepoint / GlyphsPerPage];
+			for (size_t i = 0; i < range.Glyphs.size(); i++)
+			{
+				const uint32_t slot = (range.FirstCodepoint + static_cast<uint32_t>(i)) % GlyphsPerPage;
+				page.Glyphs[slot] = range.Glyphs[i];
+				page.Glyphs[slot].Page = first_page + range.Glyphs[i].Page;
+				page.Loaded[slot] = range.Loaded[i] != 0;
+			}
+			added = true;
+		}
+
+		if (added)
+			m_glyph_version++;
+		return added;
+	}
+
+	uint32_t Font::NextCodepoint(std::string_view text, size_t& offset)
+	{
+		constexpr uint32_t replacement = 0xFFFD;
+
+		const auto lead = static_cast<unsigned char>(text[offset++]);
+		if (lead < 0x80)
+			return lead;
+
+		uint32_t length;
+		uint32_t codepoint;
+		if ((lead & 0xE0) == 0xC0)      { length = 1; codepoint = lead & 0x1F; }
+		else if ((lead & 0xF0) == 0xE0) { length = 2; codepoint = lead & 0x0F; }
+		else if ((lead & 0xF8) == 0xF0) { length = 3; codepoint = lead & 0x07; }
+		else return replacement;
+
+		for (uint32_t i = 0; i < length; i++)
+		{
+			if (offset >= text.size())
+				return replacement;
+
+			const auto next = static_cast<unsigned char>(text[offset]);
+			if ((next & 0xC0) != 0x80)
+				return replacement;
+
+			codepoint = (codepoint << 6) | (next & 0x3F);
+			offset++;
+		}
+
+		return codepoint <= 0x10FFFF ? codepoint : replacement;
+	}
+}
@@ -2,41 +2,78 @@
 
 #include "Ignis/Asset/Asset.h"
 #include "Ignis/Renderer/Texture.h"
+#include "GlyphRasterizer.h"
 
 #include <glm/glm.hpp>
+#include <array>
+#include <string_view>
 #include <unordered_map>
 
 namespace ignis
 {
-	struct GlyphMetrics
-	{
-		glm::vec2 AtlasMin;
-		glm::vec2 AtlasMax;
-		glm::vec2 QuadMin;
-		glm::vec2 QuadMax;
-		float     Advance;
-	};
-
 	class Font : public Asset
 	{
 	public:
 		static AssetType GetStaticType() { return AssetType::Font; }
 		AssetType        GetAssetType() const override { return AssetType::Font; }
 
-		const std::shared_ptr<Texture2D>& GetAtlas()     const { return m_atlas; }
+		static constexpr uint32_t ASCIIGlyphCount = 128;
+		// Codepoints past ASCII are rasterized a block at a time, each block into as many atlas
+		// pages as its glyphs need
+		static constexpr uint32_t GlyphsPerPage = 256;
+
+		// The ASCII page, always present
+		const std::shared_ptr<Texture2D>& GetAtlas()     const { return m_atlas_pages.front(); }
+		const std::shared_ptr<Texture2D>& GetAtlasPage(uint32_t page) const { return m_atlas_pages[page]; }
+		uint32_t                          GetAtlasPageCount() const { return static_cast<uint32_t>(m_atlas_pages.size()); }
 		float                             GetLineHeight() const { return m_line_height; }
 
+		// Distance field pages are thresholded in the text shader and stay sharp at any size
+		bool IsDistanceField() const { return m_distance_field; }
+		// Bumped when pages are added, layouts built earlier may have skipped their glyphs
+		uint32_t GetGlyphVersion() const { return m_glyph_version; }
+
+		// Flat table lookup, text layout calls this once per character
 		const GlyphMetrics* GetGlyph(char c) const
 		{
-			auto it = m_glyphs.find(static_cast<uint32_t>(c));
-			return it != m_glyphs.end() ? &it->second : nullptr;
+			const auto index = static_cast<unsigned char>(c);
+			return index < ASCIIGlyphCount && m_glyph_loaded[index] ? &m_glyphs[index] : nullptr;
 		}
 
+		// Past ASCII the first lookup queues the codepoint's page on the font worker and returns
+		// null until Update has uploaded it. Render thread only, like Update.
+		const GlyphMetrics* GetGlyph(uint32_t codepoint) const;
+
+		// Uploads pages the worker has finished, returns true if any were added
+		bool Update() const;
+
+		// Decodes the UTF-8 sequence at offset and moves past it, malformed bytes decode as U+FFFD
+		static uint32_t NextCodepoint(std::string_view text, size_t& offset);
+
 	private:
-		std::shared_ptr<Texture2D>                 m_atlas;
-		std::unordered_map<uint32_t, GlyphMetrics> m_glyphs;
-		float                                      m_line_height = 0.0f;
+		struct GlyphPage
+		{
+			std::array<GlyphMetrics, GlyphsPerPage> Glyphs{};
+			std::array<bool, GlyphsPerPage>         Loaded{};
+		};
+
+		struct PageResults;
+
+		// Keeps the font file for pages rasterized after import
+		void SetRasterizer(std::shared_ptr<GlyphRasterizer> rasterizer);
+
+		mutable std::vector<std::shared_ptr<Texture2D>> m_atlas_pages;
+		std::array<GlyphMetrics, ASCIIGlyphCount>    m_glyphs{};
+		std::array<bool, ASCIIGlyphCount>            m_glyph_loaded{};
+		float                                        m_line_height = 0.0f;
+		bool                                         m_distance_field = false;
+
+		// Lazily filled pages, mutated from const lookups since they only cache what the font already holds
+		std::shared_ptr<GlyphRasterizer>                          m_rasterizer;
+		std::shared_ptr<PageResults>                              m_page_results;
+		mutable std::unordered_map<uint32_t, GlyphPage>           m_unicode_pages;   // by codepoint / GlyphsPerPage, present once requested
+		mutable uint32_t                                          m_glyph_version = 0;
 
 		friend class FontImporter;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,90 @@
+#include "FreeListAllocator.h"
+
+#include <algorithm>
+
+namespace ignis
+{
+	FreeListAllocator::FreeListAllocator(uint32_t capacity)
+	{
+		Reset(capacity, 0);
+	}
+
+	uint32_t FreeListAllocator::Allocate(uint32_t size)
+	{
+		if (size == 0)
+			return InvalidOffset;
+
+		for (auto it = m_free_ranges.begin(); it != m_free_ranges.end(); ++it)
+		{
+			if (it->second < size)
+				continue;
+
+			const uint32_t offset = it->first;
+			const uint32_t remaining = it->second - size;
+			m_free_ranges.erase(it);
+			if (remaining > 0)
+				m_free_ranges.emplace(offset + size, remaining);
+
+			m_used += size;
+			return offset;
+		}
+		return InvalidOffset;
+	}
+
+	void FreeListAllocator::Free(uint32_t offset, uint32_t size)
+	{
+		if (size == 0)
+			return;
+
+		m_used -= size;
+
+		auto next = m_free_ranges.lower_bound(offset);
+		if (next != m_free_ranges.end() && offset + size == next->first)
+		{
+			size += next->second;
+			next = m_free_ranges.erase(next);
+		}
+
+		if (next != m_free_ranges.begin())
+		{
+			auto previous = std::prev(next);
+			if (previous->first + previous->second == offset)
+			{
+				previous->second += size;
+				return;
+			}
+		}
+
+		m_free_ranges.emplace(offset, size);
+	}
+
+	void FreeListAllocator::Grow(uint32_t new_capacity)
+	{
+		if (new_capacity <= m_capacity)
+			return;
+
+		const uint32_t old_capacity = m_capacity;
+		m_capacity = new_capacity;
+
+		// Free() does the merging, undo its bookkeeping since the tail was never used
+		m_used += new_capacity - old_capacity;
+		Free(old_capacity, new_capacity - old_capacity);
+	}
+
+	void FreeListAllocator::Reset(uint32_t capacity, uint32_t used)
+	{
+		m_free_ranges.clear();
+		m_capacity = capacity;
+		m_used = std::min(used, capacity);
+		if (m_used < m_capacity)
+			m_free_ranges.emplace(m_used, m_capacity - m_used);
+	}
+
+	uint32_t FreeListAllocator::GetLargestFreeRange() const
+	{
+		uint32_t largest = 0;
+		for (const auto& [offset, size] : m_free_ranges)
+			largest = std::max(largest, size);
+		return largest;
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+
+namespace ignis
+{
+	// First-fit range allocator over an abstract [0, capacity) space. Freed
+	// ranges merge with their neighbours, it never touches memory itself.
+	class FreeListAllocator
+	{
+	public:
+		static constexpr uint32_t InvalidOffset = 0xffffffffu;
+
+		explicit FreeListAllocator(uint32_t capacity = 0);
+
+		// InvalidOffset when no single free range is large enough
+		uint32_t Allocate(uint32_t size);
+		void Free(uint32_t offset, uint32_t size);
+
+		// Extends the space, the new tail joins the last free range if they touch
+		void Grow(uint32_t new_capacity);
+		// Everything below used is allocated and the rest is one free range, e.g. after compaction
+		void Reset(uint32_t capacity, uint32_t used);
+
+		uint32_t GetCapacity() const { return m_capacity; }
+		uint32_t GetUsed() const { return m_used; }
+		uint32_t GetFree() const { return m_capacity - m_used; }
+		uint32_t GetFreeRangeCount() const { return static_cast<uint32_t>(m_free_ranges.size()); }
+		uint32_t GetLargestFreeRange() const;
+
+	private:
+		// offset -> size
+		std::map<uint32_t, uint32_t> m_free_ranges;
+		uint32_t m_capacity = 0;
+		uint32_t m_used = 0;
+	};
+}
@@ -0,0 +1,132 @@
+#include "Frustum.h"
+
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#include <xmmintrin.h>
+	#define IGNIS_FRUSTUM_SSE 1
+#elif defined(__ARM_NEON)
+	#include <arm_neon.h>
+	#define IGNIS_FRUSTUM_NEON 1
+#endif
+
+namespace ignis
+{
+	Frustum::Frustum(const glm::mat4& view_projection)
+	{
+		// Gribb/Hartmann extraction, glm is column major so rows are read across columns
+		const glm::vec4 row0(view_projection[0][0], view_projection[1][0], view_projection[2][0], view_projection[3][0]);
+		const glm::vec4 row1(view_projection[0][1], view_projection[1][1], view_projection[2][1], view_projection[3][1]);
+		const glm::vec4 row2(view_projection[0][2], view_projection[1][2], view_projection[2][2], view_projection[3][2]);
+		const glm::vec4 row3(view_projection[0][3], view_projection[1][3], view_projection[2][3], view_projection[3][3]);
+
+		const glm::vec4 planes[6] =
+		{
+			row3 + row0, // Left
+			row3 - row0, // Right
+			row3 + row1, // Bottom
+			row3 - row1, // Top
+			row3 + row2, // Near
+			row3 - row2, // Far
+		};
+
+		for (int i = 0; i < 6; i++)
+		{
+			const float length = glm::length(glm::vec3(planes[i]));
+			const glm::vec4 plane = length > 0.0f ? planes[i] / length : planes[i];
+			m_x[i] = plane.x;
+			m_y[i] = plane.y;
+			m_z[i] = plane.z;
+			m_w[i] = plane.w;
+		}
+	}
+
+	bool Frustum::Intersects(const BoundingSphere& sphere) const
+	{
+		for (int i = 0; i < 6; i++)
+		{
+			const float distance = m_x[i] * sphere.Center.x + m_y[i] * sphere.Center.y + m_z[i] * sphere.Center.z + m_w[i];
+			if (distance < -sphere.Radius)
+				return false;
+		}
+		return true;
+	}
+
+	bool Frustum::Intersects(const AABB& box) const
+	{
+		const glm::vec3 center = box.GetCenter();
+		const glm::vec3 extents = box.GetExtents();
+
+		for (int i = 0; i < 6; i++)
+		{
+			const float distance = m_x[i] * center.x + m_y[i] * center.y + m_z[i] * center.z + m_w[i];
+			const float radius = std::abs(m_x[i]) * extents.x + std::abs(m_y[i]) * extents.y + std::abs(m_z[i]) * extents.z;
+			if (distance < -radius)
+				return false;
+		}
+		return true;
+	}
+
+	void Frustum::TestSpheres(const BoundingSphere* spheres, size_t count, uint8_t* out_visible) const
+	{
+		size_t i = 0;
+
+#if defined(IGNIS_FRUSTUM_SSE)
+		for (; i + 4 <= count; i += 4)
+		{
+			const BoundingSphere* s = spheres + i;
+			const __m128 cx = _mm_setr_ps(s[0].Center.x, s[1].Center.x, s[2].Center.x, s[3].Center.x);
+			const __m128 cy = _mm_setr_ps(s[0].Center.y, s[1].Center.y, s[2].Center.y, s[3].Center.y);
+			const __m128 cz = _mm_setr_ps(s[0].Center.z, s[1].Center.z, s[2].Center.z, s[3].Center.z);
+			const __m128 neg_r = _mm_setr_ps(-s[0].Radius, -s[1].Radius, -s[2].Radius, -s[3].Radius);
+
+			__m128 inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+			for (int p = 0; p < 6; p++)
+			{
+				__m128 d = _mm_mul_ps(cx, _mm_set1_ps(m_x[p]));
+				d = _mm_add_ps(d, _mm_mul_ps(cy, _mm_set1_ps(m_y[p])));
+				d = _mm_add_ps(d, _mm_mul_ps(cz, _mm_set1_ps(m_z[p])));
+				d = _mm_add_ps(d, _mm_set1_ps(m_w[p]));
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(d, neg_r));
+			}
+
+			const int mask = _mm_movemask_ps(inside);
+			out_visible[i + 0] = (mask >> 0) & 1;
+			out_visible[i + 1] = (mask >> 1) & 1;
+			out_visible[i + 2] = (mask >> 2) & 1;
+			out_visible[i + 3] = (mask >> 3) & 1;
+		}
+#elif defined(IGNIS_FRUSTUM_NEON)
+		for (; i + 4 <= count; i += 4)
+		{
+			const BoundingSphere* s = spheres + i;
+			const float cx_data[4] = { s[0].Center.x, s[1].Center.x, s[2].Center.x, s[3].Center.x };
+			const float cy_data[4] = { s[0].Center.y, s[1].Center.y, s[2].Center.y, s[3].Center.y };
+			const float cz_data[4] = { s[0].Center.z, s[1].Center.z, s[2].Center.z, s[3].Center.z };
+			const float r_data[4] = { -s[0].Radius, -s[1].Radius, -s[2].Radius, -s[3].Radius };
+			const float32x4_t cx = vld1q_f32(cx_data);
+			const float32x4_t cy = vld1q_f32(cy_data);
+			const float32x4_t cz = vld1q_f32(cz_data);
+			const float32x4_t neg_r = vld1q_f32(r_data);
+
+			uint32x4_t inside = vdupq_n_u32(0xFFFFFFFFu);
+			for (int p = 0; p < 6; p++)
+			{
+				float32x4_t d = vmulq_n_f32(cx, m_x[p]);
+				d = vmlaq_n_f32(d, cy, m_y[p]);
+				d = vmlaq_n_f32(d, cz, m_z[p]);
+				d = vaddq_f32(d, vdupq_n_f32(m_w[p]));
+				inside = vandq_u32(inside, vcgeq_f32(d, neg_r));
+			}
+
+			out_visible[i + 0] = vgetq_lane_u32(inside, 0) ? 1 : 0;
+			out_visible[i + 1] = vgetq_lane_u32(inside, 1) ? 1 : 0;
+			out_visible[i + 2] = vgetq_lane_u32(inside, 2) ? 1 : 0;
+			out_visible[i + 3] = vgetq_lane_u32(inside, 3) ? 1 : 0;
+		}
+#endif
+
+		for (; i < count; i++)
+			out_visible[i] = Intersects(spheres[i]) ? 1 : 0;
+	}
+}
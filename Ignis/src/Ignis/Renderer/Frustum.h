@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Bounds.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ignis
+{
+	class Frustum
+	{
+	public:
+		Frustum() = default;
+		explicit Frustum(const glm::mat4& view_projection);
+
+		bool Intersects(const BoundingSphere& sphere) const;
+		bool Intersects(const AABB& box) const;
+
+		// Tests four spheres per iteration against all planes, writes 1 for visible and 0 for culled
+		void TestSpheres(const BoundingSphere* spheres, size_t count, uint8_t* out_visible) const;
+
+	private:
+		// Normalized planes (x, y, z, w) with the inside where dot(n, p) + w >= 0.
+		// Kept as structure of arrays so the batched test can broadcast each component.
+		float m_x[6]{};
+		float m_y[6]{};
+		float m_z[6]{};
+		float m_w[6]{};
+	};
+}
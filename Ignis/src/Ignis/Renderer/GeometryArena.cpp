@@ -0,0 +1,137 @@
+#include "GeometryArena.h"
+#include "GraphicsAPI.h"
+#include "Mesh.h"
+#include "Ignis/Platform/OpenGL/GLGeometryArena.h"
+
+#include <algorithm>
+
+namespace ignis
+{
+	namespace
+	{
+		// Starting sizes, about 9 MB of vertices with the full mesh layout
+		constexpr uint32_t k_initial_vertex_capacity = 256 * 1024;
+		constexpr uint32_t k_initial_index_capacity = 4 * 1024 * 1024;
+
+		constexpr uint32_t k_index_alignment = 4;
+
+		uint32_t AlignIndexSize(uint32_t size)
+		{
+			return (size + k_index_alignment - 1) / k_index_alignment * k_index_alignment;
+		}
+
+		uint32_t GrowCapacity(const FreeListAllocator& allocator, uint32_t size, uint32_t initial_capacity)
+		{
+			const uint32_t required = allocator.GetUsed() + size;
+			if (required <= allocator.GetCapacity())
+				return allocator.GetCapacity();
+			return std::max({ required, allocator.GetCapacity() * 2, initial_capacity });
+		}
+	}
+
+	GeometryArena::GeometryArena(const VertexBuffer::Layout& layout)
+		: m_layout(layout)
+	{
+	}
+
+	std::shared_ptr<GeometryAllocation> GeometryArena::Allocate(const void* vertices, uint32_t vertex_count, const void* indices, uint32_t index_size)
+	{
+		const uint32_t aligned_index_size = AlignIndexSize(index_size);
+
+		uint32_t vertex_offset = m_vertex_allocator.Allocate(vertex_count);
+		uint32_t index_offset = m_index_allocator.Allocate(aligned_index_size);
+
+		if (vertex_offset == FreeListAllocator::InvalidOffset || index_offset == FreeListAllocator::InvalidOffset)
+		{
+			if (vertex_offset != FreeListAllocator::InvalidOffset)
+				m_vertex_allocator.Free(vertex_offset, vertex_count);
+			if (index_offset != FreeListAllocator::InvalidOffset)
+				m_index_allocator.Free(index_offset, aligned_index_size);
+
+			// Compacting leaves all free space in one range, grow only when the total is short too
+			Compact(GrowCapacity(m_vertex_allocator, vertex_count, k_initial_vertex_capacity),
+				GrowCapacity(m_index_allocator, aligned_index_size, k_initial_index_capacity));
+
+			vertex_offset = m_vertex_allocator.Allocate(vertex_count);
+			index_offset = m_index_allocator.Allocate(aligned_index_size);
+		}
+
+		const uint32_t stride = static_cast<uint32_t>(m_layout.GetStride());
+		Upload(vertex_offset * stride, vertices, vertex_count * stride, index_offset, indices, index_size);
+
+		auto* allocation = new GeometryAllocation{ vertex_offset, vertex_count, index_offset, aligned_index_size };
+		m_allocations.insert(allocation);
+
+		std::weak_ptr<GeometryArena> weak_arena = weak_from_this();
+		return std::shared_ptr<GeometryAllocation>(allocation, [weak_arena](GeometryAllocation* allocation)
+		{
+			if (auto arena = weak_arena.lock())
+				arena->Free(*allocation);
+			delete allocation;
+		});
+	}
+
+	void GeometryArena::Defragment()
+	{
+		if (m_vertex_allocator.GetFreeRangeCount() <= 1 && m_index_allocator.GetFreeRangeCount() <= 1)
+			return;
+		Compact(m_vertex_allocator.GetCapacity(), m_index_allocator.GetCapacity());
+	}
+
+	void GeometryArena::Free(const GeometryAllocation& allocation)
+	{
+		m_vertex_allocator.Free(allocation.BaseVertex, allocation.VertexCount);
+		m_index_allocator.Free(allocation.IndexOffset, allocation.IndexSize);
+		m_allocations.erase(const_cast<GeometryAllocation*>(&allocation));
+	}
+
+	void GeometryArena::Compact(uint32_t vertex_capacity, uint32_t index_capacity)
+	{
+		// Keep the existing order so neighbouring meshes stay neighbours
+		std::vector<GeometryAllocation*> allocations(m_allocations.begin(), m_allocations.end());
+		std::sort(allocations.begin(), allocations.end(),
+			[](const GeometryAllocation* a, const GeometryAllocation* b) { return a->BaseVertex < b->BaseVertex; });
+
+		const uint32_t stride = static_cast<uint32_t>(m_layout.GetStride());
+		std::vector<Move> vertex_moves;
+		std::vector<Move> index_moves;
+		vertex_moves.reserve(allocations.size());
+		index_moves.reserve(allocations.size());
+
+		uint32_t vertex_cursor = 0;
+		uint32_t index_cursor = 0;
+		for (auto* allocation : allocations)
+		{
+			vertex_moves.push_back({ allocation->BaseVertex * stride, vertex_cursor * stride, allocation->VertexCount * stride });
+			index_moves.push_back({ allocation->IndexOffset, index_cursor, allocation->IndexSize });
+
+			allocation->BaseVertex = vertex_cursor;
+			allocation->IndexOffset = index_cursor;
+			vertex_cursor += allocation->VertexCount;
+			index_cursor += allocation->IndexSize;
+		}
+
+		Rebuild(vertex_capacity, index_capacity, vertex_moves, index_moves);
+
+		m_vertex_allocator.Reset(vertex_capacity, vertex_cursor);
+		m_index_allocator.Reset(index_capacity, index_cursor);
+	}
+
+	std::shared_ptr<GeometryArena> GeometryArena::Get()
+	{
+		// Every UV set is kept so meshes with different sets can share the layout
+		static std::shared_ptr<GeometryArena> s_arena = Create(Mesh::GetPackedLayout(Mesh::AllUVSets));
+		return s_arena;
+	}
+
+	std::shared_ptr<GeometryArena> GeometryArena::Create(const VertexBuffer::Layout& layout)
+	{
+		switch (GraphicsAPI::GetType())
+		{
+		case GraphicsAPI::Type::OpenGL:
+			return std::make_shared<GLGeometryArena>(layout);
+		default:
+			return nullptr;
+		}
+	}
+}
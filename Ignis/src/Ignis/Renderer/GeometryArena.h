@@ -0,0 +1,76 @@
+#pragma once
+
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "FreeListAllocator.h"
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace ignis
+{
+	// A mesh's ranges inside the arena. Defragment moves the ranges and updates
+	// the record in place, so read it at draw time instead of caching it.
+	struct GeometryAllocation
+	{
+		uint32_t BaseVertex = 0;
+		uint32_t VertexCount = 0;
+		// Bytes into the shared index buffer, 4 byte aligned
+		uint32_t IndexOffset = 0;
+		uint32_t IndexSize = 0;
+	};
+
+	// One vertex buffer and one index buffer that meshes are suballocated from, so
+	// draws of different meshes share a vertex array and can be merged.
+	class GeometryArena : public std::enable_shared_from_this<GeometryArena>
+	{
+	public:
+		// Byte ranges moved by a rebuild, from the old buffer to the new one
+		struct Move
+		{
+			uint32_t Source;
+			uint32_t Destination;
+			uint32_t Size;
+		};
+
+		explicit GeometryArena(const VertexBuffer::Layout& layout);
+		virtual ~GeometryArena() = default;
+
+		// vertices must be in GetLayout(). The range is freed when the returned
+		// pointer is released, compacting or growing the buffers if nothing fits.
+		std::shared_ptr<GeometryAllocation> Allocate(const void* vertices, uint32_t vertex_count, const void* indices, uint32_t index_size);
+
+		// Compacts live ranges to the front of new buffers, closing the free list holes
+		void Defragment();
+
+		virtual std::shared_ptr<VertexArray> GetVertexArray() const = 0;
+
+		const VertexBuffer::Layout& GetLayout() const { return m_layout; }
+		uint32_t GetAllocationCount() const { return static_cast<uint32_t>(m_allocations.size()); }
+		const FreeListAllocator& GetVertexAllocator() const { return m_vertex_allocator; }
+		const FreeListAllocator& GetIndexAllocator() const { return m_index_allocator; }
+
+		// Shared arena for meshes imported with UseGeometryArena, created on first use
+		static std::shared_ptr<GeometryArena> Get();
+
+	protected:
+		// Replaces the buffers with ones of the given capacities, keeping the moved ranges
+		virtual void Rebuild(uint32_t vertex_capacity, uint32_t index_capacity,
+			const std::vector<Move>& vertex_moves, const std::vector<Move>& index_moves) = 0;
+		virtual void Upload(uint32_t vertex_offset, const void* vertices, uint32_t vertex_size,
+			uint32_t index_offset, const void* indices, uint32_t index_size) = 0;
+
+	private:
+		void Free(const GeometryAllocation& allocation);
+		void Compact(uint32_t vertex_capacity, uint32_t index_capacity);
+
+		static std::shared_ptr<GeometryArena> Create(const VertexBuffer::Layout& layout);
+
+	private:
+		VertexBuffer::Layout m_layout;
+		FreeListAllocator m_vertex_allocator;
+		FreeListAllocator m_index_allocator;
+		std::unordered_set<GeometryAllocation*> m_allocations;
+	};
+}
@@ -0,0 +1,218 @@
+#include "GlyphRasterizer.h"
+
+#include <stb_truetype.h>
+#include <algorithm>
+
+namespace ignis
+{
+	namespace
+	{
+		// Distance field texels on each side of the outline, also the range the field encodes
+		constexpr int k_sdf_padding = 6;
+		constexpr unsigned char k_sdf_on_edge = 128;
+		constexpr float k_sdf_pixel_distance_scale = static_cast<float>(k_sdf_on_edge) / k_sdf_padding;
+		// Keeps linear filtering from bleeding between neighbouring distance fields
+		constexpr uint32_t k_sdf_spacing = 1;
+	}
+
+	std::shared_ptr<GlyphRasterizer> GlyphRasterizer::Create(std::vector<uint8_t> ttf, const FontImportOptions& options)
+	{
+		std::shared_ptr<GlyphRasterizer> rasterizer(new GlyphRasterizer());
+		rasterizer->m_ttf = std::move(ttf);
+		rasterizer->m_info = std::make_unique<stbtt_fontinfo>();
+		rasterizer->m_options = options;
+
+		const unsigned char* data = rasterizer->m_ttf.data();
+		if (rasterizer->m_ttf.empty() || !stbtt_InitFont(rasterizer->m_info.get(), data, stbtt_GetFontOffsetForIndex(data, 0)))
+			return nullptr;
+
+		rasterizer->m_scale = stbtt_ScaleForPixelHeight(rasterizer->m_info.get(), options.FontSize);
+		int asc, desc, gap;
+		stbtt_GetFontVMetrics(rasterizer->m_info.get(), &asc, &desc, &gap);
+		rasterizer->m_line_height = (asc - desc + gap) * rasterizer->m_scale;
+		return rasterizer;
+	}
+
+	GlyphRasterizer::~GlyphRasterizer() = default;
+
+	GlyphRangeBitmap GlyphRasterizer::Rasterize(uint32_t first_codepoint, uint32_t count) const
+	{
+		GlyphRangeBitmap range;
+		range.FirstCodepoint = first_codepoint;
+		range.Glyphs.resize(count);
+		range.Loaded.resize(count, 0);
+
+		// ASCII is always kept so missing glyphs still draw the font's notdef box, as before
+		bool any_glyph = false;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const uint32_t codepoint = first_codepoint + i;
+			range.Loaded[i] = codepoint < 128 || stbtt_FindGlyphIndex(m_info.get(), static_cast<int>(codepoint)) != 0;
+			any_glyph |= range.Loaded[i] != 0;
+		}
+		if (!any_glyph)
+			return range;
+
+		range.Width = m_options.AtlasWidth;
+		range.Height = m_options.AtlasHeight;
+
+		if (m_options.DistanceField)
+			RasterizeDistanceField(range, count);
+		else
+			RasterizeCoverage(range, count);
+		return range;
+	}
+
+	void GlyphRasterizer::RasterizeCoverage(GlyphRangeBitmap& range, uint32_t count) const
+	{
+		// Glyphs still to place and their index in the range, each page packs what it can and
+		// hands the rest to the next
+		std::vector<int> codepoints;
+		std::vector<uint32_t> indices;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (range.Loaded[i])
+			{
+				codepoints.push_back(static_cast<int>(range.FirstCodepoint + i));
+				indices.push_back(i);
+			}
+		}
+
+		const float inv_w = 1.0f / static_cast<float>(range.Width);
+		const float inv_h = 1.0f / static_cast<float>(range.Height);
+		std::vector<stbtt_packedchar> packed;
+		while (!codepoints.empty())
+		{
+			auto& pixels = range.Pages.emplace_back(static_cast<size_t>(range.Width) * range.Height, std::byte{ 0 });
+
+			stbtt_pack_context ctx;
+			if (!stbtt_PackBegin(&ctx, reinterpret_cast<unsigned char*>(pixels.data()),
+				static_cast<int>(range.Width), static_cast<int>(range.Height), 0, 1, nullptr))
+			{
+				range.Pages.pop_back();
+				break;
+			}
+			stbtt_PackSetOversampling(&ctx, 2, 2);
+
+			// stbtt only reports whether everything fit and leaves the rest untouched. Advances
+			// are never negative, so one still at -1 marks a glyph that did not fit.
+			stbtt_packedchar unplaced{};
+			unplaced.xadvance = -1.0f;
+			packed.assign(codepoints.size(), unplaced);
+
+			stbtt_pack_range pack_range{};
+			pack_range.font_size = m_options.FontSize;
+			pack_range.array_of_unicode_codepoints = codepoints.data();
+			pack_range.num_chars = static_cast<int>(codepoints.size());
+			pack_range.chardata_for_range = packed.data();
+			stbtt_PackFontRanges(&ctx, m_ttf.data(), 0, &pack_range, 1);
+			stbtt_PackEnd(&ctx);
+
+			const uint32_t page = static_cast<uint32_t>(range.Pages.size() - 1);
+			size_t remaining = 0;
+			for (size_t k = 0; k < codepoints.size(); k++)
+			{
+				const stbtt_packedchar& p = packed[k];
+				if (p.xadvance < 0.0f)
+				{
+					codepoints[remaining] = codepoints[k];
+					indices[remaining] = indices[k];
+					remaining++;
+					continue;
+				}
+
+				GlyphMetrics& g = range.Glyphs[indices[k]];
+				g.AtlasMin = { p.x0 * inv_w, p.y0 * inv_h };
+				g.AtlasMax = { p.x1 * inv_w, p.y1 * inv_h };
+				g.QuadMin = { p.xoff,  p.yoff };
+				g.QuadMax = { p.xoff2, p.yoff2 };
+				g.Advance = p.xadvance;
+				g.Page = page;
+			}
+
+			// Nothing fit on an empty page, what is left is larger than a whole page
+			if (remaining == codepoints.size())
+			{
+				range.Pages.pop_back();
+				break;
+			}
+			codepoints.resize(remaining);
+			indices.resize(remaining);
+		}
+
+		for (uint32_t index : indices)
+			range.Loaded[index] = 0;
+	}
+
+	void GlyphRasterizer::RasterizeDistanceField(GlyphRangeBitmap& range, uint32_t count) const
+	{
+		const float inv_w = 1.0f / static_cast<float>(range.Width);
+		const float inv_h = 1.0f / static_cast<float>(range.Height);
+		const size_t page_size = static_cast<size_t>(range.Width) * range.Height;
+
+		// Shelf packing in codepoint order, glyphs of one size vary little in height.
+		// A full page is closed and packing continues on a new one.
+		range.Pages.emplace_back(page_size, std::byte{ 0 });
+		uint32_t shelf_x = 0;
+		uint32_t shelf_y = 0;
+		uint32_t shelf_height = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (!range.Loaded[i])
+				continue;
+
+			const int codepoint = static_cast<int>(range.FirstCodepoint + i);
+			int advance, left_bearing;
+			stbtt_GetCodepointHMetrics(m_info.get(), codepoint, &advance, &left_bearing);
+
+			GlyphMetrics& g = range.Glyphs[i];
+			g = {};
+			g.Advance = advance * m_scale;
+
+			int w = 0, h = 0, xoff = 0, yoff = 0;
+			unsigned char* sdf = stbtt_GetCodepointSDF(m_info.get(), m_scale, codepoint,
+				k_sdf_padding, k_sdf_on_edge, k_sdf_pixel_distance_scale, &w, &h, &xoff, &yoff);
+			if (!sdf)
+				continue;   // No outline, e.g. a space
+
+			if (w + k_sdf_spacing > range.Width || h + k_sdf_spacing > range.Height)
+			{
+				// Would not fit even on an empty page
+				stbtt_FreeSDF(sdf, nullptr);
+				range.Loaded[i] = 0;
+				continue;
+			}
+
+			if (shelf_x + w + k_sdf_spacing > range.Width)
+			{
+				shelf_x = 0;
+				shelf_y += shelf_height;
+				shelf_height = 0;
+			}
+			if (shelf_y + h + k_sdf_spacing > range.Height)
+			{
+				range.Pages.emplace_back(page_size, std::byte{ 0 });
+				shelf_x = 0;
+				shelf_y = 0;
+				shelf_height = 0;
+			}
+
+			std::vector<std::byte>& pixels = range.Pages.back();
+			for (int y = 0; y < h; y++)
+			{
+				std::copy_n(reinterpret_cast<const std::byte*>(sdf + y * w), w,
+					pixels.data() + static_cast<size_t>(shelf_y + y) * range.Width + shelf_x);
+			}
+			stbtt_FreeSDF(sdf, nullptr);
+
+			g.AtlasMin = { shelf_x * inv_w, shelf_y * inv_h };
+			g.AtlasMax = { (shelf_x + w) * inv_w, (shelf_y + h) * inv_h };
+			g.QuadMin = { static_cast<float>(xoff), static_cast<float>(yoff) };
+			g.QuadMax = { static_cast<float>(xoff + w), static_cast<float>(yoff + h) };
+			g.Page = static_cast<uint32_t>(range.Pages.size() - 1);
+
+			shelf_x += w + k_sdf_spacing;
+			shelf_height = std::max(shelf_height, static_cast<uint32_t>(h) + k_sdf_spacing);
+		}
+	}
+}
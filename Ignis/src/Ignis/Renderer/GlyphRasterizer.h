@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Ignis/Asset/AssetImportOptions.h"
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct stbtt_fontinfo;
+
+namespace ignis
+{
+	struct GlyphMetrics
+	{
+		glm::vec2 AtlasMin;
+		glm::vec2 AtlasMax;
+		glm::vec2 QuadMin;
+		glm::vec2 QuadMax;
+		float     Advance;
+		uint32_t  Page = 0;   // atlas page the glyph was packed into
+	};
+
+	// A run of codepoints packed into as many Width x Height R8 atlas pages as it needs.
+	// Glyphs[i] is FirstCodepoint + i, its Page indexes Pages.
+	struct GlyphRangeBitmap
+	{
+		uint32_t                            FirstCodepoint = 0;
+		uint32_t                            Width = 0;
+		uint32_t                            Height = 0;
+		std::vector<std::vector<std::byte>> Pages;   // empty when the font has none of the codepoints
+		std::vector<GlyphMetrics>           Glyphs;
+		std::vector<uint8_t>                Loaded;
+	};
+
+	// Owns a TrueType file and rasterizes codepoint ranges into atlas pages, either
+	// as coverage bitmaps at the import size or as signed distance fields that
+	// scale to any size. Rasterize only reads the font, so worker threads can call it.
+	class GlyphRasterizer
+	{
+	public:
+		static std::shared_ptr<GlyphRasterizer> Create(std::vector<uint8_t> ttf, const FontImportOptions& options);
+		~GlyphRasterizer();
+
+		GlyphRangeBitmap Rasterize(uint32_t first_codepoint, uint32_t count) const;
+
+		float GetLineHeight() const { return m_line_height; }
+		bool IsDistanceField() const { return m_options.DistanceField; }
+
+	private:
+		GlyphRasterizer() = default;
+
+		void RasterizeCoverage(GlyphRangeBitmap& range, uint32_t count) const;
+		void RasterizeDistanceField(GlyphRangeBitmap& range, uint32_t count) const;
+
+		std::vector<uint8_t> m_ttf;
+		std::unique_ptr<stbtt_fontinfo> m_info;
+		FontImportOptions m_options;
+		float m_scale = 1.0f;
+		float m_line_height = 0.0f;
+	};
+}
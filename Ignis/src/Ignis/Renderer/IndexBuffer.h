@@ -1,9 +1,16 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 namespace ignis
 {
+	enum class IndexFormat : uint8_t
+	{
+		UInt16,
+		UInt32
+	};
+
 	class IndexBuffer
 	{
 	public:
@@ -12,8 +19,10 @@ namespace ignis
 		virtual void Bind() = 0;
 		virtual void Unbind() = 0;
 
+		// Assumes 32-bit indices, buffers mixing formats are drawn by explicit ranges
 		virtual unsigned int GetCount() const = 0;
 
-		static std::shared_ptr<IndexBuffer> Create(const uint32_t* indices, uint32_t size);
+		// size is in bytes, indices may be any mix of formats
+		static std::shared_ptr<IndexBuffer> Create(const void* indices, uint32_t size);
 	};
 }
\ No newline at end of file
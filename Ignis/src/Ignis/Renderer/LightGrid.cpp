@@ -0,0 +1,230 @@
+#include "LightGrid.h"
+#include "Camera.h"
+#include "Ignis/Scene/Scene.h"
+#include "Ignis/Core/JobSystem.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace ignis
+{
+	namespace
+	{
+		// Below this binning runs on the calling thread
+		constexpr size_t k_min_lights_for_jobs = 64;
+
+		constexpr float k_min_near = 0.01f;
+
+		uint32_t ToTile(float ndc, uint32_t tiles)
+		{
+			const float t = std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(tiles));
+			return static_cast<uint32_t>(std::clamp(t, 0.0f, static_cast<float>(tiles - 1)));
+		}
+	}
+
+	template<typename Fn>
+	void LightGrid::ForEachSliceRange(Fn&& fn)
+	{
+		// Small light sets bin on the calling thread in one range
+		const uint32_t min_slices = m_lights.size() >= k_min_lights_for_jobs ? 1u : Slices;
+		JobSystem::ParallelFor("LightGrid::Bin", Slices, min_slices, fn);
+	}
+
+	void LightGrid::PackLights(const LightEnvironment& light_environment, std::vector<glm::vec4>& out_texels)
+	{
+		const size_t point_count = std::min(light_environment.PointLights.size(), LightEnvironment::MaxPointLights);
+		const size_t spot_count = std::min(light_environment.SpotLights.size(), LightEnvironment::MaxSpotLights);
+
+		out_texels.clear();
+		out_texels.reserve((point_count + spot_count) * TexelsPerLight);
+
+		// position, range | radiance, type | direction, cutoff | constant, linear, quadratic, outer cutoff
+		for (size_t i = 0; i < point_count; i++)
+		{
+			const auto& light = light_environment.PointLights[i];
+			out_texels.emplace_back(light.Position, light.Range);
+			out_texels.emplace_back(light.Radiance, 0.0f);
+			out_texels.emplace_back(0.0f);
+			out_texels.emplace_back(light.Constant, light.Linear, light.Quadratic, 0.0f);
+		}
+
+		for (size_t i = 0; i < spot_count; i++)
+		{
+			const auto& light = light_environment.SpotLights[i];
+			out_texels.emplace_back(light.Position, light.Range);
+			out_texels.emplace_back(light.Radiance, 1.0f);
+			out_texels.emplace_back(light.Direction, light.CutOff);
+			out_texels.emplace_back(light.Constant, light.Linear, light.Quadratic, light.OuterCutOff);
+		}
+	}
+
+	void LightGrid::Build(const LightEnvironment& light_environment, const Camera& camera)
+	{
+		m_projection = camera.GetProjection();
+		const glm::mat4& view = camera.GetView();
+
+		// Recover the clip planes from the projection, glm is column major
+		float near_plane, far_plane;
+		if (m_projection[3][3] == 1.0f)
+		{
+			near_plane = (m_projection[3][2] + 1.0f) / m_projection[2][2];
+			far_plane = (m_projection[3][2] - 1.0f) / m_projection[2][2];
+		}
+		else
+		{
+			near_plane = m_projection[3][2] / (m_projection[2][2] - 1.0f);
+			far_plane = m_projection[3][2] / (m_projection[2][2] + 1.0f);
+		}
+		near_plane = std::max(near_plane, k_min_near);
+		far_plane = std::max(far_plane, near_plane * 2.0f);
+
+		const float log_ratio = std::log(far_plane / near_plane);
+		const float slice_scale = static_cast<float>(Slices) / log_ratio;
+		const float slice_bias = -slice_scale * std::log(near_plane);
+
+		const size_t point_count = std::min(light_environment.PointLights.size(), LightEnvironment::MaxPointLights);
+		const size_t spot_count = std::min(light_environment.SpotLights.size(), LightEnvironment::MaxSpotLights);
+		const uint32_t light_count = static_cast<uint32_t>(point_count + spot_count);
+
+		m_uniform_data.Grid = glm::ivec4(TilesX, TilesY, Slices, light_count);
+		m_uniform_data.DepthParams = glm::vec4(near_plane, far_plane, slice_scale, slice_bias);
+
+		m_lights.clear();
+		m_lights.reserve(light_count);
+
+		auto add_light = [&](const glm::vec3& position, float range, uint32_t index)
+		{
+			LightBounds bounds;
+			bounds.Center = glm::vec3(view * glm::vec4(position, 1.0f));
+			bounds.Radius = range > 0.0f ? range : -1.0f;
+			bounds.Index = index;
+
+			if (bounds.Radius < 0.0f)
+			{
+				bounds.FirstSlice = 0;
+				bounds.LastSlice = Slices - 1;
+				m_lights.push_back(bounds);
+				return;
+			}
+
+			const float depth = -bounds.Center.z;
+			if (depth + bounds.Radius < near_plane || depth - bounds.Radius > far_plane)
+				return;
+
+			bounds.FirstSlice = GetSlice(std::max(depth - bounds.Radius, near_plane));
+			bounds.LastSlice = GetSlice(std::min(depth + bounds.Radius, far_plane));
+			m_lights.push_back(bounds);
+		};
+
+		for (size_t i = 0; i < point_count; i++)
+			add_light(light_environment.PointLights[i].Position, light_environment.PointLights[i].Range, static_cast<uint32_t>(i));
+		for (size_t i = 0; i < spot_count; i++)
+			add_light(light_environment.SpotLights[i].Position, light_environment.SpotLights[i].Range, static_cast<uint32_t>(point_count + i));
+
+		// Count per cluster, prefix sum into offsets, then fill using the counts as cursors.
+		// Workers own disjoint slice ranges, so no cluster is written by two threads.
+		m_clusters.assign(ClusterCount, glm::uvec2(0));
+
+		auto bin = [this](uint32_t slice_begin, uint32_t slice_end, bool fill)
+		{
+			for (const auto& light : m_lights)
+			{
+				const uint32_t first = std::max(light.FirstSlice, slice_begin);
+				const uint32_t last = std::min(light.LastSlice + 1, slice_end);
+
+				for (uint32_t slice = first; slice < last; slice++)
+				{
+					glm::uvec2 tile_min, tile_max;
+					if (!GetTileRange(light, slice, tile_min, tile_max))
+						continue;
+
+					for (uint32_t y = tile_min.y; y <= tile_max.y; y++)
+					{
+						for (uint32_t x = tile_min.x; x <= tile_max.x; x++)
+						{
+							auto& cluster = m_clusters[(slice * TilesY + y) * TilesX + x];
+							if (fill)
+								m_light_indices[cluster.x + cluster.y] = light.Index;
+							cluster.y++;
+						}
+					}
+				}
+			}
+		};
+
+		ForEachSliceRange([&](uint32_t slice_begin, uint32_t slice_end) { bin(slice_begin, slice_end, false); });
+
+		uint32_t offset = 0;
+		for (auto& cluster : m_clusters)
+		{
+			cluster.x = offset;
+			offset += cluster.y;
+			cluster.y = 0;
+		}
+		m_light_indices.resize(offset);
+
+		ForEachSliceRange([&](uint32_t slice_begin, uint32_t slice_end) { bin(slice_begin, slice_end, true); });
+	}
+
+	bool LightGrid::GetTileRange(const LightBounds& light, uint32_t slice, glm::uvec2& out_min, glm::uvec2& out_max) const
+	{
+		if (light.Radius < 0.0f)
+		{
+			out_min = glm::uvec2(0);
+			out_max = glm::uvec2(TilesX - 1, TilesY - 1);
+			return true;
+		}
+
+		const float slice_scale = m_uniform_data.DepthParams.z;
+		const float slice_bias = m_uniform_data.DepthParams.w;
+		const float slice_near = std::exp((static_cast<float>(slice) - slice_bias) / slice_scale);
+		const float slice_far = std::exp((static_cast<float>(slice + 1) - slice_bias) / slice_scale);
+
+		const float depth = -light.Center.z;
+		const float z0 = std::max(slice_near, depth - light.Radius);
+		const float z1 = std::min(slice_far, depth + light.Radius);
+		if (z0 > z1)
+			return false;
+
+		// Widest cross section of the sphere inside the slice
+		float radius = light.Radius;
+		if (depth < z0 || depth > z1)
+		{
+			const float dz = std::min(std::abs(z0 - depth), std::abs(z1 - depth));
+			radius = std::sqrt(std::max(light.Radius * light.Radius - dz * dz, 0.0f));
+		}
+
+		glm::vec2 ndc_min(FLT_MAX);
+		glm::vec2 ndc_max(-FLT_MAX);
+		for (int i = 0; i < 8; i++)
+		{
+			const glm::vec4 corner(
+				light.Center.x + ((i & 1) ? radius : -radius),
+				light.Center.y + ((i & 2) ? radius : -radius),
+				(i & 4) ? -z1 : -z0,
+				1.0f);
+
+			const glm::vec4 clip = m_projection * corner;
+			const glm::vec2 ndc = glm::vec2(clip) / clip.w;
+			ndc_min = glm::min(ndc_min, ndc);
+			ndc_max = glm::max(ndc_max, ndc);
+		}
+
+		if (ndc_max.x < -1.0f || ndc_max.y < -1.0f || ndc_min.x > 1.0f || ndc_min.y > 1.0f)
+			return false;
+
+		out_min = glm::uvec2(ToTile(ndc_min.x, TilesX), ToTile(ndc_min.y, TilesY));
+		out_max = glm::uvec2(ToTile(ndc_max.x, TilesX), ToTile(ndc_max.y, TilesY));
+		return true;
+	}
+
+	uint32_t LightGrid::GetSlice(float depth) const
+	{
+		if (depth <= 0.0f)
+			return 0;
+
+		const float slice = std::floor(std::log(depth) * m_uniform_data.DepthParams.z + m_uniform_data.DepthParams.w);
+		return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(Slices - 1)));
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "UniformBuffer.h"
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ignis
+{
+	class Camera;
+	struct LightEnvironment;
+
+	// Point and spot lights binned into view-space clusters: screen tiles split
+	// into logarithmic depth slices. Each cluster stores an (offset, count) range
+	// into a flat light index list, shaders walk only the lights of their cluster.
+	class LightGrid
+	{
+	public:
+		static constexpr uint32_t TilesX = 16;
+		static constexpr uint32_t TilesY = 9;
+		static constexpr uint32_t Slices = 24;
+		static constexpr uint32_t ClusterCount = TilesX * TilesY * Slices;
+
+		// Texels per packed light record, see PackLights
+		static constexpr uint32_t TexelsPerLight = 4;
+
+		void Build(const LightEnvironment& light_environment, const Camera& camera);
+
+		// Writes the light records sampled through lightBuffer, points first then spots.
+		// Indices stored by Build refer to this order.
+		static void PackLights(const LightEnvironment& light_environment, std::vector<glm::vec4>& out_texels);
+
+		const ClusterUniformData& GetUniformData() const { return m_uniform_data; }
+		const std::vector<glm::uvec2>& GetClusters() const { return m_clusters; }
+		const std::vector<uint32_t>& GetLightIndices() const { return m_light_indices; }
+		uint32_t GetLightCount() const { return static_cast<uint32_t>(m_uniform_data.Grid.w); }
+
+	private:
+		struct LightBounds
+		{
+			glm::vec3 Center;      // view space, camera looking down -z
+			float Radius;          // negative for lights without a range, those touch every cluster
+			uint32_t Index;
+			uint32_t FirstSlice;
+			uint32_t LastSlice;
+		};
+
+		template<typename Fn>
+		void ForEachSliceRange(Fn&& fn);
+		// Tile rectangle covered by a light in one slice, false when it misses the slice
+		bool GetTileRange(const LightBounds& light, uint32_t slice, glm::uvec2& out_min, glm::uvec2& out_max) const;
+		uint32_t GetSlice(float depth) const;
+
+	private:
+		ClusterUniformData m_uniform_data;
+		glm::mat4 m_projection{ 1.0f };
+		std::vector<LightBounds> m_lights;
+
+		std::vector<glm::uvec2> m_clusters;
+		std::vector<uint32_t> m_light_indices;
+	};
+}
@@ -34,6 +34,24 @@ namespace ignis
 		virtual void Set(const std::string& name, const std::shared_ptr<Texture2D>& texture) = 0;
 		virtual void Set(const std::string& name, const std::shared_ptr<TextureCube>& texture) = 0;
 
+		virtual void Set(const UniformHandle& handle, bool value) = 0;
+		virtual void Set(const UniformHandle& handle, float value) = 0;
+		virtual void Set(const UniformHandle& handle, const glm::vec2& value) = 0;
+		virtual void Set(const UniformHandle& handle, const glm::vec3& value) = 0;
+		virtual void Set(const UniformHandle& handle, const glm::vec4& value) = 0;
+		virtual void Set(const UniformHandle& handle, int value) = 0;
+		virtual void Set(const UniformHandle& handle, const glm::ivec2& value) = 0;
+		virtual void Set(const UniformHandle& handle, const glm::ivec3& value) = 0;
+		virtual void Set(const UniformHandle& handle, const glm::ivec4& value) = 0;
+		virtual void Set(const UniformHandle& handle, uint32_t value) = 0;
+		virtual void Set(const UniformHandle& handle, const glm::uvec2& value) = 0;
+		virtual void Set(const UniformHandle& handle, const glm::uvec3& value) = 0;
+		virtual void Set(const UniformHandle& handle, const glm::uvec4& value) = 0;
+		virtual void Set(const UniformHandle& handle, const glm::mat3& value) = 0;
+		virtual void Set(const UniformHandle& handle, const glm::mat4& value) = 0;
+		virtual void Set(const SamplerHandle& handle, const std::shared_ptr<Texture2D>& texture) = 0;
+		virtual void Set(const SamplerHandle& handle, const std::shared_ptr<TextureCube>& texture) = 0;
+
 		virtual float& GetFloat(const std::string& name) = 0;
 		virtual int32_t& GetInt(const std::string& name) = 0;
 		virtual uint32_t& GetUInt(const std::string& name) = 0;
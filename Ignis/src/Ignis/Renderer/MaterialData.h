@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Ignis/Asset/Asset.h"
+#include "Ignis/Core/Hash.h"
 
 namespace ignis
 {
@@ -33,6 +34,8 @@ namespace ignis
 				glm::vec3(Offset.x, Offset.y, 1.0f)
 			);
 		}
+
+		bool operator==(const UVTransform&) const = default;
 	};
 
 	enum class AlphaMode
@@ -94,5 +97,90 @@ namespace ignis
 		float AlphaCutoff = 0.5f;
 
 		bool DoubleSided = false;
+
+		bool operator==(const MaterialData&) const = default;
+	};
+}
+
+namespace std
+{
+	template<>
+	struct hash<ignis::UVTransform>
+	{
+		std::size_t operator()(const ignis::UVTransform& t) const
+		{
+			std::size_t seed = 0;
+			ignis::HashCombine(seed, t.Offset.x);
+			ignis::HashCombine(seed, t.Offset.y);
+			ignis::HashCombine(seed, t.Scale.x);
+			ignis::HashCombine(seed, t.Scale.y);
+			ignis::HashCombine(seed, t.Rotation);
+			return seed;
+		}
+	};
+
+	template<>
+	struct hash<ignis::MaterialData>
+	{
+		std::size_t operator()(const ignis::MaterialData& d) const
+		{
+			std::size_t seed = 0;
+			auto combine_vec = [&seed](const auto& v)
+				{
+					for (int i = 0; i < v.length(); i++)
+						ignis::HashCombine(seed, v[i]);
+				};
+
+			ignis::HashCombine(seed, d.AlbedoMap);
+			combine_vec(d.AlbedoColor);
+			ignis::HashCombine(seed, d.AlbedoMapUVIndex);
+			ignis::HashCombine(seed, d.AlbedoMapUVTransform);
+
+			ignis::HashCombine(seed, d.NormalMap);
+			ignis::HashCombine(seed, d.NormalMapUVIndex);
+			ignis::HashCombine(seed, d.NormalMapUVTransform);
+
+			ignis::HashCombine(seed, d.MetalnessMap);
+			ignis::HashCombine(seed, d.MetallicValue);
+			ignis::HashCombine(seed, d.MetallicChannel);
+			ignis::HashCombine(seed, d.MetalnessMapUVIndex);
+			ignis::HashCombine(seed, d.MetalnessMapUVTransform);
+
+			ignis::HashCombine(seed, d.RoughnessMap);
+			ignis::HashCombine(seed, d.RoughnessValue);
+			ignis::HashCombine(seed, d.RoughnessChannel);
+			ignis::HashCombine(seed, d.RoughnessMapUVIndex);
+			ignis::HashCombine(seed, d.RoughnessMapUVTransform);
+
+			ignis::HashCombine(seed, d.EmissiveMap);
+			combine_vec(d.EmissiveColor);
+			ignis::HashCombine(seed, d.EmissiveIntensity);
+			ignis::HashCombine(seed, d.EmissiveMapUVIndex);
+			ignis::HashCombine(seed, d.EmissiveMapUVTransform);
+
+			ignis::HashCombine(seed, d.AOMap);
+			ignis::HashCombine(seed, d.AOMapUVIndex);
+			ignis::HashCombine(seed, d.AOMapUVTransform);
+
+			ignis::HashCombine(seed, d.ClearcoatFactor);
+			ignis::HashCombine(seed, d.ClearcoatRoughnessFactor);
+
+			ignis::HashCombine(seed, d.ClearcoatMap);
+			ignis::HashCombine(seed, d.ClearcoatMapUVIndex);
+			ignis::HashCombine(seed, d.ClearcoatMapUVTransform);
+
+			ignis::HashCombine(seed, d.ClearcoatRoughnessMap);
+			ignis::HashCombine(seed, d.ClearcoatRoughnessMapUVIndex);
+			ignis::HashCombine(seed, d.ClearcoatRoughnessMapUVTransform);
+
+			ignis::HashCombine(seed, d.ClearcoatNormalMap);
+			ignis::HashCombine(seed, d.ClearcoatNormalMapUVIndex);
+			ignis::HashCombine(seed, d.ClearcoatNormalMapUVTransform);
+
+			ignis::HashCombine(seed, static_cast<int>(d.Alpha));
+			ignis::HashCombine(seed, d.AlphaCutoff);
+			ignis::HashCombine(seed, d.DoubleSided);
+			return seed;
+		}
 	};
-}
\ No newline at end of file
+}
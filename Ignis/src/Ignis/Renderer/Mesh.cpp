@@ -1,31 +1,194 @@
 #include "Mesh.h"
 
+#include <glm/gtc/packing.hpp>
+
 namespace ignis
 {
+	namespace
+	{
+		// Attribute locations shared with IgnisPBR.glsl and DepthPrepass.glsl
+		constexpr uint32_t k_position_location = 0;
+		constexpr uint32_t k_normal_location = 1;
+		constexpr uint32_t k_uv_location = 2;
+		constexpr uint32_t k_tangent_location = 5;
+		constexpr uint32_t k_max_uv_sets = 3;
+
+		// 16-bit ranges are padded so every range starts 4 byte aligned
+		constexpr uint32_t k_index_alignment = 4;
+
+		float SignNotZero(float v)
+		{
+			return v >= 0.0f ? 1.0f : -1.0f;
+		}
+
+		// Octahedral mapping of a unit vector onto [-1, 1]^2
+		glm::vec2 OctEncode(const glm::vec3& v)
+		{
+			const float length = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+			if (length <= 0.0f)
+				return glm::vec2(1.0f, 0.0f);
+
+			glm::vec2 e = glm::vec2(v) / length;
+			if (v.z < 0.0f)
+				e = (1.0f - glm::abs(glm::vec2(e.y, e.x))) * glm::vec2(SignNotZero(e.x), SignNotZero(e.y));
+			return e;
+		}
+
+		int16_t ToSnorm16(float v)
+		{
+			return static_cast<int16_t>(std::round(std::clamp(v, -1.0f, 1.0f) * 32767.0f));
+		}
+
+		template<typename T>
+		void Write(std::vector<uint8_t>& data, size_t offset, const T& value)
+		{
+			std::memcpy(data.data() + offset, &value, sizeof(T));
+		}
+
+		template<typename T>
+		void AppendIndices(std::vector<uint8_t>& data, const uint32_t* indices, uint32_t count, uint32_t base_vertex)
+		{
+			const size_t offset = data.size();
+			data.resize(offset + count * sizeof(T));
+			T* out = reinterpret_cast<T*>(data.data() + offset);
+			for (uint32_t i = 0; i < count; i++)
+				out[i] = static_cast<T>(indices[i] - base_vertex);
+		}
+	}
+
 	Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
 		: m_vertices(vertices), m_indices(indices)
 	{
-		m_vertex_buffer = VertexBuffer::Create(vertices.data(), vertices.size() * sizeof(Vertex));
-		m_index_buffer = IndexBuffer::Create(indices.data(), indices.size() * sizeof(uint32_t));
+		UploadGeometry();
+	}
 
-		m_vertex_array = VertexArray::Create();
+	VertexBuffer::Layout Mesh::GetPackedLayout(uint32_t uv_set_mask)
+	{
+		std::vector<VertexBuffer::Attribute> attributes = {
+			{ k_position_location, Shader::DataType::Float3 },
+			{ k_normal_location, Shader::DataType::Short2, true },   // Octahedral normal
+			{ k_tangent_location, Shader::DataType::Short4, true },  // Octahedral tangent, bitangent sign
+		};
+		for (uint32_t set = 0; set < k_max_uv_sets; set++)
+		{
+			if (uv_set_mask & (1u << set))
+				attributes.push_back({ k_uv_location + set, Shader::DataType::Half2 });
+		}
+		return VertexBuffer::Layout(attributes);
+	}
 
-		m_vertex_buffer = VertexBuffer::Create(m_vertices.data(),
-			(uint32_t)(m_vertices.size() * sizeof(Vertex)));
+	std::shared_ptr<VertexArray> Mesh::GetVertexArray() const
+	{
+		// Looked up every time, defragmenting the arena replaces its vertex array
+		if (m_arena_allocation)
+			return GeometryArena::Get()->GetVertexArray();
+		return m_vertex_array;
+	}
 
-		m_vertex_buffer->SetLayout(VertexBuffer::Layout({
-			{0, Shader::DataType::Float3},
-			{1, Shader::DataType::Float3},
-			{2, Shader::DataType::Float2},
-			}));
+	void Mesh::UploadGeometry(bool use_arena)
+	{
+		m_vertex_count = static_cast<uint32_t>(m_vertices.size());
+		m_index_count = static_cast<uint32_t>(m_indices.size());
+
+		auto arena = use_arena ? GeometryArena::Get() : nullptr;
+		const VertexBuffer::Layout layout = GetPackedLayout(arena ? AllUVSets : m_uv_set_mask);
+
+		const size_t stride = layout.GetStride();
+		std::vector<uint8_t> packed(m_vertices.size() * stride);
+
+		for (size_t v = 0; v < m_vertices.size(); v++)
+		{
+			const Vertex& vertex = m_vertices[v];
+			const size_t base = v * stride;
+
+			for (const auto& attribute : layout.GetAttributes())
+			{
+				const size_t offset = base + attribute.Offset;
+				switch (attribute.Index)
+				{
+				case k_position_location:
+					Write(packed, offset, vertex.Position);
+					break;
+				case k_normal_location:
+				{
+					const glm::vec2 e = OctEncode(vertex.Normal);
+					const int16_t normal[2] = { ToSnorm16(e.x), ToSnorm16(e.y) };
+					Write(packed, offset, normal);
+					break;
+				}
+				case k_tangent_location:
+				{
+					// The bitangent is rebuilt in the shader as cross(N, T) * sign
+					const glm::vec2 e = OctEncode(vertex.Tangent);
+					const float handedness = glm::dot(glm::cross(vertex.Normal, vertex.Tangent), vertex.Bitangent) < 0.0f ? -1.0f : 1.0f;
+					const int16_t tangent[4] = { ToSnorm16(e.x), ToSnorm16(e.y), ToSnorm16(handedness), 0 };
+					Write(packed, offset, tangent);
+					break;
+				}
+				default:
+				{
+					const glm::vec2& uv = attribute.Index == k_uv_location ? vertex.TexCoords
+						: attribute.Index == k_uv_location + 1 ? vertex.TexCoords1 : vertex.TexCoords2;
+					Write(packed, offset, glm::packHalf2x16(uv));
+					break;
+				}
+				}
+			}
+		}
+
+		// Each submesh range holds indices relative to its BaseVertex, so most fit in 16 bits
+		std::vector<uint8_t> index_data;
+		index_data.reserve(m_indices.size() * sizeof(uint32_t));
+
+		auto append_range = [&](uint32_t base_index, uint32_t count, uint32_t base_vertex, IndexFormat format)
+		{
+			index_data.resize((index_data.size() + k_index_alignment - 1) / k_index_alignment * k_index_alignment);
+			const uint32_t offset = static_cast<uint32_t>(index_data.size());
+			if (format == IndexFormat::UInt16)
+				AppendIndices<uint16_t>(index_data, m_indices.data() + base_index, count, base_vertex);
+			else
+				AppendIndices<uint32_t>(index_data, m_indices.data() + base_index, count, base_vertex);
+			return offset;
+		};
+
+		if (m_submeshes.empty())
+			append_range(0, m_index_count, 0, IndexFormat::UInt32);
+
+		for (auto& sub : m_submeshes)
+		{
+			sub.Format = sub.VertexCount < 65536 ? IndexFormat::UInt16 : IndexFormat::UInt32;
+			sub.IndexOffset = append_range(sub.BaseIndex, sub.IndexCount, sub.BaseVertex, sub.Format);
+			for (auto& lod : sub.LODs)
+				lod.IndexOffset = append_range(lod.BaseIndex, lod.IndexCount, sub.BaseVertex, sub.Format);
+		}
 
-		m_index_buffer = IndexBuffer::Create(m_indices.data(),
-			(uint32_t)(m_indices.size() * sizeof(uint32_t)));
+		if (arena)
+		{
+			m_arena_allocation = arena->Allocate(packed.data(), m_vertex_count, index_data.data(), static_cast<uint32_t>(index_data.size()));
+			m_vertex_array.reset();
+			m_vertex_buffer.reset();
+			m_index_buffer.reset();
+			return;
+		}
+
+		m_arena_allocation.reset();
+		m_vertex_array = VertexArray::Create();
+
+		m_vertex_buffer = VertexBuffer::Create(packed.data(), packed.size());
+		m_vertex_buffer->SetLayout(layout);
+
+		m_index_buffer = IndexBuffer::Create(index_data.data(), static_cast<uint32_t>(index_data.size()));
 
 		m_vertex_array->AddVertexBuffer(m_vertex_buffer);
 		m_vertex_array->SetIndexBuffer(m_index_buffer);
 	}
 
+	void Mesh::ReleaseCPUData()
+	{
+		std::vector<Vertex>().swap(m_vertices);
+		std::vector<uint32_t>().swap(m_indices);
+	}
+
 	void Mesh::SetMaterialDataTexture(uint32_t material_index, MaterialType type, AssetHandle texture_handle)
 	{
 		if (material_index >= m_materials_data.size()) return;
@@ -50,16 +213,20 @@ namespace ignis
 
 	void Mesh::FlipUVs()
 	{
-		for (auto& vertex : m_vertices)
+		// The packed buffer is rebuilt from the CPU vertices
+		if (!HasCPUData())
 		{
-			vertex.TexCoords.y = 1.0f - vertex.TexCoords.y;
+			Log::CoreWarn("Mesh::FlipUVs: CPU data was released, UVs cannot be flipped");
+			return;
 		}
 
-		if (m_vertex_buffer)
+		for (auto& vertex : m_vertices)
 		{
-			m_vertex_buffer->SetData(m_vertices.data(), m_vertices.size() * sizeof(Vertex));
+			vertex.TexCoords.y = 1.0f - vertex.TexCoords.y;
 		}
 
+		UploadGeometry(IsInGeometryArena());
+
 		uv_flipped ^= 1;
 	}
-}
\ No newline at end of file
+}
@@ -4,14 +4,17 @@
 #include "VertexBuffer.h"
 #include "IndexBuffer.h"
 #include "VertexArray.h"
+#include "GeometryArena.h"
 #include "Texture.h"
 #include "MaterialData.h"
+#include "Bounds.h"
 #include "Ignis/Asset/Asset.h"
 
 #include <glm/glm.hpp>
 
 namespace ignis
 {
+	// Full precision CPU layout, the GPU gets the packed form built by Mesh::UploadGeometry
 	struct Vertex
 	{
 		glm::vec3 Position;
@@ -30,6 +33,15 @@ namespace ignis
 		glm::mat4 Transform{ 1.0f };
 	};
 
+	// Simplified index range into the mesh's index buffer, sharing the submesh's vertices
+	struct SubmeshLOD
+	{
+		uint32_t BaseIndex = 0;
+		uint32_t IndexCount = 0;
+		// Byte offset into the GPU index buffer
+		uint32_t IndexOffset = 0;
+	};
+
 	struct Submesh
 	{
 		uint32_t BaseVertex = 0;
@@ -37,6 +49,36 @@ namespace ignis
 		uint32_t VertexCount = 0;
 		uint32_t IndexCount = 0;
 		uint32_t MaterialIndex = 0;
+
+		// GPU indices are relative to BaseVertex, 16-bit when the submesh allows it
+		IndexFormat Format = IndexFormat::UInt32;
+		uint32_t IndexOffset = 0;
+
+		// Object space
+		AABB Bounds;
+		BoundingSphere Sphere;
+
+		// LOD 1 onwards, LOD 0 is BaseIndex/IndexCount
+		std::vector<SubmeshLOD> LODs;
+
+		uint32_t GetLODCount() const { return static_cast<uint32_t>(LODs.size()) + 1; }
+		// Clamped to the coarsest LOD this submesh has
+		SubmeshLOD GetLOD(uint32_t lod) const
+		{
+			if (lod == 0 || LODs.empty())
+				return { BaseIndex, IndexCount, IndexOffset };
+			return LODs[std::min<size_t>(lod, LODs.size()) - 1];
+		}
+	};
+
+	// Low-poly stand-in rasterized by the CPU occlusion buffer. Built from a
+	// subset of the mesh's own triangles, so it never covers more than the mesh.
+	struct OccluderMesh
+	{
+		std::vector<glm::vec3> Positions;
+		std::vector<uint32_t> Indices;
+
+		bool IsEmpty() const { return Indices.empty(); }
 	};
 
 	class IGNIS_API Mesh : public Asset
@@ -49,36 +91,80 @@ namespace ignis
 
 		MeshNode& GetRootNode() { return m_nodes[0]; }
 
+		// Empty once the CPU copies are released, the counts stay valid
 		const std::vector<Vertex>& GetVertices() const { return m_vertices; }
 		const std::vector<uint32_t>& GetIndices() const { return m_indices; }
+		uint32_t GetVertexCount() const { return m_vertex_count; }
+		uint32_t GetIndexCount() const { return m_index_count; }
+		bool HasCPUData() const { return !m_vertices.empty(); }
 		const std::vector<MaterialData>& GetMaterialsData() const { return m_materials_data; }
 		const std::vector<MeshNode>& GetNodes() const { return m_nodes; }
 		const std::vector<Submesh>& GetSubmeshes() const { return m_submeshes; }
 
-		std::shared_ptr<VertexArray> GetVertexArray() const { return m_vertex_array; }
+		const AABB& GetBounds() const { return m_bounds; }
+		const BoundingSphere& GetBoundingSphere() const { return m_bounding_sphere; }
+		const OccluderMesh& GetOccluder() const { return m_occluder; }
+
+		// Highest LOD count across submeshes, 1 when no LODs were generated
+		uint32_t GetLODCount() const { return m_lod_count; }
+		// Projected size below which LOD i + 1 is used, decreasing
+		const std::vector<float>& GetLODScreenSizes() const { return m_lod_screen_sizes; }
+		float GetLODHysteresis() const { return m_lod_hysteresis; }
+
+		// The shared arena's vertex array for arena meshes, draws add the offsets below
+		std::shared_ptr<VertexArray> GetVertexArray() const;
 		std::shared_ptr<VertexBuffer> GetVertexBuffer() const { return m_vertex_buffer; }
 		std::shared_ptr<IndexBuffer> GetIndexBuffer() const { return m_index_buffer; }
 
+		bool IsInGeometryArena() const { return m_arena_allocation != nullptr; }
+		// Where this mesh's data starts in the bound buffers, 0 outside the arena
+		uint32_t GetBaseVertexOffset() const { return m_arena_allocation ? m_arena_allocation->BaseVertex : 0; }
+		uint32_t GetIndexBufferOffset() const { return m_arena_allocation ? m_arena_allocation->IndexOffset : 0; }
+
 		void SetMaterialDataTexture(uint32_t material_index, MaterialType type, AssetHandle texture_handle);
 		void SetMaterialData(uint32_t material_index, MaterialData material_data);
 
 		void FlipUVs();
 		bool IsUVsFlipped() { return uv_flipped; }
 
+		// Packs m_vertices into the compressed GPU layout and builds the per-submesh index ranges.
+		// With use_arena the data goes to GeometryArena::Get() instead of buffers of its own.
+		void UploadGeometry(bool use_arena = false);
+		// Frees m_vertices and m_indices, only the GPU buffers remain
+		void ReleaseCPUData();
+
 		~Mesh() = default;
 
+		static constexpr uint32_t AllUVSets = 0b111;
+		// Packed GPU vertex layout holding the UV sets in uv_set_mask
+		static VertexBuffer::Layout GetPackedLayout(uint32_t uv_set_mask);
+
 	private:
 		std::vector<Vertex> m_vertices;
 		std::vector<uint32_t> m_indices;
+		uint32_t m_vertex_count = 0;
+		uint32_t m_index_count = 0;
+		// Bit per UV set present in the source, absent sets are left out of the GPU layout
+		uint32_t m_uv_set_mask = 1;
 
 		std::vector<MaterialData> m_materials_data;
 
 		std::vector<MeshNode> m_nodes;
 		std::vector<Submesh>  m_submeshes;
 
+		// Meshes without computed bounds are never culled
+		AABB m_bounds;
+		BoundingSphere m_bounding_sphere{ glm::vec3(0.0f), FLT_MAX };
+		OccluderMesh m_occluder;
+
+		uint32_t m_lod_count = 1;
+		std::vector<float> m_lod_screen_sizes;
+		float m_lod_hysteresis = 0.0f;
+
 		std::shared_ptr<VertexArray> m_vertex_array;
 		std::shared_ptr<VertexBuffer> m_vertex_buffer;
 		std::shared_ptr<IndexBuffer> m_index_buffer;
+		std::shared_ptr<GeometryAllocation> m_arena_allocation;
 
 		bool uv_flipped = false;
 
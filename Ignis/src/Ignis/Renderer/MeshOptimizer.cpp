@@ -0,0 +1,339 @@
+#include "MeshOptimizer.h"
+#include "Mesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+
+namespace ignis
+{
+	namespace
+	{
+		// Forsyth's scoring model, the cache here is an LRU list independent of CacheSize
+		constexpr uint32_t k_forsyth_cache_size = 32;
+		constexpr float k_cache_decay_power = 1.5f;
+		constexpr float k_last_triangle_score = 0.75f;
+		constexpr float k_valence_boost_scale = 2.0f;
+		constexpr float k_valence_boost_power = 0.5f;
+
+		constexpr uint32_t k_invalid = 0xffffffffu;
+
+		float VertexScore(int32_t cache_position, uint32_t remaining_triangles)
+		{
+			if (remaining_triangles == 0)
+				return -1.0f;
+
+			float score = 0.0f;
+			if (cache_position >= 0)
+			{
+				if (cache_position < 3)
+				{
+					// The triangle just drawn, no extra benefit in picking it again
+					score = k_last_triangle_score;
+				}
+				else
+				{
+					const float scale = 1.0f / static_cast<float>(k_forsyth_cache_size - 3);
+					score = std::pow(1.0f - static_cast<float>(cache_position - 3) * scale, k_cache_decay_power);
+				}
+			}
+
+			// Favour vertices with few triangles left so they are finished off
+			score += k_valence_boost_scale * std::pow(static_cast<float>(remaining_triangles), -k_valence_boost_power);
+			return score;
+		}
+	}
+
+	size_t MeshOptimizer::WeldVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		// Vertex is all floats, so comparing bytes matches comparing fields
+		auto hash = [&vertices](uint32_t index)
+		{
+			const auto* bytes = reinterpret_cast<const uint8_t*>(&vertices[index]);
+			uint64_t h = 14695981039346656037ull;
+			for (size_t i = 0; i < sizeof(Vertex); i++)
+				h = (h ^ bytes[i]) * 1099511628211ull;
+			return static_cast<size_t>(h);
+		};
+		auto equal = [&vertices](uint32_t a, uint32_t b)
+		{
+			return std::memcmp(&vertices[a], &vertices[b], sizeof(Vertex)) == 0;
+		};
+
+		std::unordered_map<uint32_t, uint32_t, decltype(hash), decltype(equal)> unique(vertices.size(), hash, equal);
+		std::vector<uint32_t> remap(vertices.size());
+
+		for (uint32_t v = 0; v < vertices.size(); v++)
+		{
+			auto [it, inserted] = unique.try_emplace(v, static_cast<uint32_t>(unique.size()));
+			remap[v] = it->second;
+		}
+
+		std::vector<Vertex> welded(unique.size());
+		for (uint32_t v = 0; v < vertices.size(); v++)
+			welded[remap[v]] = vertices[v];
+
+		for (uint32_t& index : indices)
+			index = remap[index];
+
+		vertices = std::move(welded);
+		return vertices.size();
+	}
+
+	void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertex_count)
+	{
+		const size_t triangle_count = indices.size() / 3;
+		if (triangle_count == 0)
+			return;
+
+		// Triangles per vertex, the first Remaining entries of each range are still to be drawn
+		std::vector<uint32_t> offsets(vertex_count + 1, 0);
+		for (uint32_t index : indices)
+			offsets[index + 1]++;
+		std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+		std::vector<uint32_t> remaining(vertex_count);
+		for (size_t v = 0; v < vertex_count; v++)
+			remaining[v] = offsets[v + 1] - offsets[v];
+
+		std::vector<uint32_t> adjacency(indices.size());
+		{
+			std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+			for (size_t t = 0; t < triangle_count; t++)
+				for (uint32_t k = 0; k < 3; k++)
+					adjacency[cursor[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+		}
+
+		std::vector<int32_t> cache_position(vertex_count, -1);
+		std::vector<float> vertex_score(vertex_count);
+		for (size_t v = 0; v < vertex_count; v++)
+			vertex_score[v] = VertexScore(-1, remaining[v]);
+
+		std::vector<float> triangle_score(triangle_count);
+		std::vector<uint8_t> emitted(triangle_count, 0);
+		for (size_t t = 0; t < triangle_count; t++)
+			triangle_score[t] = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+
+		uint32_t best_triangle = static_cast<uint32_t>(std::max_element(triangle_score.begin(), triangle_score.end()) - triangle_score.begin());
+
+		std::vector<uint32_t> cache;
+		std::vector<uint32_t> next_cache;
+		cache.reserve(k_forsyth_cache_size + 3);
+		next_cache.reserve(k_forsyth_cache_size + 3);
+
+		std::vector<uint32_t> result;
+		result.reserve(indices.size());
+
+		size_t scan_cursor = 0;
+		for (size_t emitted_count = 0; emitted_count < triangle_count; emitted_count++)
+		{
+			if (best_triangle == k_invalid)
+			{
+				// Nothing in the cache has triangles left, restart from the next undrawn one
+				while (emitted[scan_cursor])
+					scan_cursor++;
+				best_triangle = static_cast<uint32_t>(scan_cursor);
+			}
+
+			const uint32_t* tri = indices.data() + best_triangle * 3;
+			emitted[best_triangle] = 1;
+
+			next_cache.clear();
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				const uint32_t v = tri[k];
+				result.push_back(v);
+				next_cache.push_back(v);
+
+				// Drop the triangle from the vertex's pending list
+				uint32_t* begin = adjacency.data() + offsets[v];
+				uint32_t* end = begin + remaining[v];
+				uint32_t* it = std::find(begin, end, best_triangle);
+				std::swap(*it, *(end - 1));
+				remaining[v]--;
+			}
+
+			for (uint32_t v : cache)
+			{
+				if (v != tri[0] && v != tri[1] && v != tri[2])
+					next_cache.push_back(v);
+			}
+
+			// Vertices pushed out of the cache lose their position score
+			for (size_t i = k_forsyth_cache_size; i < next_cache.size(); i++)
+			{
+				const uint32_t v = next_cache[i];
+				cache_position[v] = -1;
+				vertex_score[v] = VertexScore(-1, remaining[v]);
+			}
+			if (next_cache.size() > k_forsyth_cache_size)
+				next_cache.resize(k_forsyth_cache_size);
+
+			for (size_t i = 0; i < next_cache.size(); i++)
+			{
+				const uint32_t v = next_cache[i];
+				cache_position[v] = static_cast<int32_t>(i);
+				vertex_score[v] = VertexScore(static_cast<int32_t>(i), remaining[v]);
+			}
+
+			// Only triangles touching the cache changed score, the best of them is drawn next
+			best_triangle = k_invalid;
+			float best_score = -1.0f;
+			for (uint32_t v : next_cache)
+			{
+				for (uint32_t i = offsets[v]; i < offsets[v] + remaining[v]; i++)
+				{
+					const uint32_t t = adjacency[i];
+					const uint32_t* other = indices.data() + t * 3;
+					const float score = vertex_score[other[0]] + vertex_score[other[1]] + vertex_score[other[2]];
+					triangle_score[t] = score;
+					if (score > best_score)
+					{
+						best_score = score;
+						best_triangle = t;
+					}
+				}
+			}
+
+			std::swap(cache, next_cache);
+		}
+
+		indices = std::move(result);
+	}
+
+	void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, float threshold)
+	{
+		const size_t triangle_count = indices.size() / 3;
+		if (triangle_count < 2)
+			return;
+
+		const float acmr_before = ComputeACMR(indices.data(), indices.size(), vertices.size());
+
+		// A triangle that misses on all three vertices starts a new cluster, splitting there costs no reuse
+		std::vector<uint32_t> cluster_starts;
+		{
+			std::vector<uint32_t> timestamps(vertices.size(), 0);
+			uint32_t time = CacheSize + 1;
+
+			for (size_t t = 0; t < triangle_count; t++)
+			{
+				uint32_t misses = 0;
+				for (uint32_t k = 0; k < 3; k++)
+				{
+					const uint32_t v = indices[t * 3 + k];
+					if (time - timestamps[v] > CacheSize)
+					{
+						timestamps[v] = time++;
+						misses++;
+					}
+				}
+				if (misses == 3 || t == 0)
+					cluster_starts.push_back(static_cast<uint32_t>(t));
+			}
+		}
+
+		if (cluster_starts.size() < 2)
+			return;
+
+		glm::vec3 mesh_center(0.0f);
+		for (const auto& vertex : vertices)
+			mesh_center += vertex.Position;
+		mesh_center /= static_cast<float>(vertices.size());
+
+		struct Cluster
+		{
+			uint32_t First;
+			uint32_t Count;
+			float SortKey;
+		};
+
+		std::vector<Cluster> clusters;
+		clusters.reserve(cluster_starts.size());
+		for (size_t c = 0; c < cluster_starts.size(); c++)
+		{
+			const uint32_t first = cluster_starts[c];
+			const uint32_t last = c + 1 < cluster_starts.size() ? cluster_starts[c + 1] : static_cast<uint32_t>(triangle_count);
+
+			glm::vec3 centroid(0.0f);
+			glm::vec3 normal(0.0f);
+			float area = 0.0f;
+			for (uint32_t t = first; t < last; t++)
+			{
+				const glm::vec3& a = vertices[indices[t * 3]].Position;
+				const glm::vec3& b = vertices[indices[t * 3 + 1]].Position;
+				const glm::vec3& c2 = vertices[indices[t * 3 + 2]].Position;
+				const glm::vec3 n = glm::cross(b - a, c2 - a);
+				const float triangle_area = glm::length(n);
+				centroid += (a + b + c2) * (triangle_area / 3.0f);
+				normal += n;
+				area += triangle_area;
+			}
+
+			float key = 0.0f;
+			const float normal_length = glm::length(normal);
+			if (area > 0.0f && normal_length > 0.0f)
+				key = glm::dot(centroid / area - mesh_center, normal / normal_length);
+
+			clusters.push_back({ first, last - first, key });
+		}
+
+		// Outward facing clusters first, they tend to hide the rest of the mesh
+		std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) { return a.SortKey > b.SortKey; });
+
+		std::vector<uint32_t> result;
+		result.reserve(indices.size());
+		for (const auto& cluster : clusters)
+			result.insert(result.end(), indices.begin() + cluster.First * 3, indices.begin() + (cluster.First + cluster.Count) * 3);
+
+		if (ComputeACMR(result.data(), result.size(), vertices.size()) <= acmr_before * threshold)
+			indices = std::move(result);
+	}
+
+	void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		std::vector<uint32_t> remap(vertices.size(), k_invalid);
+		std::vector<Vertex> reordered;
+		reordered.reserve(vertices.size());
+
+		for (uint32_t& index : indices)
+		{
+			if (remap[index] == k_invalid)
+			{
+				remap[index] = static_cast<uint32_t>(reordered.size());
+				reordered.push_back(vertices[index]);
+			}
+			index = remap[index];
+		}
+
+		vertices = std::move(reordered);
+	}
+
+	size_t MeshOptimizer::CountCacheMisses(const uint32_t* indices, size_t index_count, size_t vertex_count)
+	{
+		// A vertex is cached if it was loaded within the last CacheSize misses
+		std::vector<uint32_t> timestamps(vertex_count, 0);
+		uint32_t time = CacheSize + 1;
+		size_t misses = 0;
+
+		for (size_t i = 0; i < index_count; i++)
+		{
+			const uint32_t v = indices[i];
+			if (time - timestamps[v] > CacheSize)
+			{
+				timestamps[v] = time++;
+				misses++;
+			}
+		}
+		return misses;
+	}
+
+	float MeshOptimizer::ComputeACMR(const uint32_t* indices, size_t index_count, size_t vertex_count)
+	{
+		const size_t triangle_count = index_count / 3;
+		if (triangle_count == 0)
+			return 0.0f;
+		return static_cast<float>(CountCacheMisses(indices, index_count, vertex_count)) / static_cast<float>(triangle_count);
+	}
+}
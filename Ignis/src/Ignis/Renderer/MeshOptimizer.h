@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ignis
+{
+	struct Vertex;
+
+	// Index and vertex reordering run on imported geometry. Indices are local to
+	// the vertex array passed in, so each submesh is optimized on its own.
+	class MeshOptimizer
+	{
+	public:
+		// Post-transform cache size assumed by ComputeACMR, a common FIFO size on current GPUs
+		static constexpr uint32_t CacheSize = 16;
+
+		// Merges bitwise identical vertices, returns the new vertex count
+		static size_t WeldVertices(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+		// Forsyth's linear-speed triangle ordering for post-transform cache reuse
+		static void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertex_count);
+
+		// Sorts cache-ordered clusters so outward facing ones draw first (Tipsify style).
+		// Kept only if the ACMR stays within threshold of the cache-optimized order.
+		static void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, float threshold = 1.05f);
+
+		// Renumbers vertices in first-use order and drops unreferenced ones
+		static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+		// Vertex cache misses with a FIFO cache of CacheSize entries
+		static size_t CountCacheMisses(const uint32_t* indices, size_t index_count, size_t vertex_count);
+		// Average cache misses per triangle, 3 is no reuse at all and 0.5 is ideal for large grids
+		static float ComputeACMR(const uint32_t* indices, size_t index_count, size_t vertex_count);
+	};
+}
@@ -0,0 +1,242 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+
+namespace ignis
+{
+	namespace
+	{
+		// Open edges get a plane perpendicular to their face, weighted well above the surface planes
+		constexpr double k_boundary_weight = 10.0;
+
+		struct Quadric
+		{
+			double A2 = 0, AB = 0, AC = 0, AD = 0;
+			double B2 = 0, BC = 0, BD = 0;
+			double C2 = 0, CD = 0;
+			double D2 = 0;
+
+			static Quadric FromPlane(const glm::dvec3& n, double d, double weight)
+			{
+				Quadric q;
+				q.A2 = n.x * n.x * weight; q.AB = n.x * n.y * weight; q.AC = n.x * n.z * weight; q.AD = n.x * d * weight;
+				q.B2 = n.y * n.y * weight; q.BC = n.y * n.z * weight; q.BD = n.y * d * weight;
+				q.C2 = n.z * n.z * weight; q.CD = n.z * d * weight;
+				q.D2 = d * d * weight;
+				return q;
+			}
+
+			Quadric& operator+=(const Quadric& o)
+			{
+				A2 += o.A2; AB += o.AB; AC += o.AC; AD += o.AD;
+				B2 += o.B2; BC += o.BC; BD += o.BD;
+				C2 += o.C2; CD += o.CD;
+				D2 += o.D2;
+				return *this;
+			}
+
+			double Evaluate(const glm::dvec3& p) const
+			{
+				return A2 * p.x * p.x + 2.0 * AB * p.x * p.y + 2.0 * AC * p.x * p.z + 2.0 * AD * p.x
+					+ B2 * p.y * p.y + 2.0 * BC * p.y * p.z + 2.0 * BD * p.y
+					+ C2 * p.z * p.z + 2.0 * CD * p.z
+					+ D2;
+			}
+		};
+
+		struct Collapse
+		{
+			uint32_t From;
+			uint32_t To;
+			double Cost;
+		};
+
+		uint64_t EdgeKey(uint32_t a, uint32_t b)
+		{
+			return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+		}
+	}
+
+	std::vector<uint32_t> MeshSimplifier::Simplify(const glm::vec3* positions, size_t vertex_count, size_t stride,
+		const uint32_t* indices, size_t index_count, size_t target_index_count)
+	{
+		std::vector<uint32_t> result(indices, indices + index_count);
+		if (target_index_count >= index_count || vertex_count == 0)
+			return result;
+
+		auto position = [&](uint32_t v) -> glm::dvec3
+		{
+			return glm::dvec3(*reinterpret_cast<const glm::vec3*>(reinterpret_cast<const uint8_t*>(positions) + v * stride));
+		};
+
+		// Surface and boundary quadrics, accumulated once from the full mesh
+		std::vector<Quadric> quadrics(vertex_count);
+		std::unordered_map<uint64_t, std::pair<uint32_t, uint32_t>> edge_uses; // key -> (use count, first triangle)
+		edge_uses.reserve(index_count);
+
+		for (size_t t = 0; t + 2 < index_count; t += 3)
+		{
+			const uint32_t v[3] = { result[t], result[t + 1], result[t + 2] };
+			const glm::dvec3 normal = glm::cross(position(v[1]) - position(v[0]), position(v[2]) - position(v[0]));
+			const double length = glm::length(normal);
+			if (length > 0.0)
+			{
+				const glm::dvec3 n = normal / length;
+				const Quadric q = Quadric::FromPlane(n, -glm::dot(n, position(v[0])), length * 0.5);
+				for (uint32_t k = 0; k < 3; k++)
+					quadrics[v[k]] += q;
+			}
+
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				auto [it, inserted] = edge_uses.try_emplace(EdgeKey(v[k], v[(k + 1) % 3]), 0u, static_cast<uint32_t>(t));
+				it->second.first++;
+			}
+		}
+
+		for (const auto& [key, use] : edge_uses)
+		{
+			if (use.first != 1)
+				continue;
+
+			const uint32_t a = static_cast<uint32_t>(key >> 32);
+			const uint32_t b = static_cast<uint32_t>(key & 0xffffffffu);
+			const glm::dvec3 pa = position(a);
+			const glm::dvec3 edge = position(b) - pa;
+
+			const uint32_t* tri = result.data() + use.second;
+			const glm::dvec3 face_normal = glm::cross(position(tri[1]) - position(tri[0]), position(tri[2]) - position(tri[0]));
+			const glm::dvec3 normal = glm::cross(edge, face_normal);
+			const double length = glm::length(normal);
+			if (length <= 0.0)
+				continue;
+
+			const glm::dvec3 n = normal / length;
+			const Quadric q = Quadric::FromPlane(n, -glm::dot(n, pa), glm::dot(edge, edge) * k_boundary_weight);
+			quadrics[a] += q;
+			quadrics[b] += q;
+		}
+
+		std::vector<uint32_t> adjacency_offsets(vertex_count + 1);
+		std::vector<uint32_t> adjacency;
+		std::vector<uint64_t> edges;
+		std::vector<Collapse> collapses;
+		std::vector<uint32_t> collapse_target(vertex_count);
+		std::vector<uint8_t> locked(vertex_count);
+
+		// Each pass collapses a set of independent edges in cost order, then rebuilds connectivity
+		while (result.size() > target_index_count)
+		{
+			const size_t triangle_count = result.size() / 3;
+
+			std::fill(adjacency_offsets.begin(), adjacency_offsets.end(), 0u);
+			for (uint32_t index : result)
+				adjacency_offsets[index + 1]++;
+			std::partial_sum(adjacency_offsets.begin(), adjacency_offsets.end(), adjacency_offsets.begin());
+
+			adjacency.resize(result.size());
+			std::vector<uint32_t> cursor(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+			for (size_t t = 0; t < triangle_count; t++)
+				for (uint32_t k = 0; k < 3; k++)
+					adjacency[cursor[result[t * 3 + k]]++] = static_cast<uint32_t>(t);
+
+			edges.clear();
+			for (size_t t = 0; t < triangle_count; t++)
+				for (uint32_t k = 0; k < 3; k++)
+					edges.push_back(EdgeKey(result[t * 3 + k], result[t * 3 + (k + 1) % 3]));
+			std::sort(edges.begin(), edges.end());
+			edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+			collapses.clear();
+			for (uint64_t key : edges)
+			{
+				const uint32_t a = static_cast<uint32_t>(key >> 32);
+				const uint32_t b = static_cast<uint32_t>(key & 0xffffffffu);
+
+				Quadric q = quadrics[a];
+				q += quadrics[b];
+				const double cost_to_b = q.Evaluate(position(b));
+				const double cost_to_a = q.Evaluate(position(a));
+				collapses.push_back(cost_to_b <= cost_to_a ? Collapse{ a, b, cost_to_b } : Collapse{ b, a, cost_to_a });
+			}
+			std::sort(collapses.begin(), collapses.end(), [](const Collapse& x, const Collapse& y) { return x.Cost < y.Cost; });
+
+			std::iota(collapse_target.begin(), collapse_target.end(), 0u);
+			std::fill(locked.begin(), locked.end(), uint8_t(0));
+
+			const size_t triangles_to_remove = (result.size() - target_index_count + 2) / 3;
+			size_t removed = 0;
+
+			for (const auto& collapse : collapses)
+			{
+				if (removed >= triangles_to_remove)
+					break;
+				if (locked[collapse.From] || locked[collapse.To])
+					continue;
+
+				// Reject collapses that would flip a surviving triangle around the moved vertex
+				const glm::dvec3 from_position = position(collapse.From);
+				const glm::dvec3 to_position = position(collapse.To);
+				bool flips = false;
+				uint32_t collapsed_triangles = 0;
+				for (uint32_t i = adjacency_offsets[collapse.From]; i < adjacency_offsets[collapse.From + 1] && !flips; i++)
+				{
+					const uint32_t* tri = result.data() + adjacency[i] * 3;
+					if (tri[0] == collapse.To || tri[1] == collapse.To || tri[2] == collapse.To)
+					{
+						collapsed_triangles++;
+						continue;
+					}
+
+					glm::dvec3 before[3], after[3];
+					for (uint32_t k = 0; k < 3; k++)
+					{
+						before[k] = tri[k] == collapse.From ? from_position : position(tri[k]);
+						after[k] = tri[k] == collapse.From ? to_position : before[k];
+					}
+					const glm::dvec3 n0 = glm::cross(before[1] - before[0], before[2] - before[0]);
+					const glm::dvec3 n1 = glm::cross(after[1] - after[0], after[2] - after[0]);
+					flips = glm::dot(n0, n1) <= 0.0;
+				}
+				if (flips)
+					continue;
+
+				collapse_target[collapse.From] = collapse.To;
+				quadrics[collapse.To] += quadrics[collapse.From];
+				removed += collapsed_triangles;
+
+				// Neighbours are used by this collapse's flip test, keep them still for the rest of the pass
+				for (uint32_t vertex : { collapse.From, collapse.To })
+				{
+					for (uint32_t i = adjacency_offsets[vertex]; i < adjacency_offsets[vertex + 1]; i++)
+					{
+						const uint32_t* tri = result.data() + adjacency[i] * 3;
+						locked[tri[0]] = locked[tri[1]] = locked[tri[2]] = 1;
+					}
+				}
+			}
+
+			if (removed == 0)
+				break;
+
+			size_t write = 0;
+			for (size_t t = 0; t < triangle_count; t++)
+			{
+				const uint32_t a = collapse_target[result[t * 3]];
+				const uint32_t b = collapse_target[result[t * 3 + 1]];
+				const uint32_t c = collapse_target[result[t * 3 + 2]];
+				if (a == b || b == c || c == a)
+					continue;
+
+				result[write++] = a;
+				result[write++] = b;
+				result[write++] = c;
+			}
+			result.resize(write);
+		}
+
+		return result;
+	}
+}
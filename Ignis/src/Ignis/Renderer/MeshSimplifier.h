@@ -0,0 +1,21 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ignis
+{
+	// Quadric error edge-collapse simplification (Garland & Heckbert). Vertices
+	// collapse onto one of the edge endpoints, so the result indexes the
+	// original vertex buffer and LODs can share it. Open edges, including
+	// attribute seams where vertices are split, are weighted to stay put.
+	class MeshSimplifier
+	{
+	public:
+		// positions is strided so a vertex array can be passed directly, indices must be < vertex_count
+		static std::vector<uint32_t> Simplify(const glm::vec3* positions, size_t vertex_count, size_t stride,
+			const uint32_t* indices, size_t index_count, size_t target_index_count);
+	};
+}
@@ -0,0 +1,329 @@
+#include "OcclusionBuffer.h"
+#include "Mesh.h"
+#include "Ignis/Core/JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#include <xmmintrin.h>
+	#define IGNIS_OCCLUSION_SSE 1
+#elif defined(__ARM_NEON)
+	#include <arm_neon.h>
+	#define IGNIS_OCCLUSION_NEON 1
+#endif
+
+namespace ignis
+{
+	namespace
+	{
+		// Below this the rows are rasterized on the calling thread
+		constexpr size_t k_min_triangles_for_jobs = 256;
+
+		static_assert(OcclusionBuffer::Width % 4 == 0, "Rows are rasterized four pixels at a time");
+		static_assert(OcclusionBuffer::Width % OcclusionBuffer::TileSize == 0);
+		static_assert(OcclusionBuffer::Height % OcclusionBuffer::TileSize == 0);
+
+		bool IsOutside(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c)
+		{
+			return (a.x < -a.w && b.x < -b.w && c.x < -c.w)
+				|| (a.x > a.w && b.x > b.w && c.x > c.w)
+				|| (a.y < -a.w && b.y < -b.w && c.y < -c.w)
+				|| (a.y > a.w && b.y > b.w && c.y > c.w)
+				|| (a.z > a.w && b.z > b.w && c.z > c.w);
+		}
+	}
+
+	OcclusionBuffer::OcclusionBuffer()
+		: m_depth(Width * Height, 0.0f), m_tile_min_depth(TilesX * TilesY, 0.0f)
+	{
+	}
+
+	void OcclusionBuffer::Begin(const glm::mat4& view_projection)
+	{
+		m_view_projection = view_projection;
+		m_triangles.clear();
+		std::fill(m_depth.begin(), m_depth.end(), 0.0f);
+		std::fill(m_tile_min_depth.begin(), m_tile_min_depth.end(), 0.0f);
+	}
+
+	void OcclusionBuffer::AddOccluder(const OccluderMesh& occluder, const glm::mat4& transform)
+	{
+		const glm::mat4 model_view_projection = m_view_projection * transform;
+
+		m_clip_positions.resize(occluder.Positions.size());
+		for (size_t i = 0; i < occluder.Positions.size(); i++)
+			m_clip_positions[i] = model_view_projection * glm::vec4(occluder.Positions[i], 1.0f);
+
+		for (size_t i = 0; i + 2 < occluder.Indices.size(); i += 3)
+		{
+			const glm::vec4& a = m_clip_positions[occluder.Indices[i]];
+			const glm::vec4& b = m_clip_positions[occluder.Indices[i + 1]];
+			const glm::vec4& c = m_clip_positions[occluder.Indices[i + 2]];
+
+			if (IsOutside(a, b, c))
+				continue;
+
+			AddClippedTriangle(a, b, c);
+		}
+	}
+
+	void OcclusionBuffer::AddClippedTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c)
+	{
+		// Distance to the near plane, z >= -w is inside
+		const glm::vec4 in[3] = { a, b, c };
+		const float d[3] = { a.z + a.w, b.z + b.w, c.z + c.w };
+
+		if (d[0] >= 0.0f && d[1] >= 0.0f && d[2] >= 0.0f)
+		{
+			AddScreenTriangle(a, b, c);
+			return;
+		}
+
+		// One plane turns a triangle into at most a quad
+		glm::vec4 out[4];
+		uint32_t count = 0;
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			const uint32_t next = (i + 1) % 3;
+			if (d[i] >= 0.0f)
+				out[count++] = in[i];
+			if ((d[i] >= 0.0f) != (d[next] >= 0.0f))
+				out[count++] = glm::mix(in[i], in[next], d[i] / (d[i] - d[next]));
+		}
+
+		for (uint32_t i = 1; i + 1 < count; i++)
+			AddScreenTriangle(out[0], out[i], out[i + 1]);
+	}
+
+	void OcclusionBuffer::AddScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c)
+	{
+		if (a.w <= 1e-6f || b.w <= 1e-6f || c.w <= 1e-6f)
+			return;
+
+		auto to_screen = [](const glm::vec4& p)
+		{
+			const float inv_w = 1.0f / p.w;
+			return glm::vec3(
+				(p.x * inv_w * 0.5f + 0.5f) * static_cast<float>(Width),
+				(p.y * inv_w * 0.5f + 0.5f) * static_cast<float>(Height),
+				inv_w);
+		};
+
+		glm::vec3 v[3] = { to_screen(a), to_screen(b), to_screen(c) };
+
+		float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[1].y - v[0].y) * (v[2].x - v[0].x);
+		if (std::abs(area) < 1e-8f)
+			return;
+
+		// Both windings occlude, flip clockwise ones so the inside is always positive
+		if (area < 0.0f)
+		{
+			std::swap(v[1], v[2]);
+			area = -area;
+		}
+
+		const float min_x = std::min({ v[0].x, v[1].x, v[2].x });
+		const float max_x = std::max({ v[0].x, v[1].x, v[2].x });
+		const float min_y = std::min({ v[0].y, v[1].y, v[2].y });
+		const float max_y = std::max({ v[0].y, v[1].y, v[2].y });
+		if (max_x < 0.0f || max_y < 0.0f || min_x >= Width || min_y >= Height)
+			return;
+
+		Triangle triangle;
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			const glm::vec3& p0 = v[i];
+			const glm::vec3& p1 = v[(i + 1) % 3];
+			triangle.EdgeA[i] = p0.y - p1.y;
+			triangle.EdgeB[i] = p1.x - p0.x;
+			triangle.EdgeC[i] = -(triangle.EdgeA[i] * p0.x + triangle.EdgeB[i] * p0.y);
+		}
+
+		// Edge i is opposite vertex (i + 2) % 3, so it carries that vertex's barycentric weight
+		const float inv_area = 1.0f / area;
+		triangle.DepthA = (triangle.EdgeA[1] * v[0].z + triangle.EdgeA[2] * v[1].z + triangle.EdgeA[0] * v[2].z) * inv_area;
+		triangle.DepthB = (triangle.EdgeB[1] * v[0].z + triangle.EdgeB[2] * v[1].z + triangle.EdgeB[0] * v[2].z) * inv_area;
+		triangle.DepthC = (triangle.EdgeC[1] * v[0].z + triangle.EdgeC[2] * v[1].z + triangle.EdgeC[0] * v[2].z) * inv_area;
+
+		triangle.MinX = std::clamp(static_cast<int32_t>(std::floor(min_x)), 0, static_cast<int32_t>(Width - 1));
+		triangle.MaxX = std::clamp(static_cast<int32_t>(std::floor(max_x)), 0, static_cast<int32_t>(Width - 1));
+		triangle.MinY = std::clamp(static_cast<int32_t>(std::floor(min_y)), 0, static_cast<int32_t>(Height - 1));
+		triangle.MaxY = std::clamp(static_cast<int32_t>(std::floor(max_y)), 0, static_cast<int32_t>(Height - 1));
+
+		m_triangles.push_back(triangle);
+	}
+
+	void OcclusionBuffer::Rasterize()
+	{
+		if (m_triangles.empty())
+			return;
+
+		// Bands are whole tile rows, so each job also owns the tile minimums it writes
+		const uint32_t min_tile_rows = m_triangles.size() >= k_min_triangles_for_jobs ? 1u : TilesY;
+		JobSystem::ParallelFor("OcclusionBuffer::Rasterize", TilesY, min_tile_rows, [this](uint32_t begin, uint32_t end)
+			{
+				RasterizeRows(begin * TileSize, std::min(end * TileSize, Height));
+			});
+	}
+
+	void OcclusionBuffer::RasterizeRows(uint32_t row_begin, uint32_t row_end)
+	{
+		const int32_t band_min = static_cast<int32_t>(row_begin);
+		const int32_t band_max = static_cast<int32_t>(row_end) - 1;
+
+		for (const auto& triangle : m_triangles)
+		{
+			if (triangle.MaxY < band_min || triangle.MinY > band_max)
+				continue;
+
+			const int32_t y_begin = std::max(triangle.MinY, band_min);
+			const int32_t y_end = std::min(triangle.MaxY, band_max);
+			const int32_t x_begin = triangle.MinX & ~3;
+
+			for (int32_t y = y_begin; y <= y_end; y++)
+			{
+				const float py = static_cast<float>(y) + 0.5f;
+				const float e0_row = triangle.EdgeB[0] * py + triangle.EdgeC[0];
+				const float e1_row = triangle.EdgeB[1] * py + triangle.EdgeC[1];
+				const float e2_row = triangle.EdgeB[2] * py + triangle.EdgeC[2];
+				const float depth_row = triangle.DepthB * py + triangle.DepthC;
+				float* row = m_depth.data() + static_cast<size_t>(y) * Width;
+
+#if defined(IGNIS_OCCLUSION_SSE)
+				const __m128 offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+				const __m128 zero = _mm_setzero_ps();
+				for (int32_t x = x_begin; x <= triangle.MaxX; x += 4)
+				{
+					const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+					const __m128 e0 = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(triangle.EdgeA[0])), _mm_set1_ps(e0_row));
+					const __m128 e1 = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(triangle.EdgeA[1])), _mm_set1_ps(e1_row));
+					const __m128 e2 = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(triangle.EdgeA[2])), _mm_set1_ps(e2_row));
+					const __m128 inside = _mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_and_ps(_mm_cmpge_ps(e1, zero), _mm_cmpge_ps(e2, zero)));
+					if (_mm_movemask_ps(inside) == 0)
+						continue;
+
+					const __m128 depth = _mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(triangle.DepthA)), _mm_set1_ps(depth_row));
+					const __m128 current = _mm_loadu_ps(row + x);
+					const __m128 closest = _mm_max_ps(current, depth);
+					_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, closest), _mm_andnot_ps(inside, current)));
+				}
+#elif defined(IGNIS_OCCLUSION_NEON)
+				const float offset_data[4] = { 0.5f, 1.5f, 2.5f, 3.5f };
+				const float32x4_t offsets = vld1q_f32(offset_data);
+				const float32x4_t zero = vdupq_n_f32(0.0f);
+				for (int32_t x = x_begin; x <= triangle.MaxX; x += 4)
+				{
+					const float32x4_t px = vaddq_f32(vdupq_n_f32(static_cast<float>(x)), offsets);
+					const float32x4_t e0 = vmlaq_n_f32(vdupq_n_f32(e0_row), px, triangle.EdgeA[0]);
+					const float32x4_t e1 = vmlaq_n_f32(vdupq_n_f32(e1_row), px, triangle.EdgeA[1]);
+					const float32x4_t e2 = vmlaq_n_f32(vdupq_n_f32(e2_row), px, triangle.EdgeA[2]);
+					const uint32x4_t inside = vandq_u32(vcgeq_f32(e0, zero), vandq_u32(vcgeq_f32(e1, zero), vcgeq_f32(e2, zero)));
+					if (vmaxvq_u32(inside) == 0)
+						continue;
+
+					const float32x4_t depth = vmlaq_n_f32(vdupq_n_f32(depth_row), px, triangle.DepthA);
+					const float32x4_t current = vld1q_f32(row + x);
+					vst1q_f32(row + x, vbslq_f32(inside, vmaxq_f32(current, depth), current));
+				}
+#else
+				for (int32_t x = triangle.MinX; x <= triangle.MaxX; x++)
+				{
+					const float px = static_cast<float>(x) + 0.5f;
+					if (triangle.EdgeA[0] * px + e0_row < 0.0f
+						|| triangle.EdgeA[1] * px + e1_row < 0.0f
+						|| triangle.EdgeA[2] * px + e2_row < 0.0f)
+						continue;
+
+					row[x] = std::max(row[x], triangle.DepthA * px + depth_row);
+				}
+#endif
+			}
+		}
+
+		for (uint32_t tile_y = row_begin / TileSize; tile_y < row_end / TileSize; tile_y++)
+		{
+			for (uint32_t tile_x = 0; tile_x < TilesX; tile_x++)
+			{
+				float tile_min = FLT_MAX;
+				for (uint32_t y = tile_y * TileSize; y < (tile_y + 1) * TileSize; y++)
+				{
+					const float* row = m_depth.data() + static_cast<size_t>(y) * Width + tile_x * TileSize;
+					for (uint32_t x = 0; x < TileSize; x++)
+						tile_min = std::min(tile_min, row[x]);
+				}
+				m_tile_min_depth[tile_y * TilesX + tile_x] = tile_min;
+			}
+		}
+	}
+
+	bool OcclusionBuffer::IsVisible(const AABB& world_bounds) const
+	{
+		if (m_triangles.empty() || !world_bounds.IsValid())
+			return true;
+
+		glm::vec2 screen_min(FLT_MAX);
+		glm::vec2 screen_max(-FLT_MAX);
+		float closest = 0.0f;
+		for (int i = 0; i < 8; i++)
+		{
+			const glm::vec3 corner(
+				(i & 1) ? world_bounds.Max.x : world_bounds.Min.x,
+				(i & 2) ? world_bounds.Max.y : world_bounds.Min.y,
+				(i & 4) ? world_bounds.Max.z : world_bounds.Min.z);
+
+			const glm::vec4 clip = m_view_projection * glm::vec4(corner, 1.0f);
+			// Boxes reaching the near plane are too close to judge
+			if (clip.z < -clip.w || clip.w <= 1e-6f)
+				return true;
+
+			const float inv_w = 1.0f / clip.w;
+			const glm::vec2 screen(
+				(clip.x * inv_w * 0.5f + 0.5f) * static_cast<float>(Width),
+				(clip.y * inv_w * 0.5f + 0.5f) * static_cast<float>(Height));
+			screen_min = glm::min(screen_min, screen);
+			screen_max = glm::max(screen_max, screen);
+			closest = std::max(closest, inv_w);
+		}
+
+		if (screen_max.x < 0.0f || screen_max.y < 0.0f || screen_min.x >= Width || screen_min.y >= Height)
+			return true;
+
+		const int32_t x0 = std::clamp(static_cast<int32_t>(std::floor(screen_min.x)), 0, static_cast<int32_t>(Width - 1));
+		const int32_t x1 = std::clamp(static_cast<int32_t>(std::floor(screen_max.x)), 0, static_cast<int32_t>(Width - 1));
+		const int32_t y0 = std::clamp(static_cast<int32_t>(std::floor(screen_min.y)), 0, static_cast<int32_t>(Height - 1));
+		const int32_t y1 = std::clamp(static_cast<int32_t>(std::floor(screen_max.y)), 0, static_cast<int32_t>(Height - 1));
+
+		const int32_t tile_size = static_cast<int32_t>(TileSize);
+		for (int32_t tile_y = y0 / tile_size; tile_y <= y1 / tile_size; tile_y++)
+		{
+			for (int32_t tile_x = x0 / tile_size; tile_x <= x1 / tile_size; tile_x++)
+			{
+				const int32_t px0 = std::max(tile_x * tile_size, x0);
+				const int32_t px1 = std::min(tile_x * tile_size + tile_size - 1, x1);
+				const int32_t py0 = std::max(tile_y * tile_size, y0);
+				const int32_t py1 = std::min(tile_y * tile_size + tile_size - 1, y1);
+
+				// Every pixel of this tile is closer than the box
+				if (m_tile_min_depth[tile_y * TilesX + tile_x] > closest)
+					continue;
+
+				const bool whole_tile = px1 - px0 + 1 == tile_size && py1 - py0 + 1 == tile_size;
+				if (whole_tile)
+					return true;
+
+				for (int32_t y = py0; y <= py1; y++)
+				{
+					const float* row = m_depth.data() + static_cast<size_t>(y) * Width;
+					for (int32_t x = px0; x <= px1; x++)
+					{
+						if (row[x] <= closest)
+							return true;
+					}
+				}
+			}
+		}
+
+		return false;
+	}
+}
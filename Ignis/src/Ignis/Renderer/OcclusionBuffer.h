@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Bounds.h"
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ignis
+{
+	struct OccluderMesh;
+
+	// Small CPU depth buffer for occlusion culling. Occluder triangles are
+	// rasterized into it, then draw bounds are tested against it before
+	// submission. Depth is stored as 1/w, so larger is closer and the buffer
+	// clears to 0 (nothing occludes). Needs no graphics context.
+	class OcclusionBuffer
+	{
+	public:
+		static constexpr uint32_t Width = 256;
+		static constexpr uint32_t Height = 128;
+		static constexpr uint32_t TileSize = 8;
+		static constexpr uint32_t TilesX = Width / TileSize;
+		static constexpr uint32_t TilesY = Height / TileSize;
+
+		OcclusionBuffer();
+
+		// Clears the buffer and drops all occluders
+		void Begin(const glm::mat4& view_projection);
+
+		void AddOccluder(const OccluderMesh& occluder, const glm::mat4& transform);
+		// Rasterizes everything added since Begin, split across threads for large occluder sets
+		void Rasterize();
+
+		// False only when the box is behind rasterized occluders everywhere it covers
+		bool IsVisible(const AABB& world_bounds) const;
+
+		bool HasOccluders() const { return !m_triangles.empty(); }
+		uint32_t GetTriangleCount() const { return static_cast<uint32_t>(m_triangles.size()); }
+		const std::vector<float>& GetDepth() const { return m_depth; }
+
+	private:
+		struct Triangle
+		{
+			// Edge functions A*x + B*y + C, positive inside
+			float EdgeA[3];
+			float EdgeB[3];
+			float EdgeC[3];
+			// 1/w as a plane over screen space
+			float DepthA, DepthB, DepthC;
+			int32_t MinX, MinY, MaxX, MaxY;
+		};
+
+		void AddClippedTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+		void AddScreenTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+		void RasterizeRows(uint32_t row_begin, uint32_t row_end);
+
+	private:
+		glm::mat4 m_view_projection{ 1.0f };
+		std::vector<Triangle> m_triangles;
+		std::vector<glm::vec4> m_clip_positions;
+
+		std::vector<float> m_depth;
+		// Farthest depth per tile, lets most of a box test skip the per-pixel loop
+		std::vector<float> m_tile_min_depth;
+	};
+}
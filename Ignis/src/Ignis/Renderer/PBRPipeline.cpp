@@ -1,4 +1,5 @@
 #include "PBRPipeline.h"
+#include "PBRUniforms.h"
 #include "Ignis/Asset/AssetManager.h"
 #include "Renderer.h"
 #include "Environment.h"
@@ -6,6 +7,20 @@
 
 namespace ignis
 {
+	namespace
+	{
+		// Edited materials leave stale entries behind, drop everything once this is exceeded
+		constexpr size_t kMaxCachedMaterials = 4096;
+
+		namespace skybox_uniforms
+		{
+			SamplerHandle EnvironmentMap("environmentMap");
+			UniformHandle EnvRotation("envRotation");
+			UniformHandle EnvIntensity("envIntensity");
+			UniformHandle EnvTint("envTint");
+		}
+	}
+
 	PBRPipeline::PBRPipeline(ShaderLibrary& shader_library)
 		: m_shader_library(shader_library)
 	{
@@ -15,140 +30,185 @@ namespace ignis
 
 	std::shared_ptr<Material> PBRPipeline::CreateMaterial(const MaterialData& data)
 	{
-		auto material = Material::Create(m_shader_library.Get("IgnisPBR"));
+		return CreateMaterial(data, m_shader_library.Get("IgnisPBR"));
+	}
+
+	std::shared_ptr<Material> PBRPipeline::CreateMaterial(const MaterialData& data, const std::shared_ptr<Shader>& shader)
+	{
+		auto material = Material::Create(shader);
 
 		// --- Albedo ---
 		auto albedo = AssetManager::GetAsset<Texture2D>(data.AlbedoMap);
-		material->Set("material.albedoMap", albedo ? albedo : Renderer::GetWhiteTexture());
-		material->Set("material.albedoColor", data.AlbedoColor);
+		material->Set(pbr_uniforms::AlbedoMap, albedo ? albedo : Renderer::GetWhiteTexture());
+		material->Set(pbr_uniforms::AlbedoColor, data.AlbedoColor);
 
 		// --- Normal ---
 		auto normal = AssetManager::GetAsset<Texture2D>(data.NormalMap);
-		material->Set("material.normalMap", normal ? normal : Renderer::GetDefaultNormalTexture());
+		material->Set(pbr_uniforms::NormalMap, normal ? normal : Renderer::GetDefaultNormalTexture());
 
 		// --- Metalness ---
 		auto metalness = AssetManager::GetAsset<Texture2D>(data.MetalnessMap);
-		material->Set("material.metallicMap", metalness ? metalness : Renderer::GetBlackTexture());
-		material->Set("material.metallicValue", data.MetallicValue);
+		material->Set(pbr_uniforms::MetallicMap, metalness ? metalness : Renderer::GetBlackTexture());
+		material->Set(pbr_uniforms::MetallicValue, data.MetallicValue);
 
 		// --- Roughness ---
 		auto roughness = AssetManager::GetAsset<Texture2D>(data.RoughnessMap);
-		material->Set("material.roughnessMap", roughness ? roughness : Renderer::GetDefaultRoughnessTexture());
-		material->Set("material.roughnessValue", data.RoughnessValue);
+		material->Set(pbr_uniforms::RoughnessMap, roughness ? roughness : Renderer::GetDefaultRoughnessTexture());
+		material->Set(pbr_uniforms::RoughnessValue, data.RoughnessValue);
 
 		// --- Emissive ---
 		auto emissive = AssetManager::GetAsset<Texture2D>(data.EmissiveMap);
-		material->Set("material.emissiveMap", emissive ? emissive : Renderer::GetBlackTexture());
-		material->Set("material.emissiveColor", data.EmissiveColor);
-		material->Set("material.emissiveIntensity", data.EmissiveIntensity);
+		material->Set(pbr_uniforms::EmissiveMap, emissive ? emissive : Renderer::GetBlackTexture());
+		material->Set(pbr_uniforms::EmissiveColor, data.EmissiveColor);
+		material->Set(pbr_uniforms::EmissiveIntensity, data.EmissiveIntensity);
 
 		// --- AO ---
 		auto ao = AssetManager::GetAsset<Texture2D>(data.AOMap);
-		material->Set("material.aoMap", ao ? ao : Renderer::GetWhiteTexture());
+		material->Set(pbr_uniforms::AOMap, ao ? ao : Renderer::GetWhiteTexture());
 
 		// --- Clearcoat ---
 		auto clearcoatMap = AssetManager::GetAsset<Texture2D>(data.ClearcoatMap);
-		material->Set("material.clearcoatMap", clearcoatMap ? clearcoatMap : Renderer::GetWhiteTexture());
-		material->Set("material.clearcoatFactor", data.ClearcoatFactor);
+		material->Set(pbr_uniforms::ClearcoatMap, clearcoatMap ? clearcoatMap : Renderer::GetWhiteTexture());
+		material->Set(pbr_uniforms::ClearcoatFactor, data.ClearcoatFactor);
 
 		auto clearcoatRoughnessMap = AssetManager::GetAsset<Texture2D>(data.ClearcoatRoughnessMap);
-		material->Set("material.clearcoatRoughnessMap", clearcoatRoughnessMap ? clearcoatRoughnessMap : Renderer::GetWhiteTexture());
-		material->Set("material.clearcoatRoughnessFactor", data.ClearcoatRoughnessFactor);
+		material->Set(pbr_uniforms::ClearcoatRoughnessMap, clearcoatRoughnessMap ? clearcoatRoughnessMap : Renderer::GetWhiteTexture());
+		material->Set(pbr_uniforms::ClearcoatRoughnessFactor, data.ClearcoatRoughnessFactor);
 
 		auto clearcoatNormalMap = AssetManager::GetAsset<Texture2D>(data.ClearcoatNormalMap);
-		material->Set("material.clearcoatNormalMap", clearcoatNormalMap ? clearcoatNormalMap : Renderer::GetDefaultNormalTexture());
-
-		material->Set("uv_albedoMap", (int)data.AlbedoMapUVIndex);
-		material->Set("uv_normalMap", (int)data.NormalMapUVIndex);
-		material->Set("uv_metallicMap", (int)data.MetalnessMapUVIndex);
-		material->Set("uv_roughnessMap", (int)data.RoughnessMapUVIndex);
-		material->Set("uv_emissiveMap", (int)data.EmissiveMapUVIndex);
-		material->Set("uv_aoMap", (int)data.AOMapUVIndex);
-		material->Set("uv_clearcoatMap", (int)data.ClearcoatMapUVIndex);
-		material->Set("uv_clearcoatRoughnessMap", (int)data.ClearcoatRoughnessMapUVIndex);
-		material->Set("uv_clearcoatNormalMap", (int)data.ClearcoatNormalMapUVIndex);
-
-		material->Set("ch_metallic", data.MetallicChannel);
-		material->Set("ch_roughness", data.RoughnessChannel);
-
-		material->Set("uvT_albedoMap", data.AlbedoMapUVTransform.ToMatrix());
-		material->Set("uvT_normalMap", data.NormalMapUVTransform.ToMatrix());
-		material->Set("uvT_metallicMap", data.MetalnessMapUVTransform.ToMatrix());
-		material->Set("uvT_roughnessMap", data.RoughnessMapUVTransform.ToMatrix());
-		material->Set("uvT_emissiveMap", data.EmissiveMapUVTransform.ToMatrix());
-		material->Set("uvT_aoMap", data.AOMapUVTransform.ToMatrix());
-		material->Set("uvT_clearcoatMap", data.ClearcoatMapUVTransform.ToMatrix());
-		material->Set("uvT_clearcoatRoughnessMap", data.ClearcoatRoughnessMapUVTransform.ToMatrix());
-		material->Set("uvT_clearcoatNormalMap", data.ClearcoatNormalMapUVTransform.ToMatrix());
+		material->Set(pbr_uniforms::ClearcoatNormalMap, clearcoatNormalMap ? clearcoatNormalMap : Renderer::GetDefaultNormalTexture());
+
+		material->Set(pbr_uniforms::UVAlbedoMap, (int)data.AlbedoMapUVIndex);
+		material->Set(pbr_uniforms::UVNormalMap, (int)data.NormalMapUVIndex);
+		material->Set(pbr_uniforms::UVMetallicMap, (int)data.MetalnessMapUVIndex);
+		material->Set(pbr_uniforms::UVRoughnessMap, (int)data.RoughnessMapUVIndex);
+		material->Set(pbr_uniforms::UVEmissiveMap, (int)data.EmissiveMapUVIndex);
+		material->Set(pbr_uniforms::UVAOMap, (int)data.AOMapUVIndex);
+		material->Set(pbr_uniforms::UVClearcoatMap, (int)data.ClearcoatMapUVIndex);
+		material->Set(pbr_uniforms::UVClearcoatRoughnessMap, (int)data.ClearcoatRoughnessMapUVIndex);
+		material->Set(pbr_uniforms::UVClearcoatNormalMap, (int)data.ClearcoatNormalMapUVIndex);
+
+		material->Set(pbr_uniforms::ChannelMetallic, data.MetallicChannel);
+		material->Set(pbr_uniforms::ChannelRoughness, data.RoughnessChannel);
+
+		material->Set(pbr_uniforms::UVTransformAlbedoMap, data.AlbedoMapUVTransform.ToMatrix());
+		material->Set(pbr_uniforms::UVTransformNormalMap, data.NormalMapUVTransform.ToMatrix());
+		material->Set(pbr_uniforms::UVTransformMetallicMap, data.MetalnessMapUVTransform.ToMatrix());
+		material->Set(pbr_uniforms::UVTransformRoughnessMap, data.RoughnessMapUVTransform.ToMatrix());
+		material->Set(pbr_uniforms::UVTransformEmissiveMap, data.EmissiveMapUVTransform.ToMatrix());
+		material->Set(pbr_uniforms::UVTransformAOMap, data.AOMapUVTransform.ToMatrix());
+		material->Set(pbr_uniforms::UVTransformClearcoatMap, data.ClearcoatMapUVTransform.ToMatrix());
+		material->Set(pbr_uniforms::UVTransformClearcoatRoughnessMap, data.ClearcoatRoughnessMapUVTransform.ToMatrix());
+		material->Set(pbr_uniforms::UVTransformClearcoatNormalMap, data.ClearcoatNormalMapUVTransform.ToMatrix());
 
 		return material;
 	}
 
-	void PBRPipeline::ApplyEnvironment(Material& material,
-		const Environment& scene_environment,
-		const EnvironmentSettings& environment_settings,
-		const LightEnvironment& light_environment)
+	std::shared_ptr<Material> PBRPipeline::GetMaterial(const MaterialData& data, const Environment& scene_environment,
+		const EnvironmentSettings& environment_settings)
+	{
+		return GetCachedMaterial(data, false, scene_environment, environment_settings);
+	}
+
+	std::shared_ptr<Material> PBRPipeline::GetInstancedMaterial(const MaterialData& data, const Environment& scene_environment,
+		const EnvironmentSettings& environment_settings)
+	{
+		return GetCachedMaterial(data, true, scene_environment, environment_settings);
+	}
+
+	std::shared_ptr<Material> PBRPipeline::GetDepthMaterial(bool instanced)
+	{
+		auto& material = m_depth_materials[instanced ? 1 : 0];
+		if (!material)
+			material = Material::Create(m_shader_library.Get(instanced ? "DepthPrepass_Instanced" : "DepthPrepass"));
+		return material;
+	}
+
+	std::shared_ptr<Material> PBRPipeline::GetCachedMaterial(const MaterialData& data, bool instanced, const Environment& scene_environment,
+		const EnvironmentSettings& environment_settings)
 	{
-		material.Set("numDirectionalLights", (int)light_environment.DirectionalLights.size());
-		for (size_t i = 0; i < light_environment.DirectionalLights.size(); i++)
+		// Texture handles resolve to different assets after a reimport/unload
+		if (m_asset_generation != AssetManager::GetGeneration())
 		{
-			std::string base = "directionalLights[" + std::to_string(i) + "]";
-			material.Set(base + ".direction", light_environment.DirectionalLights[i].Direction);
-			material.Set(base + ".radiance", light_environment.DirectionalLights[i].Radiance);
+			ClearMaterialCache();
+			m_asset_generation = AssetManager::GetGeneration();
 		}
 
-		material.Set("numPointLights", (int)light_environment.PointLights.size());
-		for (size_t i = 0; i < light_environment.PointLights.size(); i++)
+		auto& material_cache = m_material_caches[instanced ? 1 : 0];
+		std::size_t environment_key = ComputeEnvironmentKey(scene_environment, environment_settings);
+
+		auto it = material_cache.find(data);
+		if (it == material_cache.end())
 		{
-			std::string base = "pointLights[" + std::to_string(i) + "]";
-			material.Set(base + ".position", light_environment.PointLights[i].Position);
-			material.Set(base + ".radiance", light_environment.PointLights[i].Radiance);
-			material.Set(base + ".constant", light_environment.PointLights[i].Constant);
-			material.Set(base + ".linear", light_environment.PointLights[i].Linear);
-			material.Set(base + ".quadratic", light_environment.PointLights[i].Quadratic);
+			if (material_cache.size() >= kMaxCachedMaterials)
+				material_cache.clear();
+
+			auto material = CreateMaterial(data, m_shader_library.Get(instanced ? "IgnisPBR_Instanced" : "IgnisPBR"));
+			ApplyEnvironment(*material, scene_environment, environment_settings);
+			it = material_cache.emplace(data, CachedMaterial{ material, environment_key }).first;
+		}
+		else if (it->second.EnvironmentKey != environment_key)
+		{
+			ApplyEnvironment(*it->second.MaterialPtr, scene_environment, environment_settings);
+			it->second.EnvironmentKey = environment_key;
 		}
 
-		material.Set("numSpotLights", (int)light_environment.SpotLights.size());
-		for (size_t i = 0; i < light_environment.SpotLights.size(); i++)
+		return it->second.MaterialPtr;
+	}
+
+	std::size_t PBRPipeline::ComputeEnvironmentKey(const Environment& scene_environment,
+		const EnvironmentSettings& environment_settings)
+	{
+		// Lights live in the LightData uniform block, only IBL inputs are material state
+		std::size_t seed = 0;
+		const auto& ibl_maps = scene_environment.GetIBLMaps();
+		if (ibl_maps)
 		{
-			std::string base = "spotLights[" + std::to_string(i) + "]";
-			material.Set(base + ".position", light_environment.SpotLights[i].Position);
-			material.Set(base + ".direction", light_environment.SpotLights[i].Direction);
-			material.Set(base + ".radiance", light_environment.SpotLights[i].Radiance);
-			material.Set(base + ".constant", light_environment.SpotLights[i].Constant);
-			material.Set(base + ".linear", light_environment.SpotLights[i].Linear);
-			material.Set(base + ".quadratic", light_environment.SpotLights[i].Quadratic);
-			material.Set(base + ".cutOff", light_environment.SpotLights[i].CutOff);
-			material.Set(base + ".outerCutOff", light_environment.SpotLights[i].OuterCutOff);
+			HashCombine(seed, static_cast<const void*>(ibl_maps->IrradianceMap.get()));
+			HashCombine(seed, static_cast<const void*>(ibl_maps->PrefilteredMap.get()));
+			HashCombine(seed, static_cast<const void*>(ibl_maps->BrdfLUT.get()));
+			HashCombine(seed, ibl_maps->PrefilterMipLevels);
 		}
 
+		HashCombine(seed, environment_settings.Intensity);
+		HashCombine(seed, environment_settings.Rotation);
+		HashCombine(seed, environment_settings.Tint.r);
+		HashCombine(seed, environment_settings.Tint.g);
+		HashCombine(seed, environment_settings.Tint.b);
+		return seed;
+	}
+
+	void PBRPipeline::ApplyEnvironment(Material& material,
+		const Environment& scene_environment,
+		const EnvironmentSettings& environment_settings)
+	{
 		const auto& ibl_maps = scene_environment.GetIBLMaps();
 		if (ibl_maps)
 		{
 			if (ibl_maps->IrradianceMap)
-				material.Set("irradianceMap", ibl_maps->IrradianceMap);
+				material.Set(pbr_uniforms::IrradianceMap, ibl_maps->IrradianceMap);
 
 			if (ibl_maps->PrefilteredMap)
-				material.Set("prefilterMap", ibl_maps->PrefilteredMap);
+				material.Set(pbr_uniforms::PrefilterMap, ibl_maps->PrefilteredMap);
 
-			material.Set("brdfLUT", ibl_maps->BrdfLUT ? ibl_maps->BrdfLUT : m_brdf_lut_texture);
+			material.Set(pbr_uniforms::BrdfLUT, ibl_maps->BrdfLUT ? ibl_maps->BrdfLUT : m_brdf_lut_texture);
 
 			float max_lod = (ibl_maps->PrefilterMipLevels > 0)
 				? float(ibl_maps->PrefilterMipLevels - 1)
 				: 0.0f;
-			material.Set("prefilterMaxLod", max_lod);
+			material.Set(pbr_uniforms::PrefilterMaxLod, max_lod);
 		}
 		else
 		{
-			material.Set("irradianceMap", Renderer::GetBlackTextureCube());
-			material.Set("prefilterMap", Renderer::GetBlackTextureCube());
-			material.Set("brdfLUT", m_brdf_lut_texture);
-			material.Set("prefilterMaxLod", 0.0f);
+			material.Set(pbr_uniforms::IrradianceMap, Renderer::GetBlackTextureCube());
+			material.Set(pbr_uniforms::PrefilterMap, Renderer::GetBlackTextureCube());
+			material.Set(pbr_uniforms::BrdfLUT, m_brdf_lut_texture);
+			material.Set(pbr_uniforms::PrefilterMaxLod, 0.0f);
 		}
 
-		material.Set("envSettings.intensity", environment_settings.Intensity);
-		material.Set("envSettings.rotation", environment_settings.Rotation);
-		material.Set("envSettings.tint", environment_settings.Tint);
+		material.Set(pbr_uniforms::EnvIntensity, environment_settings.Intensity);
+		material.Set(pbr_uniforms::EnvRotation, environment_settings.Rotation);
+		material.Set(pbr_uniforms::EnvTint, environment_settings.Tint);
 	}
 
 	std::shared_ptr<Material> PBRPipeline::CreateSkyboxMaterial(const Environment& scene_environment, 
@@ -158,11 +218,11 @@ namespace ignis
 
 		const auto& skybox_map = scene_environment.GetSkyboxMap();
 		if (skybox_map)
-			material->Set("environmentMap", skybox_map);
+			material->Set(skybox_uniforms::EnvironmentMap, skybox_map);
 
-		material->Set("envRotation", environment_settings.Rotation);
-		material->Set("envIntensity", environment_settings.Intensity);
-		material->Set("envTint", environment_settings.Tint);
+		material->Set(skybox_uniforms::EnvRotation, environment_settings.Rotation);
+		material->Set(skybox_uniforms::EnvIntensity, environment_settings.Intensity);
+		material->Set(skybox_uniforms::EnvTint, environment_settings.Tint);
 
 		return material;
 	}
@@ -13,14 +13,40 @@ namespace ignis
 		~PBRPipeline() = default;
 
 		std::shared_ptr<Material> CreateMaterial(const MaterialData& data) override;
-		void ApplyEnvironment(Material& material, const Environment& scene_environment, const EnvironmentSettings& environment_settings, const LightEnvironment& light_environment) override;
+		std::shared_ptr<Material> GetMaterial(const MaterialData& data, const Environment& scene_environment,
+			const EnvironmentSettings& environment_settings) override;
+		std::shared_ptr<Material> GetInstancedMaterial(const MaterialData& data, const Environment& scene_environment,
+			const EnvironmentSettings& environment_settings) override;
+		std::shared_ptr<Material> GetDepthMaterial(bool instanced) override;
+		void ApplyEnvironment(Material& material, const Environment& scene_environment, const EnvironmentSettings& environment_settings) override;
 		std::shared_ptr<Material> CreateSkyboxMaterial(const Environment& scene_environment,
 			const EnvironmentSettings& environment_settings) override;
 		std::shared_ptr<Shader> GetStandardShader() override;
 		std::shared_ptr<Shader> GetSkyboxShader() override;
 
+		void ClearMaterialCache() { m_material_caches[0].clear(); m_material_caches[1].clear(); }
+
 	private:
+		struct CachedMaterial
+		{
+			std::shared_ptr<Material> MaterialPtr;
+			std::size_t EnvironmentKey = 0;
+		};
+
+		std::shared_ptr<Material> CreateMaterial(const MaterialData& data, const std::shared_ptr<Shader>& shader);
+		std::shared_ptr<Material> GetCachedMaterial(const MaterialData& data, bool instanced, const Environment& scene_environment,
+			const EnvironmentSettings& environment_settings);
+
+		static std::size_t ComputeEnvironmentKey(const Environment& scene_environment,
+			const EnvironmentSettings& environment_settings);
+
 		ShaderLibrary& m_shader_library;
 		std::shared_ptr<Texture2D> m_brdf_lut_texture;
+
+		// Indexed by instanced, keyed by the full MaterialData so a hash collision is never a hit
+		std::unordered_map<MaterialData, CachedMaterial> m_material_caches[2];
+		// Indexed by instanced
+		std::shared_ptr<Material> m_depth_materials[2];
+		uint64_t m_asset_generation = 0;
 	};
 }
\ No newline at end of file
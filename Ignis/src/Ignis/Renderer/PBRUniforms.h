@@ -0,0 +1,56 @@
+#pragma once
+
+#include "UniformHandle.h"
+
+namespace ignis
+{
+	// Shared by every IgnisPBR variant and by everything that draws with them,
+	// so each name resolves through one handle per shader
+	namespace pbr_uniforms
+	{
+		inline UniformHandle Model("model");
+		inline SamplerHandle AlbedoMap("material.albedoMap");
+		inline UniformHandle AlbedoColor("material.albedoColor");
+		inline SamplerHandle NormalMap("material.normalMap");
+		inline SamplerHandle MetallicMap("material.metallicMap");
+		inline UniformHandle MetallicValue("material.metallicValue");
+		inline SamplerHandle RoughnessMap("material.roughnessMap");
+		inline UniformHandle RoughnessValue("material.roughnessValue");
+		inline SamplerHandle EmissiveMap("material.emissiveMap");
+		inline UniformHandle EmissiveColor("material.emissiveColor");
+		inline UniformHandle EmissiveIntensity("material.emissiveIntensity");
+		inline SamplerHandle AOMap("material.aoMap");
+		inline SamplerHandle ClearcoatMap("material.clearcoatMap");
+		inline UniformHandle ClearcoatFactor("material.clearcoatFactor");
+		inline SamplerHandle ClearcoatRoughnessMap("material.clearcoatRoughnessMap");
+		inline UniformHandle ClearcoatRoughnessFactor("material.clearcoatRoughnessFactor");
+		inline SamplerHandle ClearcoatNormalMap("material.clearcoatNormalMap");
+		inline UniformHandle UVAlbedoMap("uv_albedoMap");
+		inline UniformHandle UVNormalMap("uv_normalMap");
+		inline UniformHandle UVMetallicMap("uv_metallicMap");
+		inline UniformHandle UVRoughnessMap("uv_roughnessMap");
+		inline UniformHandle UVEmissiveMap("uv_emissiveMap");
+		inline UniformHandle UVAOMap("uv_aoMap");
+		inline UniformHandle UVClearcoatMap("uv_clearcoatMap");
+		inline UniformHandle UVClearcoatRoughnessMap("uv_clearcoatRoughnessMap");
+		inline UniformHandle UVClearcoatNormalMap("uv_clearcoatNormalMap");
+		inline UniformHandle ChannelMetallic("ch_metallic");
+		inline UniformHandle ChannelRoughness("ch_roughness");
+		inline UniformHandle UVTransformAlbedoMap("uvT_albedoMap");
+		inline UniformHandle UVTransformNormalMap("uvT_normalMap");
+		inline UniformHandle UVTransformMetallicMap("uvT_metallicMap");
+		inline UniformHandle UVTransformRoughnessMap("uvT_roughnessMap");
+		inline UniformHandle UVTransformEmissiveMap("uvT_emissiveMap");
+		inline UniformHandle UVTransformAOMap("uvT_aoMap");
+		inline UniformHandle UVTransformClearcoatMap("uvT_clearcoatMap");
+		inline UniformHandle UVTransformClearcoatRoughnessMap("uvT_clearcoatRoughnessMap");
+		inline UniformHandle UVTransformClearcoatNormalMap("uvT_clearcoatNormalMap");
+		inline SamplerHandle IrradianceMap("irradianceMap");
+		inline SamplerHandle PrefilterMap("prefilterMap");
+		inline SamplerHandle BrdfLUT("brdfLUT");
+		inline UniformHandle PrefilterMaxLod("prefilterMaxLod");
+		inline UniformHandle EnvIntensity("envSettings.intensity");
+		inline UniformHandle EnvRotation("envSettings.rotation");
+		inline UniformHandle EnvTint("envSettings.tint");
+	}
+}
@@ -7,7 +7,6 @@ namespace ignis
 {
 	class Environment;
 	struct EnvironmentSettings;
-	struct LightEnvironment;
 
 	class Pipeline
 	{	
@@ -15,7 +14,15 @@ namespace ignis
 		virtual ~Pipeline() = default;
 
 		virtual std::shared_ptr<Material> CreateMaterial(const MaterialData& data) = 0;
-		virtual void ApplyEnvironment(Material& material, const Environment& scene_environment, const EnvironmentSettings& environment_settings, const LightEnvironment& light_environment) = 0;
+		// Returns a cached material for data with the environment already applied
+		virtual std::shared_ptr<Material> GetMaterial(const MaterialData& data, const Environment& scene_environment,
+			const EnvironmentSettings& environment_settings) = 0;
+		// Same as GetMaterial but built on the shader variant that reads the model matrix per instance
+		virtual std::shared_ptr<Material> GetInstancedMaterial(const MaterialData& data, const Environment& scene_environment,
+			const EnvironmentSettings& environment_settings) = 0;
+		// Position-only material for depth pre-pass draws, shared by every mesh
+		virtual std::shared_ptr<Material> GetDepthMaterial(bool instanced) = 0;
+		virtual void ApplyEnvironment(Material& material, const Environment& scene_environment, const EnvironmentSettings& environment_settings) = 0;
 		virtual std::shared_ptr<Material> CreateSkyboxMaterial(const Environment& scene_environment,
 			const EnvironmentSettings& environment_settings) = 0;
 		virtual std::shared_ptr<Shader> GetStandardShader() = 0;
@@ -0,0 +1,117 @@
+#include "RenderQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace ignis
+{
+	namespace SortKey
+	{
+		namespace
+		{
+			constexpr uint32_t k_pass_shift = 62;
+
+			constexpr uint64_t Mask(uint32_t value, uint32_t bits)
+			{
+				return static_cast<uint64_t>(value) & ((uint64_t(1) << bits) - 1);
+			}
+
+			// Depth beyond this lands in the last bucket
+			constexpr float k_max_depth = 10000.0f;
+		}
+
+		uint64_t Opaque(uint32_t shader, uint32_t material, uint32_t mesh, uint16_t depth)
+		{
+			uint64_t key = static_cast<uint64_t>(RenderPass::Opaque) << k_pass_shift;
+			key |= Mask(shader, ShaderBits) << (MaterialBits + MeshBits + DepthBits);
+			key |= Mask(material, MaterialBits) << (MeshBits + DepthBits);
+			key |= Mask(mesh, MeshBits) << DepthBits;
+			key |= depth;
+			return key;
+		}
+
+		uint64_t Transparent(uint16_t depth, uint32_t shader, uint32_t material, uint32_t mesh)
+		{
+			uint64_t key = static_cast<uint64_t>(RenderPass::Transparent) << k_pass_shift;
+			key |= static_cast<uint64_t>(static_cast<uint16_t>(~depth)) << (ShaderBits + MaterialBits + MeshBits);
+			key |= Mask(shader, ShaderBits) << (MaterialBits + MeshBits);
+			key |= Mask(material, MaterialBits) << MeshBits;
+			key |= Mask(mesh, MeshBits);
+			return key;
+		}
+
+		uint64_t Sequential(RenderPass pass, uint32_t sequence)
+		{
+			return (static_cast<uint64_t>(pass) << k_pass_shift) | sequence;
+		}
+
+		uint64_t Text(uint32_t font, uint32_t sequence)
+		{
+			return Sequential(RenderPass::Text, sequence) | (Mask(font, FontBits) << 32);
+		}
+
+		RenderPass GetPass(uint64_t key)
+		{
+			return static_cast<RenderPass>(key >> k_pass_shift);
+		}
+
+		uint16_t QuantizeDepth(float view_depth)
+		{
+			if (!(view_depth > 0.0f))
+				return 0;
+
+			static const float s_scale = 65535.0f / std::log2(1.0f + k_max_depth);
+			const float q = std::log2(1.0f + std::min(view_depth, k_max_depth)) * s_scale;
+			return static_cast<uint16_t>(std::min(q, 65535.0f));
+		}
+	}
+
+	void RenderQueue::Sort()
+	{
+		const size_t count = m_entries.size();
+		if (count < 2)
+			return;
+
+		constexpr uint32_t k_digits = 8;
+		std::array<std::array<uint32_t, 256>, k_digits> histograms{};
+
+		for (const auto& entry : m_entries)
+		{
+			for (uint32_t d = 0; d < k_digits; d++)
+				histograms[d][(entry.Key >> (d * 8)) & 0xFF]++;
+		}
+
+		m_scratch.resize(count);
+		Entry* src = m_entries.data();
+		Entry* dst = m_scratch.data();
+
+		for (uint32_t d = 0; d < k_digits; d++)
+		{
+			auto& histogram = histograms[d];
+
+			// Every key has the same digit here, this pass would not move anything
+			if (histogram[(src[0].Key >> (d * 8)) & 0xFF] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (auto& bucket : histogram)
+			{
+				const uint32_t bucket_count = bucket;
+				bucket = offset;
+				offset += bucket_count;
+			}
+
+			for (size_t i = 0; i < count; i++)
+			{
+				const uint32_t digit = (src[i].Key >> (d * 8)) & 0xFF;
+				dst[histogram[digit]++] = src[i];
+			}
+
+			std::swap(src, dst);
+		}
+
+		if (src != m_entries.data())
+			m_entries.swap(m_scratch);
+	}
+}
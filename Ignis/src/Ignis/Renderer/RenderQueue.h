@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ignis
+{
+	// Highest bits of a sort key, commands are flushed in this order
+	enum class RenderPass : uint8_t
+	{
+		Opaque = 0,
+		Skybox,
+		Transparent,
+		Text,
+	};
+
+	// 64-bit keys, most significant field first:
+	//   Opaque:      pass(2) | shader(10) | material(18) | mesh(18) | depth(16)
+	//   Transparent: pass(2) | ~depth(16) | shader(10) | material(18) | mesh(18)
+	//   Text:        pass(2) | font(16) | submission order(32)
+	//   Others:      pass(2) | submission order(32)
+	// Opaque keys group by state and go front to back inside a group,
+	// transparent keys are back to front first so blending stays correct.
+	namespace SortKey
+	{
+		inline constexpr uint32_t ShaderBits = 10;
+		inline constexpr uint32_t MaterialBits = 18;
+		inline constexpr uint32_t MeshBits = 18;
+		inline constexpr uint32_t DepthBits = 16;
+		inline constexpr uint32_t FontBits = 16;
+
+		uint64_t Opaque(uint32_t shader, uint32_t material, uint32_t mesh, uint16_t depth);
+		uint64_t Transparent(uint16_t depth, uint32_t shader, uint32_t material, uint32_t mesh);
+		uint64_t Sequential(RenderPass pass, uint32_t sequence);
+		// Strings sharing a font atlas sort together so they can be drawn as one batch
+		uint64_t Text(uint32_t font, uint32_t sequence);
+
+		RenderPass GetPass(uint64_t key);
+		// Maps a view-space distance to 16 bits, more precision close to the camera
+		uint16_t QuantizeDepth(float view_depth);
+	}
+
+	class RenderQueue
+	{
+	public:
+		struct Entry
+		{
+			uint64_t Key = 0;
+			uint32_t Index = 0;
+		};
+
+		void Clear() { m_entries.clear(); }
+		void Push(uint64_t key, uint32_t index) { m_entries.push_back({ key, index }); }
+
+		// Stable LSD radix sort over 8-bit digits, digits shared by every key are skipped
+		void Sort();
+
+		const std::vector<Entry>& GetEntries() const { return m_entries; }
+		bool IsEmpty() const { return m_entries.empty(); }
+
+	private:
+		std::vector<Entry> m_entries;
+		std::vector<Entry> m_scratch;
+	};
+}
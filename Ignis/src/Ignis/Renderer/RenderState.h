@@ -1,5 +1,6 @@
 #pragma once
 #include "Ignis/Core/API.h"
+#include "MaterialData.h"
 
 namespace ignis
 {
@@ -7,6 +8,7 @@ namespace ignis
 	{
 		bool  DepthTest = true;
 		bool  DepthWrite = true;
+		bool  ColorWrite = true;
 
 		enum class DepthFunc { Less, LessOrEqual, Equal, Always, Never };
 		DepthFunc Depth = DepthFunc::Less;
@@ -56,5 +58,30 @@ namespace ignis
 			s.CullFace = false;
 			return s;
 		}
+
+		// Lays down depth only, colour is left for the shading pass
+		static RenderState DepthPrepass(const RenderState& state)
+		{
+			RenderState s = state;
+			s.ColorWrite = false;
+			return s;
+		}
+
+		// Shades only the surfaces a depth pre-pass left visible
+		static RenderState AfterDepthPrepass(const RenderState& state)
+		{
+			RenderState s = state;
+			s.Depth = DepthFunc::Equal;
+			s.DepthWrite = false;
+			return s;
+		}
+
+		static RenderState ForMaterial(const MaterialData& material_data)
+		{
+			RenderState s = material_data.Alpha == AlphaMode::Blend ? Transparent() : Default();
+			if (material_data.DoubleSided)
+				s.CullFace = false;
+			return s;
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ignis
+{
+	// Per-frame counters, reset by Renderer::BeginFrame
+	struct RenderStats
+	{
+		// Material uniform uploads
+		uint32_t UniformsUploaded = 0;
+		uint32_t MaterialUploadsSkipped = 0;
+
+		// Pipeline state and binding changes, issued vs. filtered as redundant
+		uint32_t StateChangesIssued = 0;
+		uint32_t StateChangesSkipped = 0;
+		uint32_t ProgramBindsSkipped = 0;
+		uint32_t VertexArrayBindsSkipped = 0;
+		uint32_t TextureBindsSkipped = 0;
+
+		// Scene geometry draws, an instanced draw counts once
+		uint32_t DrawCalls = 0;
+		uint32_t InstancedDrawCalls = 0;
+		uint32_t InstancesDrawn = 0;
+		// glMultiDrawElementsBaseVertex calls and the submesh ranges they covered
+		uint32_t MultiDrawCalls = 0;
+		uint32_t MultiDrawSubmeshes = 0;
+
+		// Frustum culling
+		uint32_t MeshesVisible = 0;
+		uint32_t MeshesCulled = 0;
+		uint32_t SubmeshesCulled = 0;
+
+		// CPU occlusion culling, tested excludes the occluders themselves
+		uint32_t OccluderTriangles = 0;
+		uint32_t OcclusionTests = 0;
+		uint32_t MeshesOccluded = 0;
+
+		// Visible meshes drawn below LOD 0
+		uint32_t ReducedLODMeshes = 0;
+
+		// Streaming vertex data appended to ring buffers, and waits on fences when a ring wrapped too soon
+		uint32_t StreamedBytes = 0;
+		uint32_t StreamStalls = 0;
+
+		// Text draws, strings and glyph quads, strings sharing an atlas are batched into one draw
+		uint32_t TextDrawCalls = 0;
+		uint32_t TextStrings = 0;
+		uint32_t TextGlyphs = 0;
+
+		// Screen space UI rects and the batched draws they went out in
+		uint32_t UIDrawCalls = 0;
+		uint32_t UIRects = 0;
+
+		// Clustered point and spot lights, and the cluster light index list length
+		uint32_t ClusteredLights = 0;
+		uint32_t LightIndices = 0;
+
+		void Reset() { *this = RenderStats(); }
+	};
+}
@@ -17,6 +17,12 @@ namespace ignis
 		}
 	}
 
+	RenderStats& Renderer::GetStats()
+	{
+		static RenderStats s_stats;
+		return s_stats;
+	}
+
 	std::shared_ptr<Texture2D> Renderer::GetWhiteTexture()
 	{
 		static constexpr std::array<std::byte, 4> s_white_pixel =
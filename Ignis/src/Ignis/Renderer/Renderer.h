@@ -8,15 +8,45 @@
 #include "Framebuffer.h"
 #include "ShaderLibrary.h"
 #include "Font.h"
+#include "TextLayout.h"
 #include "RenderState.h"
+#include "RenderStats.h"
+#include "LightGrid.h"
 
 #include <glm/glm.hpp>
 
 namespace ignis
 {	
+	struct SubmeshDraw
+	{
+		const Mesh* MeshPtr = nullptr;
+		const Submesh* SubmeshPtr = nullptr;
+		uint32_t LOD = 0;
+	};
+
+	// A laid out string anchored at a world position, the layout must outlive the draw call
+	struct TextDraw
+	{
+		const TextLayout* Layout = nullptr;
+		glm::vec3 Anchor{ 0.0f };
+		glm::vec4 Color{ 1.0f };
+	};
+
+	// Screen space quad corner, TextureIndex picks one of the textures bound by the batch's material
+	struct SpriteVertex
+	{
+		glm::vec2 Position;
+		glm::vec2 TexCoord;
+		glm::vec4 Color;
+		float TextureIndex = 0.0f;
+	};
+
 	class IGNIS_API Renderer
 	{
 	public:
+		// Texture slots the batched sprite shader samples from (u_Texture0..)
+		static constexpr uint32_t MaxSpriteTextures = 8;
+
 		virtual ~Renderer() = default;
 
 		virtual void Init() = 0;
@@ -30,13 +60,26 @@ namespace ignis
 		virtual void SetViewport(int x, int y, int width, int height) = 0;
 		virtual void SetViewport(const glm::ivec4& viewport) = 0;
 
-		virtual void DrawIndexed(VertexArray& va) = 0;
-		virtual void DrawLines(VertexArray& va, uint32_t vertex_count) = 0;
+		// base_vertex / first_vertex locate data appended to a Stream vertex buffer
+		virtual void DrawIndexed(VertexArray& va, uint32_t base_vertex = 0) = 0;
+		virtual void DrawLines(VertexArray& va, uint32_t vertex_count, uint32_t first_vertex = 0) = 0;
 
 		virtual void RenderMesh(const Mesh& mesh, const glm::mat4& model,
-			const Environment& scene_environment, const EnvironmentSettings& environment_settings, const LightEnvironment& light_environment) = 0;
+			const Environment& scene_environment, const EnvironmentSettings& environment_settings) = 0;
+		// Draws one submesh with a material that already has its environment applied
+		virtual void RenderSubmesh(const Mesh& mesh, const Submesh& submesh, Material& material,
+			const RenderState& state, const glm::mat4& model, uint32_t lod) = 0;
+		// One draw for many copies of a submesh, material must come from Pipeline::GetInstancedMaterial
+		virtual void RenderSubmeshInstanced(const Mesh& mesh, const Submesh& submesh, Material& material,
+			const RenderState& state, const glm::mat4* models, uint32_t instance_count, uint32_t lod) = 0;
+		// One multi-draw for several index ranges sharing a vertex array, material and transform,
+		// e.g. the submeshes of a mesh or of arena meshes. All draws must use the same index format.
+		virtual void RenderSubmeshes(const SubmeshDraw* draws, uint32_t draw_count, Material& material,
+			const RenderState& state, const glm::mat4& model) = 0;
 		virtual void RenderSkybox(const Environment& environment, const EnvironmentSettings& environment_settings) = 0;
 		virtual void RenderText(const Font& font, const std::string& text, const glm::mat4& transform, const glm::vec4& color, float scale) = 0;
+		// World space strings using font's atlas, drawn with as few draws as the quad index buffer allows
+		virtual void RenderTextBatch(const Font& font, const TextDraw* draws, uint32_t draw_count) = 0;
 
 		virtual void Clear() = 0;
 
@@ -44,6 +87,11 @@ namespace ignis
 		virtual std::shared_ptr<Framebuffer> GetFramebuffer() const = 0;
 
 		virtual void SetCamera(std::shared_ptr<Camera> camera) = 0;
+		// Per-frame uniform buffers read by every shader declaring the CameraData / LightData blocks
+		virtual void UploadCameraData(const Camera& camera) = 0;
+		virtual void UploadLightEnvironment(const LightEnvironment& light_environment) = 0;
+		// Cluster ranges and light indices, rebuilt every frame since they depend on the camera
+		virtual void UploadLightGrid(const LightGrid& light_grid) = 0;
 		virtual void SetPipeline(std::shared_ptr<Pipeline> pipeline) = 0;
 
 		virtual const ShaderLibrary& GetShaderLibrary() const = 0;
@@ -53,13 +101,18 @@ namespace ignis
 		virtual void RenderQuad() = 0;
 
 		virtual void RenderSprite(const glm::vec2& min, const glm::vec2& max) = 0;
-		virtual void RenderUIText(const Font& font, const std::string& text, const glm::mat4& projection, const glm::mat4& model, const glm::vec4& color, float scale) = 0;
+		// Quads of four vertices each with the currently bound material, split only where the quad index buffer runs out
+		virtual void RenderSpriteBatch(const SpriteVertex* vertices, uint32_t quad_count) = 0;
+		// Layout built with LineDirection::Down, the caller keeps it between frames so unchanged strings are not laid out again
+		virtual void RenderUIText(const Font& font, const TextLayout& layout, const glm::mat4& projection, const glm::mat4& model, const glm::vec4& color) = 0;
 
 		virtual void SetRenderState(const RenderState& state) = 0;
 		virtual void ResetRenderState() = 0;
 
 		static std::unique_ptr<Renderer> Create();
 
+		static RenderStats& GetStats();
+
 		static std::shared_ptr<Texture2D> GetWhiteTexture();
 		static std::shared_ptr<Texture2D> GetBlackTexture();
 		static std::shared_ptr<Texture2D> GetDefaultNormalTexture();
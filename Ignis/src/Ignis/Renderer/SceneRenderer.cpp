@@ -2,6 +2,12 @@
 
 namespace ignis
 {
+	namespace
+	{
+		// Smaller runs are cheaper as plain draws than uploading an instance buffer
+		constexpr size_t k_min_instanced_run = 2;
+	}
+
 	SceneRenderer::SceneRenderer(Renderer& renderer)
 		: m_renderer(renderer)
 	{
@@ -17,9 +23,38 @@ namespace ignis
 	{
 		m_context = context;
 
+		m_queue.Clear();
+		m_mesh_commands.clear();
+		m_text_commands.clear();
+		m_shader_ids.clear();
+		m_material_ids.clear();
+		m_mesh_ids.clear();
+		m_font_ids.clear();
+		m_materials_data.clear();
+
 		m_renderer.SetPipeline(context.Pipeline);
 		m_renderer.SetCamera(context.Camera);
 
+		// Camera and lights are uploaded once here instead of per material per draw
+		m_frustum = Frustum();
+		if (m_context.Camera)
+		{
+			m_renderer.UploadCameraData(*m_context.Camera);
+			m_frustum = Frustum(m_context.Camera->GetViewProjection());
+			m_occlusion_buffer.Begin(m_context.Camera->GetViewProjection());
+		}
+
+		if (m_context.Scene)
+		{
+			m_context.Scene->UpdateLightEnvironment();
+			m_renderer.UploadLightEnvironment(m_context.Scene->m_light_environment);
+
+			if (m_context.Camera)
+			{
+				m_light_grid.Build(m_context.Scene->m_light_environment, *m_context.Camera);
+				m_renderer.UploadLightGrid(m_light_grid);
+			}
+		}
 
 		if (m_context.Viewport.z > 0 && m_context.Viewport.w > 0)
 		{
@@ -35,37 +70,239 @@ namespace ignis
 
 	void SceneRenderer::EndScene()
 	{
+		Flush();
 	}
 
-	void SceneRenderer::SubmitMesh(const Mesh& mesh, const glm::mat4& transform) const
+	uint32_t SceneRenderer::SelectLOD(const Mesh& mesh, const BoundingSphere& world_sphere, uint32_t previous) const
 	{
-		// Use scene environment if available, otherwise create a default empty one
-		if (m_context.Scene->m_scene_environment)
+		const uint32_t lod_count = mesh.GetLODCount();
+		if (lod_count <= 1 || !m_context.Camera)
+			return 0;
+
+		// Bounding sphere diameter as a fraction of the viewport height
+		const glm::mat4& projection = m_context.Camera->GetProjection();
+		float screen_size = world_sphere.Radius * projection[1][1];
+		if (projection[3][3] != 1.0f)
 		{
-			m_renderer.RenderMesh(mesh, transform, *m_context.Scene->m_scene_environment, 
-				m_context.Scene->m_environment_settings, m_context.Scene->m_light_environment);
+			const float depth = -(m_context.Camera->GetView() * glm::vec4(world_sphere.Center, 1.0f)).z;
+			if (depth <= world_sphere.Radius)
+				return 0;
+			screen_size /= depth;
 		}
-		else
+
+		const auto& thresholds = mesh.GetLODScreenSizes();
+		const float hysteresis = mesh.GetLODHysteresis();
+
+		uint32_t lod = std::min(previous, lod_count - 1);
+		while (lod + 1 < lod_count && screen_size < thresholds[lod] * (1.0f - hysteresis))
+			lod++;
+		while (lod > 0 && screen_size > thresholds[lod - 1] * (1.0f + hysteresis))
+			lod--;
+		return lod;
+	}
+
+	void SceneRenderer::SubmitMesh(const Mesh& mesh, const glm::mat4& transform, uint32_t lod)
+	{
+		const Environment& environment = GetSceneEnvironment();
+
+		// Sort depth is taken at the mesh origin
+		float view_depth = 0.0f;
+		if (m_context.Camera)
+			view_depth = -(m_context.Camera->GetView() * transform[3]).z;
+		const uint16_t depth = SortKey::QuantizeDepth(view_depth);
+
+		const auto& materials_data = mesh.GetMaterialsData();
+		const auto& submeshes = mesh.GetSubmeshes();
+
+		for (const auto& sm : submeshes)
 		{
-			// Create temporary empty environment for rendering without skybox
-			Environment empty_env;
-			m_renderer.RenderMesh(mesh, transform, empty_env, 
-				m_context.Scene->m_environment_settings, m_context.Scene->m_light_environment);
+			// The whole mesh already passed, only split meshes can drop parts
+			if (submeshes.size() > 1 && sm.Bounds.IsValid() && !m_frustum.Intersects(sm.Bounds.Transform(transform)))
+			{
+				Renderer::GetStats().SubmeshesCulled++;
+				continue;
+			}
+
+			const auto& material_data = materials_data[sm.MaterialIndex];
+			auto material = m_context.Pipeline->GetMaterial(material_data, environment,
+				m_context.Scene->m_environment_settings);
+
+			const uint32_t shader_id = GetSortID(m_shader_ids, material->GetShader().get());
+			const uint32_t material_id = GetSortID(m_material_ids, material.get());
+			if (material_id == m_materials_data.size())
+				m_materials_data.push_back(material_data);
+
+			// Keyed per submesh LOD so copies of the same index range end up adjacent for instancing
+			const uint32_t sub_lod = std::min(lod, sm.GetLODCount() - 1);
+			const uint32_t mesh_id = GetSortID(m_mesh_ids, sub_lod == 0 ? static_cast<const void*>(&sm) : &sm.LODs[sub_lod - 1]);
+
+			const uint64_t key = material_data.Alpha == AlphaMode::Blend
+				? SortKey::Transparent(depth, shader_id, material_id, mesh_id)
+				: SortKey::Opaque(shader_id, material_id, mesh_id, depth);
+
+			m_queue.Push(key, static_cast<uint32_t>(m_mesh_commands.size()));
+			m_mesh_commands.push_back({ &mesh, &sm, std::move(material), material_id, RenderState::ForMaterial(material_data), transform, sub_lod });
 		}
 	}
 
-	void SceneRenderer::SubmitSkybox() const
+	void SceneRenderer::SubmitSkybox()
 	{
 		// Check if scene environment exists before accessing
 		if (m_context.Scene->m_scene_environment && 
 		    m_context.Scene->m_scene_environment->GetSkyboxMap())
 		{
-			m_renderer.RenderSkybox(*m_context.Scene->m_scene_environment, m_context.Scene->m_environment_settings);
+			// Drawn after opaque geometry so covered sky pixels fail the depth test
+			m_queue.Push(SortKey::Sequential(RenderPass::Skybox, 0), 0);
+		}
+	}
+
+	void SceneRenderer::SubmitText(const Font& font, const TextLayout& layout, const glm::mat4& transform, const glm::vec4& color)
+	{
+		if (layout.IsEmpty() || !font.GetAtlas())
+			return;
+
+		// Only the anchor is used, glyphs keep a constant size on screen
+		const uint32_t index = static_cast<uint32_t>(m_text_commands.size());
+		m_queue.Push(SortKey::Text(GetSortID(m_font_ids, font.GetAtlas().get()), index), index);
+		m_text_commands.push_back({ &font, { &layout, glm::vec3(transform[3]), color } });
+	}
+
+	void SceneRenderer::Flush()
+	{
+		m_queue.Sort();
+
+		const auto& entries = m_queue.GetEntries();
+
+		// Opaque keys sort first, so the pre-pass is the leading run of the queue
+		if (m_context.DepthPrepass)
+		{
+			for (size_t i = 0; i < entries.size() && SortKey::GetPass(entries[i].Key) == RenderPass::Opaque;)
+				i = FlushOpaqueRun(i, true);
+		}
+
+		for (size_t i = 0; i < entries.size();)
+		{
+			const auto& entry = entries[i];
+			switch (SortKey::GetPass(entry.Key))
+			{
+			case RenderPass::Opaque:
+				i = FlushOpaqueRun(i, false);
+				continue;
+			case RenderPass::Transparent:
+			{
+				const auto& cmd = m_mesh_commands[entry.Index];
+				m_renderer.RenderSubmesh(*cmd.MeshPtr, *cmd.SubmeshPtr, *cmd.MaterialPtr, cmd.State, cmd.Transform, cmd.LOD);
+				break;
+			}
+			case RenderPass::Skybox:
+				m_renderer.RenderSkybox(*m_context.Scene->m_scene_environment, m_context.Scene->m_environment_settings);
+				break;
+			case RenderPass::Text:
+			{
+				// Text sorts by atlas, draw each atlas's strings together
+				const auto& cmd = m_text_commands[entry.Index];
+				m_text_draws.clear();
+				while (i < entries.size() && SortKey::GetPass(entries[i].Key) == RenderPass::Text
+					&& m_text_commands[entries[i].Index].FontPtr->GetAtlas() == cmd.FontPtr->GetAtlas())
+				{
+					m_text_draws.push_back(m_text_commands[entries[i].Index].Draw);
+					++i;
+				}
+				m_renderer.RenderTextBatch(*cmd.FontPtr, m_text_draws.data(), static_cast<uint32_t>(m_text_draws.size()));
+				continue;
+			}
+			}
+			++i;
+		}
+
+		m_renderer.ResetRenderState();
+
+		m_queue.Clear();
+		m_mesh_commands.clear();
+		m_text_commands.clear();
+	}
+
+	size_t SceneRenderer::FlushOpaqueRun(size_t first, bool depth_only)
+	{
+		const auto& entries = m_queue.GetEntries();
+		const auto& cmd = m_mesh_commands[entries[first].Index];
+
+		// Same submesh and material sort next to each other, so a run is a contiguous range
+		auto run_end = [&](size_t begin)
+		{
+			const auto& head = m_mesh_commands[entries[begin].Index];
+			size_t end = begin + 1;
+			while (end < entries.size() && SortKey::GetPass(entries[end].Key) == RenderPass::Opaque)
+			{
+				const auto& next = m_mesh_commands[entries[end].Index];
+				if (next.SubmeshPtr != head.SubmeshPtr || next.LOD != head.LOD || next.MaterialPtr != head.MaterialPtr)
+					break;
+				++end;
+			}
+			return end;
+		};
+
+		const size_t last = run_end(first);
+
+		RenderState state = cmd.State;
+		if (depth_only)
+			state = RenderState::DepthPrepass(state);
+		else if (m_context.DepthPrepass)
+			state = RenderState::AfterDepthPrepass(state);
+
+		if (last - first < k_min_instanced_run)
+		{
+			auto material = depth_only ? m_context.Pipeline->GetDepthMaterial(false) : cmd.MaterialPtr;
+
+			// Following single draws with the same material and transform, e.g. the other submeshes
+			// of this mesh, go out as one multi-draw when they share a vertex array and index format
+			m_submesh_draws.clear();
+			m_submesh_draws.push_back({ cmd.MeshPtr, cmd.SubmeshPtr, cmd.LOD });
+
+			size_t next_index = first + 1;
+			while (next_index < entries.size() && SortKey::GetPass(entries[next_index].Key) == RenderPass::Opaque)
+			{
+				const auto& next = m_mesh_commands[entries[next_index].Index];
+				const bool same_buffers = next.MeshPtr == cmd.MeshPtr || (next.MeshPtr->IsInGeometryArena() && cmd.MeshPtr->IsInGeometryArena());
+				if (next.MaterialPtr != cmd.MaterialPtr || next.Transform != cmd.Transform || !same_buffers
+					|| next.SubmeshPtr->Format != cmd.SubmeshPtr->Format || run_end(next_index) - next_index >= k_min_instanced_run)
+					break;
+
+				m_submesh_draws.push_back({ next.MeshPtr, next.SubmeshPtr, next.LOD });
+				++next_index;
+			}
+
+			if (m_submesh_draws.size() == 1)
+				m_renderer.RenderSubmesh(*cmd.MeshPtr, *cmd.SubmeshPtr, *material, state, cmd.Transform, cmd.LOD);
+			else
+				m_renderer.RenderSubmeshes(m_submesh_draws.data(), static_cast<uint32_t>(m_submesh_draws.size()), *material, state, cmd.Transform);
+			return next_index;
 		}
+
+		m_instance_transforms.clear();
+		for (size_t i = first; i < last; i++)
+			m_instance_transforms.push_back(m_mesh_commands[entries[i].Index].Transform);
+
+		auto material = depth_only
+			? m_context.Pipeline->GetDepthMaterial(true)
+			: m_context.Pipeline->GetInstancedMaterial(m_materials_data[cmd.MaterialID], GetSceneEnvironment(),
+				m_context.Scene->m_environment_settings);
+
+		m_renderer.RenderSubmeshInstanced(*cmd.MeshPtr, *cmd.SubmeshPtr, *material, state,
+			m_instance_transforms.data(), static_cast<uint32_t>(m_instance_transforms.size()), cmd.LOD);
+		return last;
+	}
+
+	const Environment& SceneRenderer::GetSceneEnvironment() const
+	{
+		// Use scene environment if available, otherwise a default empty one
+		static const Environment s_empty_environment;
+		return m_context.Scene->m_scene_environment ? *m_context.Scene->m_scene_environment : s_empty_environment;
 	}
 
-	void SceneRenderer::SubmitText(const Font& font, const std::string& text, const glm::mat4& transform, const glm::vec4& color, float scale) const
+	uint32_t SceneRenderer::GetSortID(std::unordered_map<const void*, uint32_t>& ids, const void* object)
 	{
-		m_renderer.RenderText(font, text, transform, color, scale);
+		auto [it, inserted] = ids.try_emplace(object, static_cast<uint32_t>(ids.size()));
+		return it->second;
 	}
-}
\ No newline at end of file
+}
@@ -3,8 +3,13 @@
 #include "Ignis/Core/API.h"
 #include "Renderer.h"
 #include "Environment.h"
+#include "RenderQueue.h"
+#include "Frustum.h"
+#include "OcclusionBuffer.h"
 #include "Ignis/Scene/Scene.h"
 
+#include <unordered_map>
+
 namespace ignis
 {
 	struct SceneRenderContext
@@ -16,6 +21,10 @@ namespace ignis
 		glm::ivec4 Viewport{ 0, 0, 0, 0 };
 		glm::vec4 ClearColor{ 0.1f, 0.1f, 0.1f, 1.0f };
 		bool ClearTarget = true;
+		// Lay down opaque depth first so the PBR shader runs once per pixel
+		bool DepthPrepass = false;
+		// Test draws against meshes flagged as occluders
+		bool OcclusionCulling = true;
 	};
 
 	class IGNIS_API SceneRenderer
@@ -27,14 +36,69 @@ namespace ignis
 		void BeginScene(const SceneRenderContext& context);
 		void EndScene();
 
-		void SubmitMesh(const Mesh& mesh, const glm::mat4& transform = glm::mat4(1.0f)) const;
-		void SubmitSkybox() const;
-		void SubmitText(const Font& font, const std::string& text, const glm::mat4& transform, const glm::vec4& color, float scale) const;
+		// Camera frustum of the current scene, culls nothing without a camera
+		const Frustum& GetFrustum() const { return m_frustum; }
+		// Cleared for the camera in BeginScene, the scene adds occluders and rasterizes it
+		OcclusionBuffer& GetOcclusionBuffer() { return m_occlusion_buffer; }
+		bool IsOcclusionCullingEnabled() const { return m_context.OcclusionCulling && m_context.Camera; }
+
+		// Picks a LOD from the projected size of the world space bounds, previous is
+		// the LOD used last frame and only changes once a threshold is passed by the hysteresis band
+		uint32_t SelectLOD(const Mesh& mesh, const BoundingSphere& world_sphere, uint32_t previous) const;
+
+		// Submissions are queued and drawn in sort key order by EndScene
+		void SubmitMesh(const Mesh& mesh, const glm::mat4& transform = glm::mat4(1.0f), uint32_t lod = 0);
+		void SubmitSkybox();
+		// layout is read at EndScene, keep it alive until then (e.g. the TextComponent's cached layout)
+		void SubmitText(const Font& font, const TextLayout& layout, const glm::mat4& transform, const glm::vec4& color);
+
+	private:
+		struct MeshCommand
+		{
+			const Mesh* MeshPtr = nullptr;
+			const Submesh* SubmeshPtr = nullptr;
+			std::shared_ptr<Material> MaterialPtr;
+			uint32_t MaterialID = 0;
+			RenderState State;
+			glm::mat4 Transform{ 1.0f };
+			uint32_t LOD = 0;
+		};
+
+		struct TextCommand
+		{
+			const Font* FontPtr = nullptr;
+			TextDraw Draw;
+		};
+
+		void Flush();
+		// Draws the opaque run starting at first, returns the entry after it
+		size_t FlushOpaqueRun(size_t first, bool depth_only);
+		const Environment& GetSceneEnvironment() const;
+		uint32_t GetSortID(std::unordered_map<const void*, uint32_t>& ids, const void* object);
 
 	private:
 		Renderer& m_renderer;
 		SceneRenderContext m_context;
 
+		Frustum m_frustum;
+		OcclusionBuffer m_occlusion_buffer;
+		LightGrid m_light_grid;
+		RenderQueue m_queue;
+		std::vector<MeshCommand> m_mesh_commands;
+		std::vector<TextCommand> m_text_commands;
+		std::vector<glm::mat4> m_instance_transforms;
+		std::vector<SubmeshDraw> m_submesh_draws;
+		std::vector<TextDraw> m_text_draws;
+
+		// Dense per-scene ids so the key fields stay small
+		std::unordered_map<const void*, uint32_t> m_shader_ids;
+		std::unordered_map<const void*, uint32_t> m_material_ids;
+		std::unordered_map<const void*, uint32_t> m_mesh_ids;
+		std::unordered_map<const void*, uint32_t> m_font_ids;
+
+		// Indexed by material id, kept to build the instanced variant at flush
+		std::vector<MaterialData> m_materials_data;
+
 		LightEnvironment m_light_environment;
 		Environment m_scene_environment;
 		EnvironmentSettings m_environment_settings;
@@ -14,12 +14,12 @@ namespace ignis
 			return nullptr;
 		}
 	}
-	std::shared_ptr<Shader> Shader::CreateFromFile(const std::string& filepath)
+	std::shared_ptr<Shader> Shader::CreateFromFile(const std::string& filepath, const std::string& defines)
 	{
 		switch (GraphicsAPI::GetType())
 		{
 		case GraphicsAPI::Type::OpenGL:
-			return std::make_unique<GLShader>(filepath);
+			return std::make_unique<GLShader>(filepath, defines);
 		default:
 			return nullptr;
 		}
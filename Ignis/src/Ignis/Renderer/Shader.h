@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ShaderUniform.h"
+#include "UniformHandle.h"
 
 #include <glm/glm.hpp>
 #include <string>
@@ -17,7 +18,9 @@ namespace ignis
 			Bool, Bool2, Bool3, Bool4,
 			Int, Int2, Int3, Int4,
 			UInt, UInt2, UInt3, UInt4,
-			Mat3, Mat4
+			Mat3, Mat4,
+			// Vertex attribute storage only, read as float vectors in shaders
+			Short2, Short4, Half2
 		};
 
 		static constexpr size_t DataTypeSize(DataType type) noexcept
@@ -46,6 +49,10 @@ namespace ignis
 
 			case DataType::Mat3:   return sizeof(float) * 3 * 3;
 			case DataType::Mat4:   return sizeof(float) * 4 * 4;
+
+			case DataType::Short2: return sizeof(int16_t) * 2;
+			case DataType::Short4: return sizeof(int16_t) * 4;
+			case DataType::Half2:  return sizeof(uint16_t) * 2;
 			default:               return 0;
 			}
 		}
@@ -72,6 +79,9 @@ namespace ignis
 			case DataType::UInt4:  return 4;
 			case DataType::Mat3:   return 3;
 			case DataType::Mat4:   return 4;
+			case DataType::Short2: return 2;
+			case DataType::Short4: return 4;
+			case DataType::Half2:  return 2;
 			default:               return 0;
 			}
 		}
@@ -85,9 +95,15 @@ namespace ignis
 
 		virtual const std::unordered_map<std::string, ShaderUniform>& GetUniforms() const = 0;
 		virtual const std::unordered_map<std::string, ShaderSampler>& GetSamplers() const = 0;
+		virtual const std::unordered_map<std::string, ShaderUniformBlock>& GetUniformBlocks() const = 0;
 		virtual uint32_t GetUniformBufferSize() const = 0;
 
+		// nullptr when the shader has no uniform/sampler with the handle's name
+		virtual const ShaderUniform* ResolveUniform(const UniformHandle& handle) const = 0;
+		virtual const ShaderSampler* ResolveSampler(const SamplerHandle& handle) const = 0;
+
 		static std::shared_ptr<Shader> Create(const std::string& name, const std::string& vertex_source, const std::string& fragment_source);
-		static std::shared_ptr<Shader> CreateFromFile(const std::string& filepath);
+		// defines are injected after #version, e.g. "#define INSTANCED 1\n"
+		static std::shared_ptr<Shader> CreateFromFile(const std::string& filepath, const std::string& defines = "");
 	};
 }
\ No newline at end of file
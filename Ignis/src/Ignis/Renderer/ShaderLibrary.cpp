@@ -8,11 +8,11 @@ namespace ignis
 		m_shaders[shader->GetName()] = std::move(shader);
 	}
 
-	std::shared_ptr<Shader> ShaderLibrary::Load(const std::string& filepath, std::string_view name)
+	std::shared_ptr<Shader> ShaderLibrary::Load(const std::string& filepath, std::string_view name, const std::string& defines)
 	{
 		std::string key = name.empty() ? filepath : std::string(name);
 
-		m_shaders[key] = std::move(Shader::CreateFromFile(filepath));
+		m_shaders[key] = std::move(Shader::CreateFromFile(filepath, defines));
 		return m_shaders[key];
 	}
 
@@ -20,6 +20,9 @@ namespace ignis {
 		ShaderUniformType type = ShaderUniformType::None;
 		uint32_t          size = 0;
 		uint32_t          offset = 0;
+		uint32_t          hash = 0;
+		uint32_t          index = 0;
+		int32_t           location = -1;
 
 		static uint32_t TypeSize(ShaderUniformType type)
 		{
@@ -49,6 +52,16 @@ namespace ignis {
 	{
 		std::string name;
 		uint32_t    slot = 0;
+		uint32_t    hash = 0;
+		uint32_t    index = 0;
+		int32_t     location = -1;
+	};
+
+	struct ShaderUniformBlock
+	{
+		std::string name;
+		uint32_t    size = 0;
+		int32_t     binding = -1;
 	};
 
 }
\ No newline at end of file
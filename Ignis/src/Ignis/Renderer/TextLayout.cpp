@@ -0,0 +1,66 @@
+#include "TextLayout.h"
+
+#include <algorithm>
+
+namespace ignis
+{
+	bool TextLayout::Update(const Font& font, const std::string& text, float scale, LineDirection direction)
+	{
+		// Pages finished on the font worker since last frame change which glyphs resolve
+		font.Update();
+
+		if (m_font == &font && m_atlas == font.GetAtlas().get() && m_glyph_version == font.GetGlyphVersion()
+			&& m_scale == scale && m_direction == direction && m_text == text)
+			return false;
+
+		m_font = &font;
+		m_atlas = font.GetAtlas().get();
+		m_glyph_version = font.GetGlyphVersion();
+		m_scale = scale;
+		m_direction = direction;
+		m_text = text;
+
+		m_quads.clear();
+		m_quads.reserve(text.size());
+		m_max_page = 0;
+
+		const float line_step = font.GetLineHeight() * scale * (direction == LineDirection::Up ? 1.0f : -1.0f);
+		const GlyphMetrics* space = font.GetGlyph(' ');
+
+		float cursor_x = 0.0f;
+		float cursor_y = 0.0f;
+		for (size_t offset = 0; offset < text.size();)
+		{
+			const uint32_t codepoint = Font::NextCodepoint(text, offset);
+			if (codepoint == '\n')
+			{
+				cursor_x = 0.0f;
+				cursor_y += line_step;
+				continue;
+			}
+
+			// Glyphs whose page is still being rasterized take a space until it arrives
+			const GlyphMetrics* g = font.GetGlyph(codepoint);
+			if (!g)
+			{
+				if (space)
+					cursor_x += space->Advance * scale;
+				continue;
+			}
+
+			// Atlas rows run top-down, so the quad's top edge takes AtlasMin.y
+			GlyphQuad quad;
+			quad.Min = { cursor_x + g->QuadMin.x * scale, cursor_y - g->QuadMax.y * scale };
+			quad.Max = { cursor_x + g->QuadMax.x * scale, cursor_y - g->QuadMin.y * scale };
+			quad.UVMin = g->AtlasMin;
+			quad.UVMax = g->AtlasMax;
+			quad.Page = g->Page;
+			m_quads.push_back(quad);
+			m_max_page = std::max(m_max_page, g->Page);
+
+			cursor_x += g->Advance * scale;
+		}
+
+		return true;
+	}
+}
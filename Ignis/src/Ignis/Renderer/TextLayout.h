@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Font.h"
+
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+namespace ignis
+{
+	// One glyph, in pixels relative to the text anchor
+	struct GlyphQuad
+	{
+		glm::vec2 Min;
+		glm::vec2 Max;
+		glm::vec2 UVMin;
+		glm::vec2 UVMax;
+		uint32_t  Page = 0;
+	};
+
+	// Laid out glyph quads of a UTF-8 string. Update only rebuilds when the text, font,
+	// scale or the font's loaded glyph pages differ from the last call, so unchanged
+	// strings cost a compare per frame.
+	class TextLayout
+	{
+	public:
+		// Which way a '\n' moves the cursor in the space the quads are drawn in
+		enum class LineDirection
+		{
+			Up,
+			Down
+		};
+
+		// Returns true when the quads were rebuilt
+		bool Update(const Font& font, const std::string& text, float scale, LineDirection direction = LineDirection::Up);
+
+		const std::vector<GlyphQuad>& GetQuads() const { return m_quads; }
+		bool IsEmpty() const { return m_quads.empty(); }
+		// Highest atlas page any quad samples, renderers draw pages 0..GetMaxPage()
+		uint32_t GetMaxPage() const { return m_max_page; }
+
+	private:
+		std::vector<GlyphQuad> m_quads;
+		uint32_t m_max_page = 0;
+
+		// Inputs of the current quads, the atlas catches a font reloaded at the same address
+		std::string m_text;
+		const Font* m_font = nullptr;
+		const Texture2D* m_atlas = nullptr;
+		float m_scale = 0.0f;
+		uint32_t m_glyph_version = 0;
+		LineDirection m_direction = LineDirection::Up;
+	};
+}
@@ -25,6 +25,9 @@ namespace ignis
 	class Texture2D : public Texture
 	{
 	public:
+		// Replaces a width x height region at (x, y) of the base level, mips are regenerated if the specs ask for them
+		virtual void SetSubData(uint32_t x, uint32_t y, uint32_t width, uint32_t height, ImageFormat source_format, std::span<const std::byte> data) const = 0;
+
 		static std::shared_ptr<Texture2D> Create(const TextureSpecs& specs, ImageFormat source_format, std::span<const std::byte> data);
 		static std::shared_ptr<Texture2D> Create(const TextureSpecs& specs);
 		static std::shared_ptr<Texture2D> Create(const glm::vec4 color);
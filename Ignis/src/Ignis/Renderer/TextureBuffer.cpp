@@ -0,0 +1,28 @@
+#include "TextureBuffer.h"
+#include "GraphicsAPI.h"
+#include "Ignis/Platform/OpenGL/GLTextureBuffer.h"
+
+namespace ignis
+{
+	int32_t TextureBuffer::GetSamplerBinding(std::string_view sampler_name)
+	{
+		if (sampler_name == "lightBuffer")
+			return static_cast<int32_t>(TextureBufferBinding::Lights);
+		if (sampler_name == "clusterBuffer")
+			return static_cast<int32_t>(TextureBufferBinding::Clusters);
+		if (sampler_name == "lightIndexBuffer")
+			return static_cast<int32_t>(TextureBufferBinding::LightIndices);
+		return -1;
+	}
+
+	std::shared_ptr<TextureBuffer> TextureBuffer::Create(TextureBufferFormat format, uint32_t size, TextureBufferBinding binding)
+	{
+		switch (GraphicsAPI::GetType())
+		{
+		case GraphicsAPI::Type::OpenGL:
+			return std::make_shared<GLTextureBuffer>(format, size, static_cast<uint32_t>(binding));
+		default:
+			return nullptr;
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace ignis
+{
+	// Fixed texture units for engine-fed buffer samplers, kept above the units materials hand out
+	enum class TextureBufferBinding : uint32_t
+	{
+		Lights = 13,
+		Clusters = 14,
+		LightIndices = 15,
+	};
+
+	enum class TextureBufferFormat
+	{
+		RGBA32F,
+		RG32UI,
+		R32UI,
+	};
+
+	// Large read-only arrays for shaders, sampled with texelFetch on a samplerBuffer
+	class TextureBuffer
+	{
+	public:
+		virtual ~TextureBuffer() = default;
+
+		// Grows the storage when size exceeds the current capacity
+		virtual void SetData(const void* data, uint32_t size) = 0;
+		virtual void Bind() const = 0;
+
+		virtual uint32_t GetBinding() const = 0;
+
+		// Texture unit for a named buffer sampler, -1 when the sampler is not engine-managed
+		static int32_t GetSamplerBinding(std::string_view sampler_name);
+
+		static std::shared_ptr<TextureBuffer> Create(TextureBufferFormat format, uint32_t size, TextureBufferBinding binding);
+	};
+}
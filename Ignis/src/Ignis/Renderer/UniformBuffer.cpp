@@ -0,0 +1,58 @@
+#include "UniformBuffer.h"
+#include "GraphicsAPI.h"
+#include "Camera.h"
+#include "Ignis/Scene/Scene.h"
+#include "Ignis/Platform/OpenGL/GLUniformBuffer.h"
+
+namespace ignis
+{
+	static_assert(LightUniformData::MaxDirectionalLights == LightEnvironment::MaxDirectionalLights);
+
+	CameraUniformData CameraUniformData::From(const Camera& camera)
+	{
+		CameraUniformData data;
+		data.View = camera.GetView();
+		data.Projection = camera.GetProjection();
+		data.ViewProjection = data.Projection * data.View;
+		data.Position = camera.GetPosition();
+		return data;
+	}
+
+	LightUniformData LightUniformData::From(const LightEnvironment& light_environment)
+	{
+		LightUniformData data{};
+
+		const size_t directional_count = std::min(light_environment.DirectionalLights.size(), MaxDirectionalLights);
+		for (size_t i = 0; i < directional_count; i++)
+		{
+			const auto& light = light_environment.DirectionalLights[i];
+			data.DirectionalLights[i].Direction = light.Direction;
+			data.DirectionalLights[i].Radiance = light.Radiance;
+		}
+
+		data.NumDirectionalLights = static_cast<int32_t>(directional_count);
+		return data;
+	}
+
+	int32_t UniformBuffer::GetBlockBinding(std::string_view block_name)
+	{
+		if (block_name == "CameraData")
+			return static_cast<int32_t>(UniformBufferBinding::Camera);
+		if (block_name == "LightData")
+			return static_cast<int32_t>(UniformBufferBinding::Lights);
+		if (block_name == "ClusterData")
+			return static_cast<int32_t>(UniformBufferBinding::Clusters);
+		return -1;
+	}
+
+	std::shared_ptr<UniformBuffer> UniformBuffer::Create(uint32_t size, UniformBufferBinding binding)
+	{
+		switch (GraphicsAPI::GetType())
+		{
+		case GraphicsAPI::Type::OpenGL:
+			return std::make_shared<GLUniformBuffer>(size, static_cast<uint32_t>(binding));
+		default:
+			return nullptr;
+		}
+	}
+}
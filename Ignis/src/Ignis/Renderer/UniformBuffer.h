@@ -0,0 +1,76 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string_view>
+
+namespace ignis
+{
+	struct LightEnvironment;
+	class Camera;
+
+	// Fixed binding points shared by every shader that declares the matching block
+	enum class UniformBufferBinding : uint32_t
+	{
+		Camera = 0,
+		Lights = 1,
+		Clusters = 2,
+	};
+
+	// std140 mirror of the CameraData block
+	struct CameraUniformData
+	{
+		glm::mat4 View;
+		glm::mat4 Projection;
+		glm::mat4 ViewProjection;
+		glm::vec3 Position;
+		float Padding0 = 0.0f;
+
+		static CameraUniformData From(const Camera& camera);
+	};
+	static_assert(sizeof(CameraUniformData) == 208);
+
+	// std140 mirror of the LightData block. Point and spot lights are clustered
+	// and live in texture buffers, see LightGrid.
+	struct LightUniformData
+	{
+		static constexpr size_t MaxDirectionalLights = 4;
+
+		struct Directional
+		{
+			glm::vec3 Direction; float Padding0;
+			glm::vec3 Radiance;  float Padding1;
+		};
+
+		Directional DirectionalLights[MaxDirectionalLights];
+		int32_t NumDirectionalLights;
+		int32_t Padding0[3];
+
+		static LightUniformData From(const LightEnvironment& light_environment);
+	};
+	static_assert(sizeof(LightUniformData::Directional) == 32);
+	static_assert(sizeof(LightUniformData) == 144);
+
+	// std140 mirror of the ClusterData block
+	struct ClusterUniformData
+	{
+		glm::ivec4 Grid{ 0 };        // tiles x, tiles y, depth slices, light count
+		glm::vec4 DepthParams{ 0.0f }; // near, far, slice scale, slice bias
+	};
+	static_assert(sizeof(ClusterUniformData) == 32);
+
+	class UniformBuffer
+	{
+	public:
+		virtual ~UniformBuffer() = default;
+
+		virtual void SetData(const void* data, uint32_t size, uint32_t offset = 0) = 0;
+		virtual uint32_t GetBinding() const = 0;
+
+		// Binding point for a named uniform block, -1 when the block is not engine-managed
+		static int32_t GetBlockBinding(std::string_view block_name);
+
+		static std::shared_ptr<UniformBuffer> Create(uint32_t size, UniformBufferBinding binding);
+	};
+}
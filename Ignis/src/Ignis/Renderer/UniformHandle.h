@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace ignis
+{
+	// FNV-1a, usable on string literals at compile time
+	constexpr uint32_t HashUniformName(std::string_view name)
+	{
+		uint32_t hash = 2166136261u;
+		for (char c : name)
+		{
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	// Identifies a uniform by name hash. On first use a handle is given a process-wide
+	// id, and every shader caches the handle's slot in a table indexed by that id, so
+	// one handle shared by several shader variants resolves once per shader. Handles
+	// should live in statics or members and be reused instead of being rebuilt per call.
+	struct UniformHandle
+	{
+		uint32_t NameHash = 0;
+
+		mutable uint32_t Id = UINT32_MAX;
+
+		constexpr UniformHandle() = default;
+		constexpr UniformHandle(std::string_view name)
+			: NameHash(HashUniformName(name)) {}
+	};
+
+	struct SamplerHandle
+	{
+		uint32_t NameHash = 0;
+
+		mutable uint32_t Id = UINT32_MAX;
+
+		constexpr SamplerHandle() = default;
+		constexpr SamplerHandle(std::string_view name)
+			: NameHash(HashUniformName(name)) {}
+	};
+}
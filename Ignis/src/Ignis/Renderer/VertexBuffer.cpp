@@ -1,10 +1,16 @@
 #include "VertexBuffer.h"
 #include "GraphicsAPI.h"
 #include "Ignis/Platform/OpenGL/GLVertexBuffer.h"
+#include "Ignis/Platform/OpenGL/GLDynamicRingBuffer.h"
 
 namespace ignis
 {
 	VertexBuffer::Layout::Layout(const std::initializer_list<Attribute>& attributes)
+		: Layout(std::vector<Attribute>(attributes))
+	{
+	}
+
+	VertexBuffer::Layout::Layout(const std::vector<Attribute>& attributes)
 		: m_attributes(attributes)
 	{
 		uint32_t offset = 0;
@@ -16,11 +22,19 @@ namespace ignis
 		m_stride = offset;
 	}
 
+	uint32_t VertexBuffer::Append(const void* data, size_t size)
+	{
+		SetData(data, size);
+		return 0;
+	}
+
 	std::shared_ptr<VertexBuffer> VertexBuffer::Create(size_t size, Usage usage)
 	{
 		switch (GraphicsAPI::GetType())
 		{
 		case GraphicsAPI::Type::OpenGL:
+			if (usage == Usage::Stream)
+				return std::make_shared<GLDynamicRingBuffer>(size);
 			return std::make_shared<GLVertexBuffer>(size, usage);
 		default:
 			return nullptr;
@@ -32,6 +46,12 @@ namespace ignis
 		switch (GraphicsAPI::GetType())
 		{
 		case GraphicsAPI::Type::OpenGL:
+			if (usage == Usage::Stream)
+			{
+				auto buffer = std::make_shared<GLDynamicRingBuffer>(size);
+				buffer->SetData(vertices, size);
+				return buffer;
+			}
 			return std::make_shared<GLVertexBuffer>(vertices, size, usage);
 		default:
 			return nullptr;
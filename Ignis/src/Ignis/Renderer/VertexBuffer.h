@@ -13,7 +13,9 @@ namespace ignis
 		enum class Usage
 		{
 			Static,
-			Dynamic
+			Dynamic,
+			// Written several times per frame, each write appended to a fenced ring
+			Stream
 		};
 
 		struct Attribute
@@ -32,6 +34,8 @@ namespace ignis
 		{
 		public:
 			Layout(const std::initializer_list<Attribute>& attributes);
+			// For layouts assembled at runtime, e.g. meshes that only store the UV sets they have
+			Layout(const std::vector<Attribute>& attributes);
 
 			~Layout() = default;
 
@@ -49,6 +53,10 @@ namespace ignis
 		virtual void UnBind() = 0;
 
 		virtual void SetData(const void* data, size_t size) = 0;
+		// Writes after previously appended data and returns the vertex it starts at, draws
+		// must start there. Data stays valid until the next Append. Only Stream buffers
+		// append, the rest replace their contents and return 0.
+		virtual uint32_t Append(const void* data, size_t size);
 
 		virtual const Layout& GetLayout() const { return m_layout; }
 		virtual void SetLayout(const Layout& layout) { m_layout = layout; }
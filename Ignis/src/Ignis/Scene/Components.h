@@ -3,8 +3,10 @@
 #include "SceneCamera.h"
 #include "Ignis/Core/UUID.h"
 #include "Ignis/Renderer/MaterialData.h"
+#include "Ignis/Renderer/TextLayout.h"
 #include "Ignis/Physics/PhysicsTypes.h"
 
+#include <entt.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -50,6 +52,14 @@ namespace ignis
 		UUID NextSiblingID = UUID::Invalid;
 
 		uint32_t ChildrenCount = 0;
+
+		// Handle mirror of the IDs above so traversal skips the UUID map. Not serialized,
+		// Scene::ResolveRelationships rebuilds it after a load or a registry copy.
+		entt::entity Parent = entt::null;
+		entt::entity FirstChild = entt::null;
+		entt::entity LastChild = entt::null;
+		entt::entity PrevSibling = entt::null;
+		entt::entity NextSibling = entt::null;
 	};
 
 	struct TransformComponent : Component
@@ -76,6 +86,16 @@ namespace ignis
 		}
 	};
 
+	// Parent * local, refreshed once per frame by Scene::UpdateWorldTransforms.
+	// Entity::GetWorldTransform stays exact for code that moves entities mid-frame.
+	struct WorldTransformComponent : Component
+	{
+		glm::mat4 World = glm::mat4(1.0f);
+
+		WorldTransformComponent() = default;
+		WorldTransformComponent(const WorldTransformComponent&) = default;
+	};
+
 	struct CameraComponent : Component
 	{
 		std::shared_ptr<SceneCamera> Camera = std::make_shared<SceneCamera>();
@@ -134,6 +154,11 @@ namespace ignis
 	{
 		AssetHandle Mesh;
 		std::vector<MaterialData> MaterialSlots;
+		// Rasterized into the occlusion buffer to hide meshes behind it
+		bool Occluder = false;
+
+		// Runtime only, last LOD picked so selection can apply hysteresis
+		uint32_t CurrentLOD = 0;
 	};
 
 	struct ScriptComponent : Component
@@ -150,6 +175,9 @@ namespace ignis
 		float Alpha = 1.0f;
 		float Scale = 1.0f;
 
+		// Runtime only, glyph quads rebuilt when Text, Font or Scale change
+		TextLayout Layout;
+
 		TextComponent() = default;
 		TextComponent(const std::string& text) : Text(text) {}
 	};
@@ -4,6 +4,16 @@
 
 namespace ignis
 {
+	namespace
+	{
+		// Keeps a serialized UUID link and its handle mirror pointing at the same entity
+		void SetLink(UUID& id, entt::entity& handle, Entity target)
+		{
+			id = target ? target.GetID() : UUID::Invalid;
+			handle = target ? target.GetHandle() : entt::null;
+		}
+	}
+
 	Entity::Entity(entt::entity handle, Scene* scene)
 		: m_handle(handle), m_scene(scene)
 	{
@@ -29,7 +39,8 @@ namespace ignis
 
 	Entity Entity::GetParent() const
 	{
-		return m_scene->GetEntityByID(GetParentID());
+		entt::entity parent = GetComponent<RelationshipComponent>().Parent;
+		return parent != entt::null ? Entity(parent, m_scene) : Entity();
 	}
 
 	void Entity::SetParent(Entity new_parent)
@@ -68,36 +79,33 @@ namespace ignis
 			ancestor = ancestor.GetParent();
 		}
 
-		UUID new_parent_id = new_parent.GetID();
-		UUID my_id = GetID();
-
 		auto& my_rel = GetComponent<RelationshipComponent>();
 		auto& parent_rel = new_parent.GetComponent<RelationshipComponent>();
 
-		my_rel.ParentID = new_parent_id;
+		SetLink(my_rel.ParentID, my_rel.Parent, new_parent);
 
 		if (parent_rel.ChildrenCount == 0)
 		{
-			parent_rel.FirstChildID = my_id;
-			parent_rel.LastChildID = my_id;
+			SetLink(parent_rel.FirstChildID, parent_rel.FirstChild, *this);
+			SetLink(parent_rel.LastChildID, parent_rel.LastChild, *this);
 
-			my_rel.PrevSiblingID = UUID::Invalid;
-			my_rel.NextSiblingID = UUID::Invalid;
+			SetLink(my_rel.PrevSiblingID, my_rel.PrevSibling, {});
+			SetLink(my_rel.NextSiblingID, my_rel.NextSibling, {});
 		}
 		else
 		{
-			UUID old_last_id = parent_rel.LastChildID;
-			Entity old_last_entity = m_scene->GetEntityByID(old_last_id);
-			auto& old_last_rel = old_last_entity.GetComponent<RelationshipComponent>();
+			Entity old_last(parent_rel.LastChild, m_scene);
+			auto& old_last_rel = old_last.GetComponent<RelationshipComponent>();
 
-			old_last_rel.NextSiblingID = my_id;
-			my_rel.PrevSiblingID = old_last_id;
-			my_rel.NextSiblingID = UUID::Invalid;
+			SetLink(old_last_rel.NextSiblingID, old_last_rel.NextSibling, *this);
+			SetLink(my_rel.PrevSiblingID, my_rel.PrevSibling, old_last);
+			SetLink(my_rel.NextSiblingID, my_rel.NextSibling, {});
 
-			parent_rel.LastChildID = my_id;
+			SetLink(parent_rel.LastChildID, parent_rel.LastChild, *this);
 		}
 
 		parent_rel.ChildrenCount++;
+		m_scene->m_hierarchy_version++;
 	}
 
 	void Entity::Unparent()
@@ -108,37 +116,37 @@ namespace ignis
 		auto& my_rel = GetComponent<RelationshipComponent>();
 		auto& parent_rel = parent.GetComponent<RelationshipComponent>();
 
-		UUID my_id = GetID();
-		UUID prev_id = my_rel.PrevSiblingID;
-		UUID next_id = my_rel.NextSiblingID;
+		Entity prev = my_rel.PrevSibling != entt::null ? Entity(my_rel.PrevSibling, m_scene) : Entity();
+		Entity next = my_rel.NextSibling != entt::null ? Entity(my_rel.NextSibling, m_scene) : Entity();
 
-		if (parent_rel.FirstChildID == my_id)
+		if (parent_rel.FirstChild == m_handle)
 		{
-			parent_rel.FirstChildID = next_id;
+			SetLink(parent_rel.FirstChildID, parent_rel.FirstChild, next);
 		}
 
-		if (parent_rel.LastChildID == my_id)
+		if (parent_rel.LastChild == m_handle)
 		{
-			parent_rel.LastChildID = prev_id;
+			SetLink(parent_rel.LastChildID, parent_rel.LastChild, prev);
 		}
 
-		if (prev_id)
+		if (prev)
 		{
-			Entity prev_entity = m_scene->GetEntityByID(prev_id);
-			prev_entity.GetComponent<RelationshipComponent>().NextSiblingID = next_id;
+			auto& prev_rel = prev.GetComponent<RelationshipComponent>();
+			SetLink(prev_rel.NextSiblingID, prev_rel.NextSibling, next);
 		}
 
-		if (next_id)
+		if (next)
 		{
-			Entity next_entity = m_scene->GetEntityByID(next_id);
-			next_entity.GetComponent<RelationshipComponent>().PrevSiblingID = prev_id;
+			auto& next_rel = next.GetComponent<RelationshipComponent>();
+			SetLink(next_rel.PrevSiblingID, next_rel.PrevSibling, prev);
 		}
 
-		my_rel.ParentID = UUID::Invalid;
-		my_rel.PrevSiblingID = UUID::Invalid;
-		my_rel.NextSiblingID = UUID::Invalid;
+		SetLink(my_rel.ParentID, my_rel.Parent, {});
+		SetLink(my_rel.PrevSiblingID, my_rel.PrevSibling, {});
+		SetLink(my_rel.NextSiblingID, my_rel.NextSibling, {});
 
 		parent_rel.ChildrenCount--;
+		m_scene->m_hierarchy_version++;
 	}
 
 	void Entity::AddChild(Entity child)
@@ -164,16 +172,11 @@ namespace ignis
 	std::vector<Entity> Entity::GetChildren() const
 	{
 		std::vector<Entity> children;
+		children.reserve(GetComponent<RelationshipComponent>().ChildrenCount);
 
-		const auto& rel = GetComponent<RelationshipComponent>();
-		UUID current_id = rel.FirstChildID;
-
-		while (current_id != UUID::Invalid)
+		for (Entity child : Children())
 		{
-			Entity child = m_scene->GetEntityByID(current_id);
 			children.push_back(child);
-
-			current_id = child.GetComponent<RelationshipComponent>().NextSiblingID;
 		}
 
 		return children;
@@ -196,76 +199,76 @@ namespace ignis
 
 		if (target_prev_sibling)
 		{
-			if (my_rel.PrevSiblingID == target_prev_sibling.GetID()) return;
+			if (my_rel.PrevSibling == target_prev_sibling.m_handle) return;
 		}
 		else
 		{
-			if (my_rel.PrevSiblingID == UUID::Invalid) return;
+			if (my_rel.PrevSibling == entt::null) return;
 		}
 
 		auto& parent_rel = parent.GetComponent<RelationshipComponent>();
 
-		UUID my_id = GetID();
-		UUID old_prev_id = my_rel.PrevSiblingID;
-		UUID old_next_id = my_rel.NextSiblingID;
+		Entity old_prev = my_rel.PrevSibling != entt::null ? Entity(my_rel.PrevSibling, m_scene) : Entity();
+		Entity old_next = my_rel.NextSibling != entt::null ? Entity(my_rel.NextSibling, m_scene) : Entity();
 
-		if (old_prev_id != UUID::Invalid)
+		if (old_prev)
 		{
-			Entity old_prev = m_scene->GetEntityByID(old_prev_id);
-			old_prev.GetComponent<RelationshipComponent>().NextSiblingID = old_next_id;
+			auto& old_prev_rel = old_prev.GetComponent<RelationshipComponent>();
+			SetLink(old_prev_rel.NextSiblingID, old_prev_rel.NextSibling, old_next);
 		}
-		if (old_next_id != UUID::Invalid)
+		if (old_next)
 		{
-			Entity old_next = m_scene->GetEntityByID(old_next_id);
-			old_next.GetComponent<RelationshipComponent>().PrevSiblingID = old_prev_id;
+			auto& old_next_rel = old_next.GetComponent<RelationshipComponent>();
+			SetLink(old_next_rel.PrevSiblingID, old_next_rel.PrevSibling, old_prev);
 		}
 
-		if (parent_rel.FirstChildID == my_id)
-			parent_rel.FirstChildID = old_next_id;
-		if (parent_rel.LastChildID == my_id)
-			parent_rel.LastChildID = old_prev_id;
+		if (parent_rel.FirstChild == m_handle)
+			SetLink(parent_rel.FirstChildID, parent_rel.FirstChild, old_next);
+		if (parent_rel.LastChild == m_handle)
+			SetLink(parent_rel.LastChildID, parent_rel.LastChild, old_prev);
 
 
 		if (target_prev_sibling)
 		{
-			UUID target_id = target_prev_sibling.GetID();
 			auto& target_rel = target_prev_sibling.GetComponent<RelationshipComponent>();
-			UUID target_next_id = target_rel.NextSiblingID;
+			Entity target_next = target_rel.NextSibling != entt::null ? Entity(target_rel.NextSibling, m_scene) : Entity();
 
-			my_rel.PrevSiblingID = target_id;
-			my_rel.NextSiblingID = target_next_id;
+			SetLink(my_rel.PrevSiblingID, my_rel.PrevSibling, target_prev_sibling);
+			SetLink(my_rel.NextSiblingID, my_rel.NextSibling, target_next);
 
-			target_rel.NextSiblingID = my_id;
+			SetLink(target_rel.NextSiblingID, target_rel.NextSibling, *this);
 
-			if (target_next_id != UUID::Invalid)
+			if (target_next)
 			{
-				Entity target_next = m_scene->GetEntityByID(target_next_id);
-				target_next.GetComponent<RelationshipComponent>().PrevSiblingID = my_id;
+				auto& target_next_rel = target_next.GetComponent<RelationshipComponent>();
+				SetLink(target_next_rel.PrevSiblingID, target_next_rel.PrevSibling, *this);
 			}
 			else
 			{
-				parent_rel.LastChildID = my_id;
+				SetLink(parent_rel.LastChildID, parent_rel.LastChild, *this);
 			}
 		}
 		else
 		{
-			UUID old_first_id = parent_rel.FirstChildID;
+			Entity old_first = parent_rel.FirstChild != entt::null ? Entity(parent_rel.FirstChild, m_scene) : Entity();
 
-			my_rel.PrevSiblingID = UUID::Invalid;
-			my_rel.NextSiblingID = old_first_id;
+			SetLink(my_rel.PrevSiblingID, my_rel.PrevSibling, {});
+			SetLink(my_rel.NextSiblingID, my_rel.NextSibling, old_first);
 
-			parent_rel.FirstChildID = my_id;
+			SetLink(parent_rel.FirstChildID, parent_rel.FirstChild, *this);
 
-			if (old_first_id != UUID::Invalid)
+			if (old_first)
 			{
-				Entity old_first = m_scene->GetEntityByID(old_first_id);
-				old_first.GetComponent<RelationshipComponent>().PrevSiblingID = my_id;
+				auto& old_first_rel = old_first.GetComponent<RelationshipComponent>();
+				SetLink(old_first_rel.PrevSiblingID, old_first_rel.PrevSibling, *this);
 			}
 			else
 			{
-				parent_rel.LastChildID = my_id;
+				SetLink(parent_rel.LastChildID, parent_rel.LastChild, *this);
 			}
 		}
+
+		m_scene->m_hierarchy_version++;
 	}
 
 	void Entity::SetSiblingIndex(int index)
@@ -280,16 +283,14 @@ namespace ignis
 		if (index >= child_count) index = child_count - 1;
 
 		int current_index = -1;
-		UUID current_search_id = parent_rel.FirstChildID;
 		int search_i = 0;
-		while (current_search_id != UUID::Invalid)
+		for (Entity child : parent.Children())
 		{
-			if (current_search_id == GetID())
+			if (child == *this)
 			{
 				current_index = search_i;
 				break;
 			}
-			current_search_id = m_scene->GetEntityByID(current_search_id).GetComponent<RelationshipComponent>().NextSiblingID;
 			search_i++;
 		}
 
@@ -313,17 +314,15 @@ namespace ignis
 		else
 		{
 			Entity target_prev = Entity();
-			UUID curr_id = parent_rel.FirstChildID;
 			int curr_idx = 0;
 
-			while (curr_id != UUID::Invalid)
+			for (Entity child : parent.Children())
 			{
 				if (curr_idx == target_prev_index)
 				{
-					target_prev = m_scene->GetEntityByID(curr_id);
+					target_prev = child;
 					break;
 				}
-				curr_id = m_scene->GetEntityByID(curr_id).GetComponent<RelationshipComponent>().NextSiblingID;
 				curr_idx++;
 			}
 
@@ -460,6 +459,7 @@ namespace ignis
 			auto& dst_mesh = destination.AddComponent<MeshComponent>();
 			dst_mesh.Mesh = src_mesh.Mesh;
 			dst_mesh.MaterialSlots = src_mesh.MaterialSlots;
+			dst_mesh.Occluder = src_mesh.Occluder;
 		}
 
 		// Copy ScriptComponent
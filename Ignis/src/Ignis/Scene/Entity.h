@@ -12,6 +12,9 @@ namespace ignis
 	class IGNIS_API Entity
 	{
 	public:
+		class ChildIterator;
+		struct ChildRange;
+
 		Entity() = default;
 		Entity(entt::entity handle, Scene* scene);
 		~Entity() = default;
@@ -37,6 +40,7 @@ namespace ignis
 
 		operator bool() const;
 		operator uint32_t() const { return static_cast<uint32_t>(m_handle); }
+		entt::entity GetHandle() const { return m_handle; }
 
 		UUID GetID() const;
 		UUID GetParentID() const;
@@ -46,6 +50,9 @@ namespace ignis
 		void AddChild(Entity child);
 		void RemoveChild(Entity child);
 		std::vector<Entity> GetChildren() const;
+
+		// Non-allocating walk over the direct children, children must not be reparented while iterating
+		ChildRange Children() const;
 		
 		template<std::invocable<Entity> Func>
 		void ForEachChild(Func func);
@@ -68,4 +75,29 @@ namespace ignis
 
 		friend class Scene;
 	};
+
+	class Entity::ChildIterator
+	{
+	public:
+		ChildIterator(entt::entity handle, Scene* scene)
+			: m_handle(handle), m_scene(scene) {}
+
+		Entity operator*() const { return Entity(m_handle, m_scene); }
+		ChildIterator& operator++();
+
+		bool operator==(const ChildIterator& other) const { return m_handle == other.m_handle; }
+		bool operator!=(const ChildIterator& other) const { return m_handle != other.m_handle; }
+
+	private:
+		entt::entity m_handle;
+		Scene* m_scene;
+	};
+
+	struct Entity::ChildRange
+	{
+		ChildIterator First;
+
+		ChildIterator begin() const { return First; }
+		ChildIterator end() const { return ChildIterator(entt::null, nullptr); }
+	};
 }
\ No newline at end of file
@@ -34,18 +34,28 @@ namespace ignis
 	template<std::invocable<Entity> Func>
 	void Entity::ForEachChild(Func func)
 	{
-		const auto& rel = GetComponent<RelationshipComponent>();
-		UUID current_id = rel.FirstChildID;
+		auto& registry = m_scene->m_registry;
+		entt::entity current = registry.get<RelationshipComponent>(m_handle).FirstChild;
 
-		while (current_id != UUID::Invalid)
+		while (current != entt::null)
 		{
-			Entity child = m_scene->GetEntityByID(current_id);
+			// Read ahead so func may reparent the child
+			entt::entity next = registry.get<RelationshipComponent>(current).NextSibling;
 
-			UUID next_id = child.GetComponent<RelationshipComponent>().NextSiblingID;
+			func(Entity(current, m_scene));
 
-			func(child);
-
-			current_id = next_id;
+			current = next;
 		}
 	}
+
+	inline Entity::ChildRange Entity::Children() const
+	{
+		return { ChildIterator(GetComponent<RelationshipComponent>().FirstChild, m_scene) };
+	}
+
+	inline Entity::ChildIterator& Entity::ChildIterator::operator++()
+	{
+		m_handle = m_scene->m_registry.get<RelationshipComponent>(m_handle).NextSibling;
+		return *this;
+	}
 }
\ No newline at end of file
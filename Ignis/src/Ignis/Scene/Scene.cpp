@@ -1,6 +1,7 @@
 #include "Scene.h"
 #include "Entity.h"
 #include "Ignis/Asset/AssetManager.h"
+#include "Ignis/Core/JobSystem.h"
 #include "Ignis/Renderer/SceneRenderer.h"
 #include "Ignis/Script/ScriptBehaviour.h"
 #include "Ignis/Script/ScriptRegistry.h"
@@ -8,19 +9,26 @@
 
 namespace ignis
 {
-	// Helper template for copying components from source to destination registry
+	// Copies a whole component pool into a registry that already holds the same entity handles
 	template<typename T>
-	static void CopyComponent(entt::registry& dst_registry, entt::registry& src_registry, 
-	                          const std::unordered_map<UUID, entt::entity>& entt_map)
+	static void CloneComponent(entt::registry& dst_registry, entt::registry& src_registry)
 	{
-		auto src_entities = src_registry.view<T>();
-		for (auto src_entity : src_entities)
-		{
-			entt::entity dest_entity = entt_map.at(src_registry.get<IDComponent>(src_entity).ID);
-			auto& src_component = src_registry.get<T>(src_entity);
-			dst_registry.emplace_or_replace<T>(dest_entity, src_component);
-		}
+		auto& src_storage = src_registry.storage<T>();
+		if (src_storage.empty())
+			return;
+
+		// Element and entity iterators walk the pool in the same order
+		const entt::sparse_set& src_entities = src_storage;
+		dst_registry.storage<T>().reserve(src_storage.size());
+		dst_registry.insert<T>(src_entities.begin(), src_entities.end(), src_storage.begin());
 	}
+
+	static uint64_t s_light_environment_version = 0;
+
+	// Per job, smaller scenes cull and sync on the calling thread
+	static constexpr uint32_t k_min_meshes_per_cull_job = 256;
+	static constexpr uint32_t k_min_bodies_per_sync_job = 256;
+
 	Entity Scene::CreateEntity(const std::string name)
 	{
 		return CreateEntity({}, name);
@@ -36,6 +44,7 @@ namespace ignis
 		entity.AddComponent<RelationshipComponent>();
 
 		entity.AddComponent<TransformComponent>();
+		entity.AddComponent<WorldTransformComponent>();
 		entity.AddComponent<TagComponent>(name.empty() ? "Entity" : name);
 
 		if (parent.IsValid())
@@ -61,6 +70,7 @@ namespace ignis
 		entity.AddComponent<RelationshipComponent>();
 
 		entity.AddComponent<TransformComponent>();
+		entity.AddComponent<WorldTransformComponent>();
 		entity.AddComponent<TagComponent>(name.empty() ? "Entity" : name);
 
 		if (parent.IsValid())
@@ -108,10 +118,32 @@ namespace ignis
 		
 		// Destroy the entity in the registry
 		m_registry.destroy(entity.m_handle);
+		m_hierarchy_version++;
 		
 		Log::CoreInfo("Scene: Destroyed entity {}", entity_id.ToString());
 	}
 
+	void Scene::ResolveRelationships()
+	{
+		auto resolve = [this](UUID id)
+			{
+				const auto it = m_id_entity_map.find(id);
+				return it != m_id_entity_map.end() ? it->second.m_handle : entt::null;
+			};
+
+		auto view = m_registry.view<RelationshipComponent>();
+		view.each([&](RelationshipComponent& relationship)
+			{
+				relationship.Parent = resolve(relationship.ParentID);
+				relationship.FirstChild = resolve(relationship.FirstChildID);
+				relationship.LastChild = resolve(relationship.LastChildID);
+				relationship.PrevSibling = resolve(relationship.PrevSiblingID);
+				relationship.NextSibling = resolve(relationship.NextSiblingID);
+			});
+
+		m_hierarchy_version++;
+	}
+
 	std::shared_ptr<Camera> Scene::GetPrimaryCamera()
 	{
 		std::shared_ptr<Camera> result;
@@ -153,8 +185,16 @@ namespace ignis
 		out_quadratic = (1.0f / edge - 1.0f) / (range * range);
 	}
 
-	void Scene::OnRender(const SceneRenderer& scene_renderer)
+	void Scene::UpdateWorldTransforms()
 	{
+		m_transform_hierarchy.Update(*this);
+	}
+
+	void Scene::UpdateLightEnvironment()
+	{
+		UpdateWorldTransforms();
+
+		LightEnvironment previous_lights = std::move(m_light_environment);
 		m_light_environment = LightEnvironment();
 
 		// -------------------------
@@ -168,8 +208,7 @@ namespace ignis
 				{
 					if (light_index >= LightEnvironment::MaxDirectionalLights) return;
 
-					Entity entity(entity_handle, this);
-					glm::mat4 world_transform = entity.GetWorldTransform();
+					const glm::mat4& world_transform = m_registry.get<WorldTransformComponent>(entity_handle).World;
 					glm::vec3 direction = glm::normalize(glm::mat3(world_transform) * glm::vec3(0.0f, 0.0f, -1.0f));
 
 					m_light_environment.DirectionalLights.emplace_back
@@ -196,8 +235,7 @@ namespace ignis
 					float quadratic = 0.0f;
 					ComputeAttenuationFromRange(light.Range, linear, quadratic);
 
-					Entity entity(entity_handle, this);
-					glm::mat4 world_transform = entity.GetWorldTransform();
+					const glm::mat4& world_transform = m_registry.get<WorldTransformComponent>(entity_handle).World;
 					glm::vec3 world_position = glm::vec3(world_transform[3]);
 
 					m_light_environment.PointLights.emplace_back
@@ -206,7 +244,8 @@ namespace ignis
 						light.Color * light.Intensity,
 						1.0f,
 						linear,
-						quadratic
+						quadratic,
+						light.Range
 					);
 					light_index++;
 				});
@@ -231,8 +270,7 @@ namespace ignis
 					float outer = light.OuterConeAngle;
 					if (inner > outer) std::swap(inner, outer);
 
-					Entity entity(entity_handle, this);
-					glm::mat4 world_transform = entity.GetWorldTransform();
+					const glm::mat4& world_transform = m_registry.get<WorldTransformComponent>(entity_handle).World;
 					glm::vec3 world_position = glm::vec3(world_transform[3]);
 					glm::vec3 direction = glm::normalize(glm::mat3(world_transform) * glm::vec3(0.0f, 0.0f, -1.0f));
 
@@ -245,12 +283,31 @@ namespace ignis
 						linear,
 						quadratic,
 						glm::cos(glm::radians(inner)),
-						glm::cos(glm::radians(outer))
+						glm::cos(glm::radians(outer)),
+						light.Range
 					);
 					light_index++;
 				});
 		}
 
+		if (m_light_environment.DirectionalLights == previous_lights.DirectionalLights
+			&& m_light_environment.PointLights == previous_lights.PointLights
+			&& m_light_environment.SpotLights == previous_lights.SpotLights)
+		{
+			m_light_environment.Version = previous_lights.Version;
+		}
+		else
+		{
+			// Versions are unique across scenes so a renderer shared by several scenes can skip re-uploads
+			m_light_environment.Version = ++s_light_environment_version;
+		}
+	}
+
+	void Scene::OnRender(SceneRenderer& scene_renderer)
+	{
+		// Usually a no-op here, BeginScene already updated them while gathering lights
+		UpdateWorldTransforms();
+
 		// -------------------------
 		// SkyLight
 		// -------------------------
@@ -289,57 +346,89 @@ namespace ignis
 		// Mesh
 		// -------------------------
 		{
+			// SceneRenderer sorts by pass, state and depth, submission order does not matter
 			auto meshes = m_registry.group<MeshComponent>(entt::get<TransformComponent>);
 
+			struct MeshCandidate
 			{
-				auto meshes = m_registry.group<MeshComponent>(entt::get<TransformComponent>);
+				Mesh* MeshPtr;
+				MeshComponent* Component;
+				glm::mat4 Transform;
+			};
+			std::vector<MeshCandidate> candidates;
+			std::vector<BoundingSphere> world_spheres;
+			candidates.reserve(meshes.size());
+			world_spheres.reserve(meshes.size());
+
+			meshes.each([&](auto entity_handle, MeshComponent& mesh_component, TransformComponent& transform)
+				{
+					if (auto mesh = AssetManager::GetAsset<Mesh>(mesh_component.Mesh))
+					{
+						const glm::mat4& world_transform = m_registry.get<WorldTransformComponent>(entity_handle).World;
+						candidates.push_back({ mesh.get(), &mesh_component, world_transform });
+					}
+				});
 
-				struct MeshDrawCall
+			// Asset lookups stay on this thread, bounds and the frustum test are split into jobs
+			world_spheres.resize(candidates.size());
+			std::vector<uint8_t> visible(candidates.size());
+			const Frustum& frustum = scene_renderer.GetFrustum();
+			JobSystem::ParallelFor("Scene::CullMeshes", static_cast<uint32_t>(candidates.size()), k_min_meshes_per_cull_job,
+				[&](uint32_t begin, uint32_t end)
 				{
-					Mesh* MeshPtr;
-					glm::mat4 Transform;
-					bool IsBlend;
-				};
-				std::vector<MeshDrawCall> draw_calls;
+					for (uint32_t i = begin; i < end; i++)
+						world_spheres[i] = candidates[i].MeshPtr->GetBoundingSphere().Transform(candidates[i].Transform);
+					frustum.TestSpheres(world_spheres.data() + begin, end - begin, visible.data() + begin);
+				});
 
-				meshes.each([&](auto entity_handle, MeshComponent& mesh_component, TransformComponent& transform)
-					{
-						if (auto mesh = AssetManager::GetAsset<Mesh>(mesh_component.Mesh))
-						{
-							const uint32_t slot_count = static_cast<uint32_t>(mesh_component.MaterialSlots.size());
-							for (uint32_t i = 0; i < slot_count; i++)
-							{
-								mesh->SetMaterialData(i, mesh_component.MaterialSlots[i]);
-							}
-
-							bool has_blend = false;
-							for (const auto& mat : mesh->GetMaterialsData())
-							{
-								if (mat.Alpha == AlphaMode::Blend)
-								{
-									has_blend = true;
-									break;
-								}
-							}
-
-							Entity entity(entity_handle, this);
-							draw_calls.push_back({ mesh.get(), entity.GetWorldTransform(), has_blend });
-						}
-					});
+			auto& stats = Renderer::GetStats();
 
-				// Pass 1: Opaque / Mask
-				for (const auto& dc : draw_calls)
+			// Occluders that survived the frustum test are rasterized before anything is tested against them
+			auto& occlusion_buffer = scene_renderer.GetOcclusionBuffer();
+			const bool occlusion_culling = scene_renderer.IsOcclusionCullingEnabled();
+			if (occlusion_culling)
+			{
+				for (size_t c = 0; c < candidates.size(); c++)
 				{
-					if (!dc.IsBlend)
-						scene_renderer.SubmitMesh(*dc.MeshPtr, dc.Transform);
+					const auto& candidate = candidates[c];
+					if (visible[c] && candidate.Component->Occluder)
+						occlusion_buffer.AddOccluder(candidate.MeshPtr->GetOccluder(), candidate.Transform);
 				}
+				occlusion_buffer.Rasterize();
+				stats.OccluderTriangles = occlusion_buffer.GetTriangleCount();
+			}
+
+			for (size_t c = 0; c < candidates.size(); c++)
+			{
+				if (!visible[c])
+				{
+					stats.MeshesCulled++;
+					continue;
+				}
+
+				const auto& candidate = candidates[c];
+				if (occlusion_culling && occlusion_buffer.HasOccluders() && !candidate.Component->Occluder)
+				{
+					stats.OcclusionTests++;
+					if (!occlusion_buffer.IsVisible(candidate.MeshPtr->GetBounds().Transform(candidate.Transform)))
+					{
+						stats.MeshesOccluded++;
+						continue;
+					}
+				}
+				stats.MeshesVisible++;
 
-				// Pass 2: Blend
-				for (const auto& dc : draw_calls)
+				const uint32_t slot_count = static_cast<uint32_t>(candidate.Component->MaterialSlots.size());
+				for (uint32_t i = 0; i < slot_count; i++)
 				{
-					if (dc.IsBlend)
-						scene_renderer.SubmitMesh(*dc.MeshPtr, dc.Transform);
+					candidate.MeshPtr->SetMaterialData(i, candidate.Component->MaterialSlots[i]);
 				}
+
+				candidate.Component->CurrentLOD = scene_renderer.SelectLOD(*candidate.MeshPtr, world_spheres[c], candidate.Component->CurrentLOD);
+				if (candidate.Component->CurrentLOD > 0)
+					stats.ReducedLODMeshes++;
+
+				scene_renderer.SubmitMesh(*candidate.MeshPtr, candidate.Transform, candidate.Component->CurrentLOD);
 			}
 		}
 
@@ -353,13 +442,12 @@ namespace ignis
 				{
 					if (auto font = AssetManager::GetAsset<Font>(text_component.Font))
 					{
-						Entity entity(entity_handle, this);
+						text_component.Layout.Update(*font, text_component.Text, text_component.Scale);
 						scene_renderer.SubmitText(
 							*font,
-							text_component.Text,
-							entity.GetWorldTransform(),
-							glm::vec4(text_component.Color, text_component.Alpha),
-							text_component.Scale
+							text_component.Layout,
+							m_registry.get<WorldTransformComponent>(entity_handle).World,
+							glm::vec4(text_component.Color, text_component.Alpha)
 						);
 					}
 				});
@@ -437,11 +525,13 @@ namespace ignis
 				it->second.GetBehaviour().OnUpdate(dt);
 			});
 
-		auto cameras = m_registry.view<CameraComponent, TransformComponent>();
-		cameras.each([&](entt::entity entity_handle, CameraComponent& camera_component, TransformComponent&)
+		// Scripts and physics have moved things, cameras and audio read the refreshed cache
+		UpdateWorldTransforms();
+
+		auto cameras = m_registry.view<CameraComponent, WorldTransformComponent>();
+		cameras.each([&](CameraComponent& camera_component, WorldTransformComponent& world_transform)
 			{
-				Entity entity(entity_handle, this);
-				camera_component.Camera->SetViewFromWorldTransform(entity.GetWorldTransform());
+				camera_component.Camera->SetViewFromWorldTransform(world_transform.World);
 			});
 
 		if (m_audio_system)
@@ -501,68 +591,59 @@ namespace ignis
 		target->m_scene_environment = m_scene_environment;
 		target->m_environment_settings = m_environment_settings;
 		
-		// Step 1: Create all entities with preserved UUIDs in consistent order
-		std::unordered_map<UUID, entt::entity> entt_map;
+		// Step 1: Recreate every entity under the same handle in a fresh registry, so components,
+		// relationship handles and the ID map can be copied without remapping
+		target->m_registry = entt::registry();
+		target->m_id_entity_map.clear();
+		target->m_hierarchy_version++;
+
 		auto id_components = m_registry.view<IDComponent>();
-		
-		// Sort entities by their entt::entity handle to ensure consistent creation order
-		std::vector<entt::entity> sorted_entities;
-		sorted_entities.reserve(id_components.size());
+		target->m_registry.storage<entt::entity>().reserve(id_components.size());
+		target->m_id_entity_map.reserve(id_components.size());
 		for (auto entity : id_components)
 		{
-			sorted_entities.push_back(entity);
-		}
-		std::sort(sorted_entities.begin(), sorted_entities.end());
-		
-		// Create entities in sorted order
-		for (auto entity : sorted_entities)
-		{
-			auto uuid = m_registry.get<IDComponent>(entity).ID;
-			auto name = m_registry.get<TagComponent>(entity).Tag;
-			Entity e = target->CreateEntityWithID(uuid, name);
-			entt_map[uuid] = e.m_handle;
-		}
-		
-		// Step 2: Copy all component types
-		CopyComponent<IDComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<TagComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<TransformComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<RelationshipComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<CameraComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<DirectionalLightComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<PointLightComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<SpotLightComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<SkyLightComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<MeshComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<ScriptComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<TextComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<RectTransformComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<CanvasComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<ImageComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<UITextComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<ButtonComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<ProgressBarComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<AudioSourceComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<AudioListenerComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<RigidBodyComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<BoxColliderComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<SphereColliderComponent>(target->m_registry, m_registry, entt_map);
-		CopyComponent<CapsuleColliderComponent>(target->m_registry, m_registry, entt_map);
+			const entt::entity created = target->m_registry.create(entity);
+			assert(created == entity && "A fresh registry hands out the requested handle");
+			target->m_id_entity_map.emplace(id_components.get<IDComponent>(entity).ID, Entity(created, target.get()));
+		}
+		
+		// Step 2: Copy all component pools
+		CloneComponent<IDComponent>(target->m_registry, m_registry);
+		CloneComponent<TagComponent>(target->m_registry, m_registry);
+		CloneComponent<TransformComponent>(target->m_registry, m_registry);
+		CloneComponent<WorldTransformComponent>(target->m_registry, m_registry);
+		CloneComponent<RelationshipComponent>(target->m_registry, m_registry);
+		CloneComponent<CameraComponent>(target->m_registry, m_registry);
+		CloneComponent<DirectionalLightComponent>(target->m_registry, m_registry);
+		CloneComponent<PointLightComponent>(target->m_registry, m_registry);
+		CloneComponent<SpotLightComponent>(target->m_registry, m_registry);
+		CloneComponent<SkyLightComponent>(target->m_registry, m_registry);
+		CloneComponent<MeshComponent>(target->m_registry, m_registry);
+		CloneComponent<ScriptComponent>(target->m_registry, m_registry);
+		CloneComponent<TextComponent>(target->m_registry, m_registry);
+		CloneComponent<RectTransformComponent>(target->m_registry, m_registry);
+		CloneComponent<CanvasComponent>(target->m_registry, m_registry);
+		CloneComponent<ImageComponent>(target->m_registry, m_registry);
+		CloneComponent<UITextComponent>(target->m_registry, m_registry);
+		CloneComponent<ButtonComponent>(target->m_registry, m_registry);
+		CloneComponent<ProgressBarComponent>(target->m_registry, m_registry);
+		CloneComponent<AudioSourceComponent>(target->m_registry, m_registry);
+		CloneComponent<AudioListenerComponent>(target->m_registry, m_registry);
+		CloneComponent<RigidBodyComponent>(target->m_registry, m_registry);
+		CloneComponent<BoxColliderComponent>(target->m_registry, m_registry);
+		CloneComponent<SphereColliderComponent>(target->m_registry, m_registry);
+		CloneComponent<CapsuleColliderComponent>(target->m_registry, m_registry);
 		
 		// Step 3: Deep copy camera instances (avoid shared camera between scenes)
-		auto cameras = m_registry.view<CameraComponent>();
-		for (auto src_entity : cameras)
-		{
-			entt::entity dest_entity = entt_map.at(m_registry.get<IDComponent>(src_entity).ID);
-			auto& src_camera = m_registry.get<CameraComponent>(src_entity);
-			auto& dest_camera = target->m_registry.get<CameraComponent>(dest_entity);
-			
-			// Create new camera instance with same settings
-			dest_camera.Camera = std::make_shared<SceneCamera>(*src_camera.Camera);
-		}
+		auto cameras = target->m_registry.view<CameraComponent>();
+		cameras.each([](CameraComponent& camera_component)
+			{
+				// Create new camera instance with same settings
+				camera_component.Camera = std::make_shared<SceneCamera>(*camera_component.Camera);
+			});
 		
 		Log::CoreInfo("Scene::CopyTo() - Copied scene '{}' with {} entities", 
-		              m_name, entt_map.size());
+		              m_name, target->m_id_entity_map.size());
 	}
 
 	ScriptBehaviour* Scene::GetRuntimeScript(UUID entity_id)
@@ -672,19 +753,20 @@ namespace ignis
 	{
 		auto view = m_registry.view<RigidBodyComponent, TransformComponent>();
 		
-		for (auto entity_handle : view)
-		{
-			auto& rb = view.get<RigidBodyComponent>(entity_handle);
-			auto& transform = view.get<TransformComponent>(entity_handle);
-			
-			// Only sync dynamic bodies (static/kinematic don't move via physics)
-			if (rb.BodyType == BodyType::Dynamic && rb.RuntimeBody)
+		// Each entity only reads its own body and writes its own transform
+		JobSystem::ParallelForEach("Scene::SyncTransformsFromPhysics", view, k_min_bodies_per_sync_job, [&](entt::entity entity_handle)
 			{
-				transform.Translation = rb.RuntimeBody->GetPosition();
-				glm::quat rotation = rb.RuntimeBody->GetRotation();
-				transform.Rotation = glm::degrees(glm::eulerAngles(rotation));
-			}
-		}
+				auto& rb = view.get<RigidBodyComponent>(entity_handle);
+				auto& transform = view.get<TransformComponent>(entity_handle);
+				
+				// Only sync dynamic bodies (static/kinematic don't move via physics)
+				if (rb.BodyType == BodyType::Dynamic && rb.RuntimeBody)
+				{
+					transform.Translation = rb.RuntimeBody->GetPosition();
+					glm::quat rotation = rb.RuntimeBody->GetRotation();
+					transform.Rotation = glm::degrees(glm::eulerAngles(rotation));
+				}
+			});
 	}
 
 	void Scene::ProcessCollisionCallbacks()
@@ -2,6 +2,7 @@
 
 #include "Ignis/Core/API.h"
 #include "Entity.h"
+#include "TransformHierarchy.h"
 #include "Ignis/Renderer/Environment.h"
 #include "Ignis/Script/Script.h"
 #include "Ignis/Audio/AudioSystem.h"
@@ -16,6 +17,8 @@ namespace ignis
 	{
 		glm::vec3 Direction;
 		glm::vec3 Radiance;
+
+		bool operator==(const DirectionalLight&) const = default;
 	};
 
 	struct PointLight
@@ -25,6 +28,9 @@ namespace ignis
 		float Constant;
 		float Linear;
 		float Quadratic;
+		float Range;
+
+		bool operator==(const PointLight&) const = default;
 	};
 
 	struct SpotLight
@@ -37,17 +43,24 @@ namespace ignis
 		float Quadratic;
 		float CutOff;
 		float OuterCutOff;
+		float Range;
+
+		bool operator==(const SpotLight&) const = default;
 	};
 
 	struct LightEnvironment
 	{
 		static constexpr size_t MaxDirectionalLights = 4;
-		static constexpr size_t MaxPointLights = 16;
-		static constexpr size_t MaxSpotLights = 16;
+		// Point and spot lights are clustered, these only bound the per-frame binning cost
+		static constexpr size_t MaxPointLights = 1024;
+		static constexpr size_t MaxSpotLights = 1024;
 
 		std::vector<DirectionalLight> DirectionalLights;
 		std::vector<PointLight> PointLights;
 		std::vector<SpotLight> SpotLights;
+
+		// Changes only when the gathered lights differ from the previous frame
+		uint64_t Version = 0;
 	};
 
 	class SceneRenderer;
@@ -72,7 +85,10 @@ namespace ignis
 
 		void DestroyEntity(Entity entity);
 
-		void OnRender(const SceneRenderer& scene_renderer);
+		// Recomputes WorldTransformComponent for entities whose transform or an ancestor's changed
+		void UpdateWorldTransforms();
+		void UpdateLightEnvironment();
+		void OnRender(SceneRenderer& scene_renderer);
 	
 		template<typename... Components>
 		auto GetAllEntitiesWith()
@@ -98,6 +114,10 @@ namespace ignis
 		void CopyTo(std::shared_ptr<Scene>& target);
 
 		ScriptBehaviour* GetRuntimeScript(UUID entity_id);
+
+		// Bumped whenever an entity is reparented, reordered among its siblings or destroyed,
+		// lets systems caching a flattened hierarchy tell when to rebuild it
+		uint64_t GetHierarchyVersion() const { return m_hierarchy_version; }
 		AudioSystem* GetAudioSystem() { return m_audio_system.get(); }
 		PhysicsWorld* GetPhysicsWorld() { return m_physics_world.get(); }
 
@@ -111,6 +131,11 @@ namespace ignis
 		std::unordered_map<UUID, Script> m_runtime_scripts;
 		std::unique_ptr<AudioSystem> m_audio_system;
 		std::unique_ptr<PhysicsWorld> m_physics_world;
+		uint64_t m_hierarchy_version = 0;
+		TransformHierarchy m_transform_hierarchy;
+
+		// Points the handle links in RelationshipComponent at this registry's entities
+		void ResolveRelationships();
 
 		// Physics helper functions
 		void CreatePhysicsBodies();
@@ -131,6 +156,7 @@ namespace ignis
 		friend class Entity;
 		friend class SceneSerializer;
 		friend class SceneRenderer;
+		friend class TransformHierarchy;
 	};
 }
 
@@ -301,6 +301,7 @@ namespace ignis
 				slots.push_back(SerializeMaterialData(slot));
 			}
 			mesh_data["MaterialSlots"] = slots;
+			mesh_data["Occluder"] = mesh.Occluder;
 
 			entity_data["Mesh"] = mesh_data;
 		}
@@ -647,6 +648,8 @@ namespace ignis
 					mesh.MaterialSlots.push_back(DeserializeMaterialData(slot_data));
 				}
 			}
+
+			mesh.Occluder = mesh_data.value("Occluder", false);
 		}
 
 		if (entity_data.contains("Script"))
@@ -841,6 +844,9 @@ namespace ignis
 			{
 				DeserializeEntity(*scene, entity_data);
 			}
+
+			// Links are read as IDs, the handles exist only once every entity is created
+			scene->ResolveRelationships();
 		}
 
 		Log::CoreInfo("[SceneSerializer::Deserialize] Successfully deserialized scene from: {}", filepath.string());
@@ -0,0 +1,185 @@
+#include "TransformHierarchy.h"
+#include "Scene.h"
+#include "Components.h"
+#include "Ignis/Core/JobSystem.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#include <xmmintrin.h>
+	#define IGNIS_TRANSFORM_SSE 1
+#elif defined(__ARM_NEON)
+	#include <arm_neon.h>
+	#define IGNIS_TRANSFORM_NEON 1
+#endif
+
+namespace ignis
+{
+	namespace
+	{
+		// Same limit Entity::GetWorldTransform uses to stop on circular parent references
+		constexpr int k_max_hierarchy_depth = 1000;
+
+		// Per job, below these the pass stays on the calling thread
+		constexpr uint32_t k_min_compares_per_job = 4096;
+		constexpr uint32_t k_min_composes_per_job = 512;
+
+		// Equivalent to translate * mat4_cast(rotation) * scale without the two full matrix products
+		glm::mat4 ComposeLocal(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale)
+		{
+			glm::mat4 local = glm::mat4_cast(glm::quat(glm::radians(rotation)));
+			local[0] *= scale.x;
+			local[1] *= scale.y;
+			local[2] *= scale.z;
+			local[3] = glm::vec4(translation, 1.0f);
+			return local;
+		}
+
+		// out = parent * local, out must not alias local
+		void MultiplyWorld(const glm::mat4& parent, const glm::mat4& local, glm::mat4& out)
+		{
+#if defined(IGNIS_TRANSFORM_SSE)
+			const __m128 c0 = _mm_loadu_ps(&parent[0][0]);
+			const __m128 c1 = _mm_loadu_ps(&parent[1][0]);
+			const __m128 c2 = _mm_loadu_ps(&parent[2][0]);
+			const __m128 c3 = _mm_loadu_ps(&parent[3][0]);
+			for (int j = 0; j < 4; j++)
+			{
+				__m128 column = _mm_mul_ps(c0, _mm_set1_ps(local[j][0]));
+				column = _mm_add_ps(column, _mm_mul_ps(c1, _mm_set1_ps(local[j][1])));
+				column = _mm_add_ps(column, _mm_mul_ps(c2, _mm_set1_ps(local[j][2])));
+				column = _mm_add_ps(column, _mm_mul_ps(c3, _mm_set1_ps(local[j][3])));
+				_mm_storeu_ps(&out[j][0], column);
+			}
+#elif defined(IGNIS_TRANSFORM_NEON)
+			const float32x4_t c0 = vld1q_f32(&parent[0][0]);
+			const float32x4_t c1 = vld1q_f32(&parent[1][0]);
+			const float32x4_t c2 = vld1q_f32(&parent[2][0]);
+			const float32x4_t c3 = vld1q_f32(&parent[3][0]);
+			for (int j = 0; j < 4; j++)
+			{
+				float32x4_t column = vmulq_n_f32(c0, local[j][0]);
+				column = vmlaq_n_f32(column, c1, local[j][1]);
+				column = vmlaq_n_f32(column, c2, local[j][2]);
+				column = vmlaq_n_f32(column, c3, local[j][3]);
+				vst1q_f32(&out[j][0], column);
+			}
+#else
+			out = parent * local;
+#endif
+		}
+	}
+
+	void TransformHierarchy::Update(Scene& scene)
+	{
+		entt::registry& registry = scene.m_registry;
+		auto transforms = registry.view<TransformComponent>();
+
+		const size_t entity_count = transforms.size();
+		const bool full = m_hierarchy_version != scene.GetHierarchyVersion() || m_entity_count != entity_count;
+		if (full)
+		{
+			Rebuild(scene);
+			m_hierarchy_version = scene.GetHierarchyVersion();
+			m_entity_count = entity_count;
+		}
+
+		// Transform fields are written directly by gameplay, physics and the editor, so changes
+		// are found by comparing against the snapshot. Each node only touches its own slots.
+		const uint32_t node_count = static_cast<uint32_t>(m_handles.size());
+		m_changed.resize(node_count);
+		JobSystem::ParallelFor("TransformHierarchy::Compare", node_count, k_min_compares_per_job, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; i++)
+				{
+					const auto& transform = transforms.get<TransformComponent>(m_handles[i]);
+					const bool changed = full
+						|| transform.Translation != m_translations[i]
+						|| transform.Rotation != m_rotations[i]
+						|| transform.Scale != m_scales[i];
+
+					m_changed[i] = changed ? 1 : 0;
+					if (!changed)
+						continue;
+
+					m_translations[i] = transform.Translation;
+					m_rotations[i] = transform.Rotation;
+					m_scales[i] = transform.Scale;
+				}
+			});
+
+		// Order guarantees parents are seen first
+		m_dirty_nodes.clear();
+		for (uint32_t i = 0; i < node_count; i++)
+		{
+			const uint32_t parent = m_parents[i];
+			const bool dirty = m_changed[i] || (parent != k_no_parent && m_dirty[parent]);
+
+			m_dirty[i] = dirty ? 1 : 0;
+			if (dirty)
+				m_dirty_nodes.push_back(i);
+		}
+
+		m_last_updated_count = static_cast<uint32_t>(m_dirty_nodes.size());
+		if (m_dirty_nodes.empty())
+			return;
+
+		// Locals first over contiguous storage, then worlds in hierarchy order so each parent is final
+		m_local.resize(m_dirty_nodes.size());
+		JobSystem::ParallelFor("TransformHierarchy::ComposeLocal", m_last_updated_count, k_min_composes_per_job, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t k = begin; k < end; k++)
+				{
+					const uint32_t i = m_dirty_nodes[k];
+					m_local[k] = ComposeLocal(m_translations[i], m_rotations[i], m_scales[i]);
+				}
+			});
+
+		for (size_t k = 0; k < m_dirty_nodes.size(); k++)
+		{
+			const uint32_t i = m_dirty_nodes[k];
+			const uint32_t parent = m_parents[i];
+			if (parent == k_no_parent)
+				m_world[i] = m_local[k];
+			else
+				MultiplyWorld(m_world[parent], m_local[k], m_world[i]);
+
+			registry.get_or_emplace<WorldTransformComponent>(m_handles[i]).World = m_world[i];
+		}
+	}
+
+	void TransformHierarchy::Rebuild(Scene& scene)
+	{
+		m_handles.clear();
+		m_parents.clear();
+
+		// Entities whose parent no longer resolves are treated as roots, as GetWorldTransform does
+		auto view = scene.m_registry.view<RelationshipComponent, TransformComponent>();
+		for (auto handle : view)
+		{
+			if (view.get<RelationshipComponent>(handle).Parent == entt::null)
+				FlattenNode(scene, handle, k_no_parent, 0);
+		}
+
+		const size_t count = m_handles.size();
+		m_translations.resize(count);
+		m_rotations.resize(count);
+		m_scales.resize(count);
+		m_world.resize(count);
+		m_dirty.resize(count);
+	}
+
+	void TransformHierarchy::FlattenNode(Scene& scene, entt::entity handle, uint32_t parent, int depth)
+	{
+		if (depth > k_max_hierarchy_depth)
+		{
+			Log::CoreError("TransformHierarchy: depth exceeded {} - possible circular reference", k_max_hierarchy_depth);
+			return;
+		}
+
+		const uint32_t index = static_cast<uint32_t>(m_handles.size());
+		m_handles.push_back(handle);
+		m_parents.push_back(parent);
+
+		for (Entity child : Entity(handle, &scene).Children())
+			FlattenNode(scene, child.GetHandle(), index, depth + 1);
+	}
+}
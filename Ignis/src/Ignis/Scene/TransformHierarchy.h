@@ -0,0 +1,51 @@
+#pragma once
+
+#include <entt.hpp>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace ignis
+{
+	class Scene;
+
+	// Keeps WorldTransformComponent in sync with the local transforms. Entities are
+	// stored flattened in hierarchy order (parent before child) with a snapshot of
+	// each local TRS, so a frame only recomposes the subtrees whose transform changed.
+	class TransformHierarchy
+	{
+	public:
+		void Update(Scene& scene);
+
+		// Forces every world transform to be recomputed on the next update
+		void Invalidate() { m_hierarchy_version = k_invalid_version; }
+
+		uint32_t GetLastUpdatedCount() const { return m_last_updated_count; }
+
+	private:
+		void Rebuild(Scene& scene);
+		void FlattenNode(Scene& scene, entt::entity handle, uint32_t parent, int depth);
+
+		static constexpr uint64_t k_invalid_version = ~0ull;
+		static constexpr uint32_t k_no_parent = ~0u;
+
+		uint64_t m_hierarchy_version = k_invalid_version;
+		size_t m_entity_count = 0;
+
+		std::vector<entt::entity> m_handles;
+		std::vector<uint32_t> m_parents;
+
+		// Local TRS as of the last update, compared against TransformComponent to find changes
+		std::vector<glm::vec3> m_translations;
+		std::vector<glm::vec3> m_rotations;
+		std::vector<glm::vec3> m_scales;
+
+		std::vector<glm::mat4> m_world;
+		std::vector<uint8_t> m_changed;
+		std::vector<uint8_t> m_dirty;
+		std::vector<uint32_t> m_dirty_nodes;
+		std::vector<glm::mat4> m_local;
+
+		uint32_t m_last_updated_count = 0;
+	};
+}
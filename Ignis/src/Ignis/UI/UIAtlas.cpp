@@ -0,0 +1,246 @@
+#include "UIAtlas.h"
+
+#include "Ignis/Asset/AssetManager.h"
+#include "Ignis/Renderer/Texture.h"
+#include "Ignis/Renderer/Image.h"
+
+#include <algorithm>
+
+namespace ignis
+{
+	namespace
+	{
+		// Bigger images would crowd out the small icons the atlas is meant for
+		constexpr uint32_t k_max_image_fraction = 4;
+		// Edge pixels repeated around each image so filtering does not pick up neighbours
+		constexpr uint32_t k_padding = 1;
+		// Mipmapped pages also align images to this, so the first three levels only ever
+		// average texels of the same image
+		constexpr uint32_t k_mip_padding = 8;
+
+		uint32_t GetPadding(const TextureSpecs& specs)
+		{
+			return specs.GenMipmaps ? k_mip_padding : k_padding;
+		}
+
+		glm::uvec2 GetCellSize(const Image& image, uint32_t padding)
+		{
+			auto align = [padding](uint32_t value) { return (value + padding - 1) / padding * padding; };
+			return { align(image.GetWidth() + padding * 2), align(image.GetHeight() + padding * 2) };
+		}
+
+		bool SameSampling(const TextureSpecs& a, const TextureSpecs& b)
+		{
+			return a.Format == b.Format && a.MinFilter == b.MinFilter && a.MagFilter == b.MagFilter && a.GenMipmaps == b.GenMipmaps;
+		}
+
+		// Shelf packing over an x, y, shelf height cursor that only moves when the cell fits
+		bool PlaceOnShelf(uint32_t size, glm::uvec3& cursor, glm::uvec2 cell, glm::uvec2& out_position)
+		{
+			glm::uvec3 next = cursor;
+			if (next.x + cell.x > size)
+				next = { 0, next.y + next.z, 0 };
+			if (next.y + cell.y > size)
+				return false;
+
+			out_position = { next.x, next.y };
+			cursor = { next.x + cell.x, next.y, std::max(next.z, cell.y) };
+			return true;
+		}
+
+		// Writes the image into an RGBA8 cell with its edge pixels repeated out to the cell border
+		void WriteCell(const Image& image, uint32_t padding, glm::uvec2 cell, std::byte* dst, size_t dst_stride)
+		{
+			const uint32_t channels = Channels(image.GetFormat());
+			const std::byte* src = image.GetPixels().data();
+			for (uint32_t y = 0; y < cell.y; y++)
+			{
+				const uint32_t sy = std::clamp<int32_t>(static_cast<int32_t>(y) - padding, 0, image.GetHeight() - 1);
+				std::byte* row = dst + static_cast<size_t>(y) * dst_stride * 4;
+				for (uint32_t x = 0; x < cell.x; x++)
+				{
+					const uint32_t sx = std::clamp<int32_t>(static_cast<int32_t>(x) - padding, 0, image.GetWidth() - 1);
+					const std::byte* texel = src + (static_cast<size_t>(sy) * image.GetWidth() + sx) * channels;
+					row[x * 4 + 0] = texel[0];
+					row[x * 4 + 1] = texel[1];
+					row[x * 4 + 2] = texel[2];
+					row[x * 4 + 3] = channels == 4 ? texel[3] : std::byte{ 255 };
+				}
+			}
+		}
+
+		UIAtlas::Region MakeRegion(glm::uvec2 position, uint32_t padding, const Image& image, uint32_t page, uint32_t size)
+		{
+			const float inv_size = 1.0f / static_cast<float>(size);
+			const glm::vec2 min = glm::vec2(position + padding);
+			return { min * inv_size, (min + glm::vec2(image.GetWidth(), image.GetHeight())) * inv_size, page };
+		}
+	}
+
+	UIAtlas::UIAtlas(uint32_t size)
+		: m_size(size), m_asset_generation(AssetManager::GetGeneration())
+	{
+	}
+
+	void UIAtlas::Request(AssetHandle texture)
+	{
+		ValidateGeneration();
+		if (!m_regions.contains(texture) && !m_rejected.contains(texture))
+			m_pending.insert(texture);
+	}
+
+	void UIAtlas::Cook()
+	{
+		ValidateGeneration();
+		if (m_pending.empty())
+			return;
+
+		const size_t page_count = m_pages.size();
+		uint32_t packed = 0;
+		for (AssetHandle handle : m_pending)
+		{
+			const AssetMetadata* metadata = AssetManager::IsMemoryAsset(handle) ? nullptr : AssetManager::GetMetadata(handle);
+			if (!metadata || metadata->Type != AssetType::Texture2D)
+			{
+				m_rejected.insert(handle);
+				continue;
+			}
+
+			const auto* opts = std::get_if<TextureImportOptions>(&metadata->ImportOptions);
+			const TextureImportOptions options = opts ? *opts : TextureImportOptions{};
+			if (options.InternalFormat != TextureFormat::RGBA8 && options.InternalFormat != TextureFormat::RGBA8_sRGB)
+			{
+				m_rejected.insert(handle);
+				continue;
+			}
+
+			// Same orientation the importer uploaded, so UVs map the same way
+			auto image = Image::LoadFromFile(VFS::Resolve(metadata->FilePath), options.FlipVertical);
+			if (!image || (image->GetFormat() != ImageFormat::RGBA8 && image->GetFormat() != ImageFormat::RGB8)
+				|| image->GetWidth() > m_size / k_max_image_fraction || image->GetHeight() > m_size / k_max_image_fraction)
+			{
+				m_rejected.insert(handle);
+				continue;
+			}
+
+			// Sampled the way the texture itself would be, wrapping aside since regions cannot repeat
+			TextureSpecs specs;
+			specs.Width = m_size;
+			specs.Height = m_size;
+			specs.Format = options.InternalFormat;
+			specs.WrapS = TextureWrap::ClampToEdge;
+			specs.WrapT = TextureWrap::ClampToEdge;
+			specs.MinFilter = options.MinFilter;
+			specs.MagFilter = options.MagFilter;
+			specs.GenMipmaps = options.GenMipmaps;
+
+			if (Insert(handle, specs, image))
+				packed++;
+			else
+				m_rejected.insert(handle);
+		}
+		m_pending.clear();
+
+		Log::CoreInfo("UIAtlas: Packed {} images, {} pages ({} new), {} kept separate",
+			packed, m_pages.size(), m_pages.size() - page_count, m_rejected.size());
+	}
+
+	const UIAtlas::Region* UIAtlas::Find(AssetHandle texture)
+	{
+		ValidateGeneration();
+		auto it = m_regions.find(texture);
+		return it != m_regions.end() ? &it->second : nullptr;
+	}
+
+	void UIAtlas::ValidateGeneration()
+	{
+		if (m_asset_generation == AssetManager::GetGeneration())
+			return;
+		m_asset_generation = AssetManager::GetGeneration();
+
+		// Rects submitted this frame keep their own reference to the old page textures
+		m_pages.clear();
+		m_regions.clear();
+		m_rejected.clear();
+		m_pending.clear();
+	}
+
+	bool UIAtlas::Insert(AssetHandle handle, const TextureSpecs& specs, const std::shared_ptr<Image>& image)
+	{
+		const Entry entry{ handle, image };
+		for (uint32_t i = 0; i < m_pages.size(); i++)
+		{
+			Page& page = m_pages[i];
+			if (page.Full || !SameSampling(page.Specs, specs))
+				continue;
+
+			if (Append(i, entry) || Repack(i, entry))
+				return true;
+			page.Full = true;
+		}
+
+		Page page;
+		page.Specs = specs;
+		page.Texture = Texture2D::Create(specs);
+		m_pages.push_back(std::move(page));
+		return Append(static_cast<uint32_t>(m_pages.size() - 1), entry);
+	}
+
+	bool UIAtlas::Append(uint32_t page_index, const Entry& entry)
+	{
+		Page& page = m_pages[page_index];
+		const Image& image = *entry.Pixels;
+		const uint32_t padding = GetPadding(page.Specs);
+		const glm::uvec2 cell = GetCellSize(image, padding);
+
+		glm::uvec2 position;
+		if (!PlaceOnShelf(m_size, page.Cursor, cell, position))
+			return false;
+
+		// Only the new cell is uploaded, regions already handed out stay where they are
+		std::vector<std::byte> pixels(static_cast<size_t>(cell.x) * cell.y * 4);
+		WriteCell(image, padding, cell, pixels.data(), cell.x);
+		page.Texture->SetSubData(position.x, position.y, cell.x, cell.y, ImageFormat::RGBA8, pixels);
+
+		m_regions[entry.Handle] = MakeRegion(position, padding, image, page_index, m_size);
+		page.Entries.push_back(entry);
+		return true;
+	}
+
+	bool UIAtlas::Repack(uint32_t page_index, const Entry& entry)
+	{
+		Page& page = m_pages[page_index];
+		const uint32_t padding = GetPadding(page.Specs);
+
+		std::vector<Entry> entries = page.Entries;
+		entries.push_back(entry);
+
+		// Tallest first keeps the shelves full
+		std::sort(entries.begin(), entries.end(),
+			[](const Entry& a, const Entry& b) { return a.Pixels->GetHeight() > b.Pixels->GetHeight(); });
+
+		// Laid out before anything is touched, the page stays as it was if this does not fit either
+		glm::uvec3 cursor(0);
+		std::vector<glm::uvec2> positions(entries.size());
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			if (!PlaceOnShelf(m_size, cursor, GetCellSize(*entries[i].Pixels, padding), positions[i]))
+				return false;
+		}
+
+		std::vector<std::byte> pixels(static_cast<size_t>(m_size) * m_size * 4, std::byte{ 0 });
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			const Image& image = *entries[i].Pixels;
+			const glm::uvec2 position = positions[i];
+			WriteCell(image, padding, GetCellSize(image, padding), pixels.data() + (static_cast<size_t>(position.y) * m_size + position.x) * 4, m_size);
+			m_regions[entries[i].Handle] = MakeRegion(position, padding, image, page_index, m_size);
+		}
+
+		// Rects submitted this frame keep the old texture along with the old UVs
+		page.Texture = Texture2D::Create(page.Specs, ImageFormat::RGBA8, pixels);
+		page.Entries = std::move(entries);
+		page.Cursor = cursor;
+		return true;
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Ignis/Asset/Asset.h"
+#include "Ignis/Renderer/TextureTypes.h"
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace ignis
+{
+	class Image;
+	class Texture2D;
+
+	// Image textures cooked into shared atlas pages, so UI rects using different
+	// images still share a texture slot in the sprite batch. A page only holds images
+	// imported with the same format, filters and mip setting, so sRGB and mipmapped
+	// images sample as they would from their own texture. Sources are read back from
+	// their files once and kept, since textures keep no CPU copy. Everything is dropped
+	// when AssetManager's generation moves, as a reimport, changed import options or a
+	// removal may have changed what a handle resolves to.
+	class UIAtlas
+	{
+	public:
+		struct Region
+		{
+			glm::vec2 UVMin;
+			glm::vec2 UVMax;
+			uint32_t Page = 0;
+		};
+
+		explicit UIAtlas(uint32_t size = 2048);
+
+		// Records a texture seen this frame, Cook packs the ones not in the atlas yet
+		void Request(AssetHandle texture);
+		bool HasPendingRequests() const { return !m_pending.empty(); }
+
+		// Packs the pending textures behind the ones already placed and uploads only their
+		// rects. A full page is repacked once from the kept pixels before a new page is opened.
+		// Large, non 8-bit, non RGBA8/sRGB or memory-only textures are rejected and keep
+		// drawing with their own texture.
+		void Cook();
+
+		const Region* Find(AssetHandle texture);
+		const std::shared_ptr<Texture2D>& GetTexture(const Region& region) const { return m_pages[region.Page].Texture; }
+
+	private:
+		struct Entry
+		{
+			AssetHandle Handle;
+			std::shared_ptr<Image> Pixels;
+		};
+
+		struct Page
+		{
+			TextureSpecs Specs;
+			std::shared_ptr<Texture2D> Texture;
+			std::vector<Entry> Entries;
+
+			// Shelf cursor: x, y and the height of the current shelf
+			glm::uvec3 Cursor = glm::uvec3(0);
+			// Set once a repack could not make room, later images go straight to another page
+			bool Full = false;
+		};
+
+		// Clears every page, region and rejection when handles may resolve differently
+		void ValidateGeneration();
+
+		bool Insert(AssetHandle handle, const TextureSpecs& specs, const std::shared_ptr<Image>& image);
+		bool Append(uint32_t page_index, const Entry& entry);
+		bool Repack(uint32_t page_index, const Entry& entry);
+
+		uint32_t m_size;
+		std::vector<Page> m_pages;
+		std::unordered_map<AssetHandle, Region> m_regions;
+		std::unordered_set<AssetHandle> m_rejected;
+		std::unordered_set<AssetHandle> m_pending;
+		uint64_t m_asset_generation = 0;
+	};
+}
@@ -10,6 +10,18 @@
 
 namespace ignis
 {
+	namespace
+	{
+		namespace ui_uniforms
+		{
+			UniformHandle Projection("u_Projection");
+			SamplerHandle Textures[Renderer::MaxSpriteTextures] = {
+				SamplerHandle("u_Texture0"), SamplerHandle("u_Texture1"), SamplerHandle("u_Texture2"), SamplerHandle("u_Texture3"),
+				SamplerHandle("u_Texture4"), SamplerHandle("u_Texture5"), SamplerHandle("u_Texture6"), SamplerHandle("u_Texture7")
+			};
+		}
+	}
+
 	UIRenderer::UIRenderer(Renderer& renderer)
 		: m_renderer(renderer)
 	{
@@ -47,6 +59,10 @@ namespace ignis
 		std::sort(m_rect_items.begin(), m_rect_items.end(), sort_fn);
 		std::sort(m_text_items.begin(), m_text_items.end(), sort_fn);
 
+		// New images show up with their own texture this frame and from the atlas on the next
+		if (m_atlas.HasPendingRequests())
+			m_atlas.Cook();
+
 		FlushRects();
 		FlushTexts();
 	}
@@ -56,7 +72,21 @@ namespace ignis
 		std::shared_ptr<Texture2D> texture,
 		int sort_order, float depth)
 	{
-		m_rect_items.push_back({ min, max, color, std::move(texture), sort_order, depth });
+		m_rect_items.push_back({ min, max, color, std::move(texture), { 0.0f, 0.0f }, { 1.0f, 1.0f }, sort_order, depth });
+	}
+
+	void UIRenderer::SubmitImage(const glm::vec2& min, const glm::vec2& max,
+		const glm::vec4& color, AssetHandle texture,
+		int sort_order, float depth)
+	{
+		if (const UIAtlas::Region* region = m_atlas.Find(texture))
+		{
+			m_rect_items.push_back({ min, max, color, m_atlas.GetTexture(*region), region->UVMin, region->UVMax, sort_order, depth });
+			return;
+		}
+
+		m_atlas.Request(texture);
+		SubmitRect(min, max, color, AssetManager::GetAsset<Texture2D>(texture), sort_order, depth);
 	}
 
 	void UIRenderer::SubmitText(const glm::vec2& rect_min, const glm::vec2& rect_size,
@@ -75,35 +105,64 @@ namespace ignis
 
 	void UIRenderer::FlushRects()
 	{
-		auto ui_shader = m_renderer.GetShaderLibrary().Get("UI");
-		if (!ui_shader) return;
+		if (m_rect_items.empty()) return;
 
-		for (const auto& item : m_rect_items)
+		if (!m_batch_material)
 		{
-			auto mat = Material::Create(ui_shader);
-			mat->Set("u_Projection", m_projection);
-			mat->Set("u_Color", item.Color);
+			auto ui_shader = m_renderer.GetShaderLibrary().Get("UI_Batched");
+			if (!ui_shader) return;
+			m_batch_material = Material::Create(ui_shader);
+		}
 
-			if (item.Texture)
+		auto flush = [&]()
 			{
-				mat->Set("u_UseTexture", 1);
-				mat->Set("u_Texture", item.Texture);
-			}
-			else
+				if (m_batch_vertices.empty()) return;
+
+				// Unused slots still need a valid texture bound
+				for (uint32_t slot = 0; slot < Renderer::MaxSpriteTextures; slot++)
+					m_batch_material->Set(ui_uniforms::Textures[slot],
+						slot < m_batch_textures.size() ? m_batch_textures[slot] : Renderer::GetWhiteTexture());
+				m_batch_material->Set(ui_uniforms::Projection, m_projection);
+				m_batch_material->Bind();
+
+				m_renderer.RenderSpriteBatch(m_batch_vertices.data(), static_cast<uint32_t>(m_batch_vertices.size() / 4));
+				m_batch_vertices.clear();
+				m_batch_textures.clear();
+			};
+
+		for (const auto& item : m_rect_items)
+		{
+			// Solid rects sample the white texture, so they batch with textured ones
+			const std::shared_ptr<Texture2D>& texture = item.Texture ? item.Texture : Renderer::GetWhiteTexture();
+
+			auto it = std::find(m_batch_textures.begin(), m_batch_textures.end(), texture);
+			if (it == m_batch_textures.end())
 			{
-				mat->Set("u_UseTexture", 0);
-				mat->Set("u_Texture", Renderer::GetWhiteTexture());
+				if (m_batch_textures.size() == Renderer::MaxSpriteTextures)
+					flush();
+				m_batch_textures.push_back(texture);
+				it = m_batch_textures.end() - 1;
 			}
+			const float slot = static_cast<float>(it - m_batch_textures.begin());
 
-			mat->Bind();
-			m_renderer.RenderSprite(item.Min, item.Max);
+			// (0,0) top-left, same corner order as Renderer::RenderSprite
+			m_batch_vertices.push_back({ { item.Min.x, item.Min.y }, { item.UVMin.x, item.UVMin.y }, item.Color, slot });
+			m_batch_vertices.push_back({ { item.Max.x, item.Min.y }, { item.UVMax.x, item.UVMin.y }, item.Color, slot });
+			m_batch_vertices.push_back({ { item.Max.x, item.Max.y }, { item.UVMax.x, item.UVMax.y }, item.Color, slot });
+			m_batch_vertices.push_back({ { item.Min.x, item.Max.y }, { item.UVMin.x, item.UVMax.y }, item.Color, slot });
 		}
+
+		flush();
 	}
 
 	void UIRenderer::FlushTexts()
 	{
-		for (const auto& item : m_text_items)
+		if (m_text_layouts.size() < m_text_items.size())
+			m_text_layouts.resize(m_text_items.size());
+
+		for (size_t i = 0; i < m_text_items.size(); i++)
 		{
+			const auto& item = m_text_items[i];
 			if (!item.FontPtr || item.Text.empty()) continue;
 
 			float scale = item.FontPtr->GetLineHeight() > 0.0f
@@ -112,10 +171,11 @@ namespace ignis
 
 			// Compute text width for alignment (single-line)
 			float text_w = 0.0f;
-			for (char c : item.Text)
+			for (size_t offset = 0; offset < item.Text.size();)
 			{
-				if (c == '\n') break;
-				if (const GlyphMetrics* g = item.FontPtr->GetGlyph(c))
+				const uint32_t codepoint = Font::NextCodepoint(item.Text, offset);
+				if (codepoint == '\n') break;
+				if (const GlyphMetrics* g = item.FontPtr->GetGlyph(codepoint))
 					text_w += g->Advance * scale;
 			}
 			float text_h = item.FontPtr->GetLineHeight() * scale;
@@ -149,10 +209,13 @@ namespace ignis
 			glm::mat4 model = glm::translate(glm::mat4(1.0f),
 				{ screen_x, screen_y, 0.0f });
 
+			TextLayout& layout = m_text_layouts[i];
+			layout.Update(*item.FontPtr, item.Text, scale, TextLayout::LineDirection::Down);
+
 			m_renderer.RenderUIText(
-				*item.FontPtr, item.Text,
+				*item.FontPtr, layout,
 				m_text_projection, model,
-				item.Color, scale);
+				item.Color);
 		}
 	}
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "Ignis/Core/API.h"
 #include "UIComponents.h"
+#include "UIAtlas.h"
+#include "Ignis/Renderer/Renderer.h"
 
 #include <glm/glm.hpp>
 #include <memory>
@@ -10,9 +12,9 @@
 
 namespace ignis
 {
-	class Renderer;
 	class Texture2D;
 	class Font;
+	class Material;
 
 	struct UIRectItem
 	{
@@ -20,6 +22,8 @@ namespace ignis
 		glm::vec2                    Max;
 		glm::vec4                    Color;
 		std::shared_ptr<Texture2D>   Texture;  // null = solid color
+		glm::vec2                    UVMin = { 0.0f, 0.0f };
+		glm::vec2                    UVMax = { 1.0f, 1.0f };
 		int                          SortOrder = 0;
 		float                        Depth = 0.0f;
 	};
@@ -55,6 +59,11 @@ namespace ignis
 			std::shared_ptr<Texture2D> texture = nullptr,
 			int sort_order = 0, float depth = 0.0f);
 
+		// Rect showing a texture asset, drawn from the UI atlas once the image has been cooked into it
+		void SubmitImage(const glm::vec2& min, const glm::vec2& max,
+			const glm::vec4& color, AssetHandle texture,
+			int sort_order = 0, float depth = 0.0f);
+
 		void SubmitText(const glm::vec2& rect_min, const glm::vec2& rect_size,
 			const std::string& text, std::shared_ptr<Font> font,
 			const glm::vec4& color, float font_size,
@@ -74,5 +83,13 @@ namespace ignis
 
 		std::vector<UIRectItem> m_rect_items;
 		std::vector<UITextItem> m_text_items;
+		// One per text item in draw order, a UI that did not change hits the same layout every frame
+		std::vector<TextLayout> m_text_layouts;
+
+		// Rects are flushed as quads sharing one material, up to Renderer::MaxSpriteTextures textures per draw
+		UIAtlas m_atlas;
+		std::shared_ptr<Material> m_batch_material;
+		std::vector<SpriteVertex> m_batch_vertices;
+		std::vector<std::shared_ptr<Texture2D>> m_batch_textures;
 	};
 }
\ No newline at end of file
@@ -5,19 +5,35 @@
 #include "Ignis/Script/ScriptBehaviour.h"
 #include "Ignis/Renderer/Font.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace ignis
 {
+	namespace
+	{
+		// Screen pixels per hit grid cell, small enough that a cell holds a handful of list items
+		constexpr float k_hit_grid_cell_size = 64.0f;
+		constexpr uint32_t k_hit_grid_max_cells = 1u << 16;
+	}
+
 	void UISystem::OnUpdate(Scene& scene, uint32_t screen_w, uint32_t screen_h)
 	{
 		const glm::vec2 screen_min = { 0.0f, 0.0f };
 		const glm::vec2 screen_max = { static_cast<float>(screen_w),
 									   static_cast<float>(screen_h) };
 
-		// Find all Canvas roots and resolve their subtrees
-		auto canvas_view = scene.GetAllEntitiesWith<CanvasComponent, RectTransformComponent>();
-		for (auto e_handle : canvas_view)
+		UpdateLayoutCache(scene);
+		const bool full = m_layout_rebuilt;
+		m_layout_rebuilt = false;
+
+		if (full || screen_max != m_screen_size)
+			m_hit_grid_dirty = true;
+		m_screen_size = screen_max;
+
+		for (auto& layout : m_canvas_layouts)
 		{
-			Entity canvas_entity = scene.GetEntityByHandle(e_handle);
+			Entity canvas_entity = scene.GetEntityByHandle(layout.Canvas);
 
 			// Canvas root always fills the screen in ScreenSpace mode
 			auto& canvas_comp = canvas_entity.GetComponent<CanvasComponent>();
@@ -25,69 +41,263 @@ namespace ignis
 
 			auto& canvas_rect = canvas_entity.GetComponent<RectTransformComponent>();
 
+			glm::vec2 canvas_min, canvas_max;
 			if (canvas_comp.Mode == CanvasComponent::RenderMode::ScreenSpace)
 			{
-				canvas_rect.ResolvedMin = screen_min;
-				canvas_rect.ResolvedMax = screen_max;
+				canvas_min = screen_min;
+				canvas_max = screen_max;
 			}
 			else
 			{
 				// WorldSpace canvas: layout relative to its own OffsetMin/Max
-				canvas_rect.ResolvedMin = canvas_rect.OffsetMin;
-				canvas_rect.ResolvedMax = canvas_rect.OffsetMax;
+				canvas_min = canvas_rect.OffsetMin;
+				canvas_max = canvas_rect.OffsetMax;
 			}
 
-			// Recursively resolve children
-			for (Entity child : canvas_entity.GetChildren())
-				ResolveLayout(scene, child, canvas_rect.ResolvedMin, canvas_rect.ResolvedMax);
+			// A resized screen, switched mode or moved canvas invalidates everything below it
+			const bool canvas_changed = full
+				|| canvas_rect.ResolvedMin != canvas_min || canvas_rect.ResolvedMax != canvas_max;
+
+			canvas_rect.ResolvedMin = canvas_min;
+			canvas_rect.ResolvedMax = canvas_max;
+
+			if (ResolveLayout(scene, layout, canvas_rect, canvas_changed))
+				m_hit_grid_dirty = true;
 		}
 	}
 
-	void UISystem::ResolveLayout(Scene& scene, Entity node,
-		const glm::vec2& parent_min,
-		const glm::vec2& parent_max)
+	void UISystem::UpdateLayoutCache(Scene& scene)
+	{
+		const size_t rect_count = scene.GetAllEntitiesWith<RectTransformComponent>().size();
+		const size_t canvas_count = scene.GetAllEntitiesWith<CanvasComponent>().size();
+
+		// Adding or removing a rect changes the storage size, reparenting bumps the hierarchy version
+		if (m_layout_scene == &scene
+			&& m_layout_hierarchy_version == scene.GetHierarchyVersion()
+			&& m_layout_rect_count == rect_count
+			&& m_layout_canvas_count == canvas_count)
+			return;
+
+		m_layout_scene = &scene;
+		m_layout_hierarchy_version = scene.GetHierarchyVersion();
+		m_layout_rect_count = rect_count;
+		m_layout_canvas_count = canvas_count;
+		m_layout_rebuilt = true;
+
+		m_canvas_layouts.clear();
+		auto canvas_view = scene.GetAllEntitiesWith<CanvasComponent, RectTransformComponent>();
+		for (auto e_handle : canvas_view)
+		{
+			auto& layout = m_canvas_layouts.emplace_back();
+			layout.Canvas = e_handle;
+			for (Entity child : scene.GetEntityByHandle(e_handle).Children())
+				FlattenNode(child, CanvasParent, layout.Nodes);
+		}
+	}
+
+	void UISystem::FlattenNode(Entity node, uint32_t parent, std::vector<LayoutNode>& nodes)
 	{
 		if (!node.IsValid()) return;
 		if (!node.HasComponent<RectTransformComponent>()) return;
 
-		auto& rect = node.GetComponent<RectTransformComponent>();
-		glm::vec2 psize = parent_max - parent_min;
+		const uint32_t index = static_cast<uint32_t>(nodes.size());
+		nodes.push_back({ node.GetHandle(), parent, 0, {} });
+
+		for (Entity child : node.Children())
+			FlattenNode(child, index, nodes);
+
+		nodes[index].SubtreeEnd = static_cast<uint32_t>(nodes.size());
+	}
+
+	bool UISystem::ResolveLayout(Scene& scene, CanvasLayout& layout,
+		const RectTransformComponent& canvas_rect, bool full)
+	{
+		auto& nodes = layout.Nodes;
+		auto get_inputs = [](const RectTransformComponent& rect) -> LayoutInputs
+			{
+				return { rect.AnchorMin, rect.AnchorMax, rect.OffsetMin, rect.OffsetMax };
+			};
+
+		const uint32_t count = static_cast<uint32_t>(nodes.size());
+		bool resolved = false;
+
+		uint32_t i = 0;
+		while (i < count)
+		{
+			auto& rect = scene.GetEntityByHandle(nodes[i].Handle).GetComponent<RectTransformComponent>();
+			if (!full && get_inputs(rect) == nodes[i].Inputs)
+			{
+				i++;
+				continue;
+			}
+
+			// Parents come before children, so each node sees its parent already resolved
+			const uint32_t end = full ? count : nodes[i].SubtreeEnd;
+			resolved |= i < end;
+			for (; i < end; i++)
+			{
+				auto& node_rect = scene.GetEntityByHandle(nodes[i].Handle).GetComponent<RectTransformComponent>();
+				const auto& parent_rect = nodes[i].Parent == CanvasParent
+					? canvas_rect
+					: scene.GetEntityByHandle(nodes[nodes[i].Parent].Handle).GetComponent<RectTransformComponent>();
+
+				glm::vec2 psize = parent_rect.ResolvedMax - parent_rect.ResolvedMin;
+
+				glm::vec2 anchor_min_px = parent_rect.ResolvedMin + node_rect.AnchorMin * psize;
+				glm::vec2 anchor_max_px = parent_rect.ResolvedMin + node_rect.AnchorMax * psize;
+
+				node_rect.ResolvedMin = anchor_min_px + node_rect.OffsetMin;
+				node_rect.ResolvedMax = anchor_max_px + node_rect.OffsetMax;
+				nodes[i].Inputs = get_inputs(node_rect);
+			}
+		}
+		return resolved;
+	}
+
+	void UISystem::BuildHitGrid(Scene& scene)
+	{
+		m_hit_grid_dirty = false;
+		m_hit_image_count = scene.GetAllEntitiesWith<ImageComponent>().size();
+		m_hit_button_count = scene.GetAllEntitiesWith<ButtonComponent>().size();
+
+		// Images are targets unless RaycastTarget is off, that flag is checked per query so toggling it needs no rebuild
+		m_hit_targets.clear();
+		for (auto& layout : m_canvas_layouts)
+		{
+			layout.HitGridSortOrder = scene.GetEntityByHandle(layout.Canvas).GetComponent<CanvasComponent>().SortOrder;
+			const uint64_t canvas_order = static_cast<uint64_t>(static_cast<uint32_t>(layout.HitGridSortOrder) ^ 0x80000000u) << 32;
+
+			for (uint32_t depth = 0; depth < layout.Nodes.size(); depth++)
+			{
+				Entity node = scene.GetEntityByHandle(layout.Nodes[depth].Handle);
+				if (!node.HasComponent<ImageComponent>() && !node.HasComponent<ButtonComponent>())
+					continue;
+
+				const auto& rect = node.GetComponent<RectTransformComponent>();
+				m_hit_targets.push_back({ layout.Nodes[depth].Handle, layout.Canvas, rect.ResolvedMin, rect.ResolvedMax, canvas_order | depth });
+			}
+		}
+
+		std::sort(m_hit_targets.begin(), m_hit_targets.end(),
+			[](const HitTarget& a, const HitTarget& b) { return a.Order > b.Order; });
+
+		// Coarser cells on huge screens keep the grid bounded
+		float cell_size = k_hit_grid_cell_size;
+		while (std::ceil(m_screen_size.x / cell_size) * std::ceil(m_screen_size.y / cell_size) > k_hit_grid_max_cells)
+			cell_size *= 2.0f;
+		m_hit_grid_columns = std::max(1u, static_cast<uint32_t>(std::ceil(m_screen_size.x / cell_size)));
+		m_hit_grid_rows = std::max(1u, static_cast<uint32_t>(std::ceil(m_screen_size.y / cell_size)));
+
+		// Widgets partly off screen go into the border cells, queries clamp the same way
+		auto cell_range = [&](const HitTarget& target, glm::uvec2& first, glm::uvec2& last)
+			{
+				const glm::vec2 grid_max = glm::vec2(m_hit_grid_columns - 1, m_hit_grid_rows - 1);
+				first = glm::uvec2(glm::clamp(glm::floor(target.Min / cell_size), glm::vec2(0.0f), grid_max));
+				last = glm::uvec2(glm::clamp(glm::floor(target.Max / cell_size), glm::vec2(0.0f), grid_max));
+			};
+
+		const uint32_t cell_count = m_hit_grid_columns * m_hit_grid_rows;
+		m_hit_cell_offsets.assign(cell_count + 1, 0);
+		for (const auto& target : m_hit_targets)
+		{
+			glm::uvec2 first, last;
+			cell_range(target, first, last);
+			for (uint32_t y = first.y; y <= last.y; y++)
+				for (uint32_t x = first.x; x <= last.x; x++)
+					m_hit_cell_offsets[y * m_hit_grid_columns + x + 1]++;
+		}
+		for (uint32_t cell = 0; cell < cell_count; cell++)
+			m_hit_cell_offsets[cell + 1] += m_hit_cell_offsets[cell];
+
+		// Targets are already topmost first, filling in that order keeps every cell sorted
+		m_hit_cell_entries.resize(m_hit_cell_offsets.back());
+		std::vector<uint32_t> cursor(m_hit_cell_offsets.begin(), m_hit_cell_offsets.end() - 1);
+		for (uint32_t t = 0; t < m_hit_targets.size(); t++)
+		{
+			glm::uvec2 first, last;
+			cell_range(m_hit_targets[t], first, last);
+			for (uint32_t y = first.y; y <= last.y; y++)
+				for (uint32_t x = first.x; x <= last.x; x++)
+					m_hit_cell_entries[cursor[y * m_hit_grid_columns + x]++] = t;
+		}
 
-		glm::vec2 anchor_min_px = parent_min + rect.AnchorMin * psize;
-		glm::vec2 anchor_max_px = parent_min + rect.AnchorMax * psize;
+		m_hit_grid_cell_size = cell_size;
+	}
 
-		rect.ResolvedMin = anchor_min_px + rect.OffsetMin;
-		rect.ResolvedMax = anchor_max_px + rect.OffsetMax;
+	Entity UISystem::HitTest(Scene& scene, const glm::vec2& pos)
+	{
+		UpdateLayoutCache(scene);
+		if (m_layout_rebuilt)
+			m_hit_grid_dirty = true;
+
+		if (!m_hit_grid_dirty)
+		{
+			if (m_hit_image_count != scene.GetAllEntitiesWith<ImageComponent>().size()
+				|| m_hit_button_count != scene.GetAllEntitiesWith<ButtonComponent>().size())
+				m_hit_grid_dirty = true;
+
+			for (const auto& layout : m_canvas_layouts)
+			{
+				if (scene.GetEntityByHandle(layout.Canvas).GetComponent<CanvasComponent>().SortOrder != layout.HitGridSortOrder)
+					m_hit_grid_dirty = true;
+			}
+		}
 
-		for (Entity child : node.GetChildren())
-			ResolveLayout(scene, child, rect.ResolvedMin, rect.ResolvedMax);
+		if (m_hit_grid_dirty)
+			BuildHitGrid(scene);
+
+		const glm::uvec2 cell = glm::uvec2(glm::clamp(glm::floor(pos / m_hit_grid_cell_size),
+			glm::vec2(0.0f), glm::vec2(m_hit_grid_columns - 1, m_hit_grid_rows - 1)));
+		const uint32_t cell_index = cell.y * m_hit_grid_columns + cell.x;
+
+		for (uint32_t i = m_hit_cell_offsets[cell_index]; i < m_hit_cell_offsets[cell_index + 1]; i++)
+		{
+			const HitTarget& target = m_hit_targets[m_hit_cell_entries[i]];
+			if (pos.x < target.Min.x || pos.x > target.Max.x ||
+				pos.y < target.Min.y || pos.y > target.Max.y)
+				continue;
+
+			if (!scene.GetEntityByHandle(target.Canvas).GetComponent<CanvasComponent>().Visible)
+				continue;
+
+			Entity node = scene.GetEntityByHandle(target.Handle);
+			bool is_raycast_target =
+				(node.HasComponent<ImageComponent>() && node.GetComponent<ImageComponent>().RaycastTarget)
+				|| node.HasComponent<ButtonComponent>();
+
+			if (is_raycast_target)
+				return node;
+		}
+
+		return {};
 	}
 
 	void UISystem::OnRender(Scene& scene, UIRenderer& ui_renderer,
 		uint32_t screen_w, uint32_t screen_h)
 	{
+		UpdateLayoutCache(scene);
+
 		// Collect canvases and sort by SortOrder
-		std::vector<std::pair<int, Entity>> canvases;
-		auto canvas_view = scene.GetAllEntitiesWith<CanvasComponent>();
-		for (auto e_handle : canvas_view)
+		m_sorted_canvases.clear();
+		for (const auto& layout : m_canvas_layouts)
 		{
-			Entity e = scene.GetEntityByHandle(e_handle);
-			auto& c = e.GetComponent<CanvasComponent>();
+			auto& c = scene.GetEntityByHandle(layout.Canvas).GetComponent<CanvasComponent>();
 			if (c.Visible)
-				canvases.emplace_back(c.SortOrder, e);
+				m_sorted_canvases.emplace_back(c.SortOrder, &layout);
 		}
-		std::sort(canvases.begin(), canvases.end(),
+		std::stable_sort(m_sorted_canvases.begin(), m_sorted_canvases.end(),
 			[](const auto& a, const auto& b) { return a.first < b.first; });
 
-		for (auto& [sort_order, canvas_entity] : canvases)
+		for (auto& [sort_order, layout] : m_sorted_canvases)
 		{
+			// Pre-order matches the old recursive walk, so depth still increases parent to child
 			float depth = 0.0f;
-			for (Entity child : canvas_entity.GetChildren())
-				RenderNode(scene, child, ui_renderer, sort_order, depth);
+			for (const auto& node : layout->Nodes)
+				RenderNode(scene.GetEntityByHandle(node.Handle), ui_renderer, sort_order, depth);
 		}
 	}
 
-	void UISystem::RenderNode(Scene& scene, Entity node,
+	void UISystem::RenderNode(Entity node,
 		UIRenderer& ui_renderer,
 		int canvas_sort_order,
 		float& depth_counter)
@@ -146,9 +356,14 @@ namespace ignis
 					}
 				}
 
-				ui_renderer.SubmitRect(draw_min, draw_max,
-					color, tex,
-					canvas_sort_order, my_depth);
+				if (tex)
+					ui_renderer.SubmitImage(draw_min, draw_max,
+						color, img.Texture,
+						canvas_sort_order, my_depth);
+				else
+					ui_renderer.SubmitRect(draw_min, draw_max,
+						color, nullptr,
+						canvas_sort_order, my_depth);
 			}
 		}
 
@@ -204,30 +419,16 @@ namespace ignis
 			}
 		}
 
-		for (Entity child : node.GetChildren())
-			RenderNode(scene, child, ui_renderer, canvas_sort_order, depth_counter);
 	}
 
 	void UISystem::OnMouseMoved(Scene& scene, double x, double y)
 	{
 		m_mouse_pos = { static_cast<float>(x), static_cast<float>(y) };
+		UpdateHovered(scene, HitTest(scene, m_mouse_pos));
+	}
 
-		Entity hit;
-		auto canvas_view = scene.GetAllEntitiesWith<CanvasComponent>();
-		for (auto e_handle : canvas_view)
-		{
-			Entity canvas = scene.GetEntityByHandle(e_handle);
-			if (!canvas.GetComponent<CanvasComponent>().Visible)
-				continue;
-
-			for (Entity child : canvas.GetChildren())
-			{
-				if (HitTestNode(scene, child, m_mouse_pos, hit))
-					break;
-			}
-		}
-
-		// Update hover state
+	void UISystem::UpdateHovered(Scene& scene, Entity hit)
+	{
 		if (hit != m_hovered_entity)
 		{
 			if (m_hovered_entity.IsValid())
@@ -258,6 +459,8 @@ namespace ignis
 
 	void UISystem::OnMouseButtonPressed(Scene& scene, int button)
 	{
+		// Layout may have moved under a still cursor since the last mouse move
+		UpdateHovered(scene, HitTest(scene, m_mouse_pos));
 		if (!m_hovered_entity.IsValid()) return;
 
 		m_pressed_entity = m_hovered_entity;
@@ -305,39 +508,6 @@ namespace ignis
 		(void)scene; (void)keycode;
 	}
 
-	bool UISystem::HitTestNode(Scene& scene, Entity node,
-		const glm::vec2& pos, Entity& out_hit)
-	{
-		if (!node.IsValid()) return false;
-		if (!node.HasComponent<RectTransformComponent>()) return false;
-
-		const auto& rect = node.GetComponent<RectTransformComponent>();
-
-		// Test children first (they're rendered on top)
-		std::vector<Entity> children = node.GetChildren();
-		for (auto it = children.rbegin(); it != children.rend(); ++it)
-		{
-			if (HitTestNode(scene, *it, pos, out_hit))
-				return true;
-		}
-
-		// Check this node
-		bool is_raycast_target =
-			(node.HasComponent<ImageComponent>() && node.GetComponent<ImageComponent>().RaycastTarget)
-			|| node.HasComponent<ButtonComponent>();
-
-		if (!is_raycast_target) return false;
-
-		if (pos.x >= rect.ResolvedMin.x && pos.x <= rect.ResolvedMax.x &&
-			pos.y >= rect.ResolvedMin.y && pos.y <= rect.ResolvedMax.y)
-		{
-			out_hit = node;
-			return true;
-		}
-
-		return false;
-	}
-
 	void UISystem::DispatchPointerEnter(Scene& scene, Entity entity)
 	{
 		if (auto* sb = scene.GetRuntimeScript(entity.GetID()))
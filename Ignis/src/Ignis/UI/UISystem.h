@@ -6,6 +6,7 @@
 #include "Ignis/Scene/Entity.h"
 
 #include <glm/glm.hpp>
+#include <vector>
 
 namespace ignis
 {
@@ -17,7 +18,7 @@ namespace ignis
 		UISystem() = default;
 		~UISystem() = default;
 
-		// Resolves all RectTransform layouts. Call before OnRender.
+		// Resolves RectTransform layouts whose anchors or offsets changed, or that sit under a changed canvas or screen size. Call before OnRender.
 		void OnUpdate(Scene& scene, uint32_t screen_width, uint32_t screen_height);
 
 		// Submits UI geometry to UIRenderer. Call after Scene::OnRender.
@@ -31,24 +32,90 @@ namespace ignis
 		void OnKeyTyped(Scene& scene, int keycode);
 
 	private:
-		void ResolveLayout(Scene& scene, Entity node,
-			const glm::vec2& parent_min,
-			const glm::vec2& parent_max);
+		// Rect fields a layout depends on. Scripts, the inspector and serialization all write
+		// them directly, so changes are found by comparing against the last resolved values.
+		struct LayoutInputs
+		{
+			glm::vec2 AnchorMin = { 0.0f, 0.0f };
+			glm::vec2 AnchorMax = { 0.0f, 0.0f };
+			glm::vec2 OffsetMin = { 0.0f, 0.0f };
+			glm::vec2 OffsetMax = { 0.0f, 0.0f };
 
-		void RenderNode(Scene& scene, Entity node,
+			bool operator==(const LayoutInputs&) const = default;
+		};
+
+		// A canvas subtree in pre-order, so a node's descendants are the range after it
+		struct LayoutNode
+		{
+			entt::entity Handle;
+			uint32_t     Parent;      // index into Nodes, CanvasParent for the canvas's own children
+			uint32_t     SubtreeEnd;  // one past the node's last descendant
+			LayoutInputs Inputs;      // as of the last resolve
+		};
+
+		struct CanvasLayout
+		{
+			entt::entity            Canvas;
+			std::vector<LayoutNode> Nodes;
+			int                     HitGridSortOrder = 0;  // SortOrder the hit grid was built with
+		};
+
+		// A widget that can receive pointer events, Order is (canvas SortOrder, depth) packed for sorting
+		struct HitTarget
+		{
+			entt::entity Handle;
+			entt::entity Canvas;
+			glm::vec2    Min;
+			glm::vec2    Max;
+			uint64_t     Order;
+		};
+
+		static constexpr uint32_t CanvasParent = 0xffffffffu;
+
+		// Reflattens the canvases when the hierarchy or the set of rects changed since the last call
+		void UpdateLayoutCache(Scene& scene);
+		void FlattenNode(Entity node, uint32_t parent, std::vector<LayoutNode>& nodes);
+
+		// Resolves subtrees whose inputs changed, or every node when full is set. Returns whether any rect moved.
+		bool ResolveLayout(Scene& scene, CanvasLayout& layout,
+			const RectTransformComponent& canvas_rect, bool full);
+
+		// Buckets the raycast targets into screen cells, each cell listed topmost first
+		void BuildHitGrid(Scene& scene);
+		// Topmost visible raycast target under pos, invalid if none
+		Entity HitTest(Scene& scene, const glm::vec2& pos);
+		void UpdateHovered(Scene& scene, Entity hit);
+
+		void RenderNode(Entity node,
 			UIRenderer& ui_renderer,
 			int canvas_sort_order,
 			float& depth_counter);
 
-		bool HitTestNode(Scene& scene, Entity node,
-			const glm::vec2& pos, Entity& out_hit);
-
 		void DispatchPointerEnter(Scene& scene, Entity entity);
 		void DispatchPointerExit(Scene& scene, Entity entity);
 		void DispatchPointerDown(Scene& scene, Entity entity, int btn);
 		void DispatchPointerUp(Scene& scene, Entity entity, int btn);
 		void DispatchPointerClick(Scene& scene, Entity entity, int btn);
 
+		std::vector<CanvasLayout> m_canvas_layouts;
+		std::vector<std::pair<int, const CanvasLayout*>> m_sorted_canvases;
+		const Scene* m_layout_scene = nullptr;
+		uint64_t     m_layout_hierarchy_version = 0;
+		size_t       m_layout_rect_count = 0;
+		size_t       m_layout_canvas_count = 0;
+		bool         m_layout_rebuilt = false;
+
+		glm::vec2              m_screen_size = { 0.0f, 0.0f };
+		std::vector<HitTarget> m_hit_targets;
+		std::vector<uint32_t>  m_hit_cell_offsets;   // cell -> range in m_hit_cell_entries
+		std::vector<uint32_t>  m_hit_cell_entries;   // indices into m_hit_targets
+		uint32_t               m_hit_grid_columns = 0;
+		uint32_t               m_hit_grid_rows = 0;
+		float                  m_hit_grid_cell_size = 64.0f;
+		size_t                 m_hit_image_count = 0;
+		size_t                 m_hit_button_count = 0;
+		bool                   m_hit_grid_dirty = true;
+
 		glm::vec2 m_mouse_pos = { 0.0f, 0.0f };
 		Entity    m_hovered_entity;
 		Entity    m_pressed_entity;